@@ -0,0 +1,212 @@
+#include "tool.hpp"
+
+#include <array>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../sources/Deque/ArrayDeque.hpp"
+#include "../sources/Deque/BlockDeque.hpp"
+#include "../sources/Deque/LinkedDeque.hpp"
+#include "../sources/Deque/WorkStealingDeque.hpp"
+
+constexpr int N = 4096;
+
+TEMPLATE_TEST_CASE("Deque benchmark", "[deque]", ArrayDeque<int>, LinkedDeque<int>, BlockDeque<int>)
+{
+    using Deque = TestType;
+
+    // Keep the buffer wrapped around, as a reorder window does.
+    Deque deque;
+    for (int i = 0; i < N; ++i)
+    {
+        deque.push_back(i);
+    }
+    for (int i = 0; i < N / 2; ++i)
+    {
+        deque.push_back(deque.pop_front());
+    }
+
+    BENCHMARK("push back + pop front")
+    {
+        for (int i = 0; i < N; ++i)
+        {
+            deque.push_back(deque.pop_front());
+        }
+        return deque.size();
+    };
+
+    BENCHMARK("random access")
+    {
+        long long sum = 0;
+        auto first = deque.begin();
+        for (int i = 0; i < N; ++i)
+        {
+            sum += *std::next(first, int(rng()() % N));
+        }
+        return sum;
+    };
+
+    BENCHMARK("iterate")
+    {
+        return std::accumulate(deque.begin(), deque.end(), 0LL);
+    };
+}
+
+TEST_CASE("ArrayDeque segments benchmark", "[deque]")
+{
+    ArrayDeque<int> deque;
+    for (int i = 0; i < N; ++i)
+    {
+        deque.push_back(i);
+    }
+    for (int i = 0; i < N / 2; ++i)
+    {
+        deque.push_back(deque.pop_front());
+    }
+
+    // The two segments are plain arrays.
+    BENCHMARK("iterate segments")
+    {
+        auto [head, tail] = deque.segments();
+        return std::accumulate(head.begin(), head.end(), 0LL) + std::accumulate(tail.begin(), tail.end(), 0LL);
+    };
+}
+
+// A large element, copied on every growth of a ring buffer.
+struct Payload
+{
+    std::array<char, 256> bytes;
+};
+
+TEMPLATE_TEST_CASE("Deque growth benchmark", "[deque]", ArrayDeque<Payload>, BlockDeque<Payload>)
+{
+    using Deque = TestType;
+
+    // Total time of growing to 64 * N large elements from both ends.
+    BENCHMARK("push both ends")
+    {
+        Deque deque;
+        for (int i = 0; i < 32 * N; ++i)
+        {
+            deque.push_back(Payload());
+            deque.push_front(Payload());
+        }
+        return deque.size();
+    };
+
+    // The worst single push, where a ring buffer copies everything.
+    Deque deque;
+    long long worst = 0;
+    for (int i = 0; i < 64 * N; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        deque.push_back(Payload());
+        worst = std::max(worst, (long long)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+    }
+    WARN("worst push: " << worst << " us");
+}
+
+// ArrayDeque guarded by a mutex, the baseline for a shared task pool.
+class LockedDeque
+{
+    ArrayDeque<int> deque_;
+    std::mutex mutex_;
+
+public:
+    void push(int task)
+    {
+        std::lock_guard lock(mutex_);
+        deque_.push_back(task);
+    }
+
+    bool try_pop(int& task)
+    {
+        std::lock_guard lock(mutex_);
+        if (deque_.is_empty())
+        {
+            return false;
+        }
+        task = deque_.pop_back();
+        return true;
+    }
+
+    bool steal(int& task)
+    {
+        std::lock_guard lock(mutex_);
+        if (deque_.is_empty())
+        {
+            return false;
+        }
+        task = deque_.pop_front();
+        return true;
+    }
+};
+
+// The owner spawns N tasks and runs most of them itself, while thieves steal the rest.
+template <typename Deque>
+static long long spawn_and_steal(int thieves)
+{
+    Deque deque;
+    std::atomic<long long> sum = 0;
+    std::atomic<bool> done = false;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < thieves; ++i)
+    {
+        threads.emplace_back([&]
+                             {
+                                 int task;
+                                 long long local = 0;
+                                 while (!done.load(std::memory_order_relaxed))
+                                 {
+                                     if (deque.steal(task))
+                                     {
+                                         local += task;
+                                     }
+                                     else
+                                     {
+                                         std::this_thread::yield();
+                                     }
+                                 }
+                                 sum += local;
+                             });
+    }
+
+    int task;
+    long long local = 0;
+    for (int i = 0; i < N * 16; ++i)
+    {
+        deque.push(i);
+        if (i % 4 == 3)
+        {
+            while (deque.try_pop(task))
+            {
+                local += task;
+            }
+        }
+    }
+    while (deque.try_pop(task))
+    {
+        local += task;
+    }
+    done = true;
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    return sum + local;
+}
+
+TEMPLATE_TEST_CASE("Work stealing benchmark", "[deque]", LockedDeque, WorkStealingDeque<int>)
+{
+    using Deque = TestType;
+
+    for (int thieves : {0, 1, 3, 7})
+    {
+        BENCHMARK(std::to_string(thieves) + " thieves")
+        {
+            return spawn_and_steal<Deque>(thieves);
+        };
+    }
+}
@@ -0,0 +1,172 @@
+#include "tool.hpp"
+
+#include "../sources/List/ArrayList.hpp"
+#include "../sources/List/LinkedList.hpp"
+#include "../sources/List/MappedArrayList.hpp"
+#include "../sources/List/PersistentVector.hpp"
+#include "../sources/List/SinglyLinkedList.hpp"
+#include "../sources/List/TreeList.hpp"
+#include "../sources/List/UnrolledLinkedList.hpp"
+
+constexpr int N = 4096;
+
+// Interleave inserts at random positions with reads at random positions.
+template <typename List>
+static long long mixed_insert_index()
+{
+    List list;
+    long long sum = 0;
+    for (int i = 0; i < N; ++i)
+    {
+        list.insert(int(rng()() % (list.size() + 1)), i);
+        sum += list[int(rng()() % list.size())];
+    }
+    return sum;
+}
+
+// Random reads only.
+template <typename List>
+static long long random_index(const List& list)
+{
+    long long sum = 0;
+    for (int i = 0; i < N; ++i)
+    {
+        sum += list[int(rng()() % list.size())];
+    }
+    return sum;
+}
+
+TEMPLATE_TEST_CASE("List benchmark", "[list]", ArrayList<int>, LinkedList<int>, UnrolledLinkedList<int>, TreeList<int>)
+{
+    using List = TestType;
+
+    List list;
+    for (int i = 0; i < N; ++i)
+    {
+        list.append(i);
+    }
+
+    BENCHMARK("mixed insert/index")
+    {
+        return mixed_insert_index<List>();
+    };
+
+    BENCHMARK("random index")
+    {
+        return random_index(list);
+    };
+
+    BENCHMARK("iterate")
+    {
+        return std::accumulate(list.begin(), list.end(), 0LL);
+    };
+}
+
+TEMPLATE_TEST_CASE("Snapshot benchmark", "[list]", ArrayList<int>, PersistentVector<int>)
+{
+    using List = TestType;
+
+    constexpr int M = 1 << 20;
+
+    List list;
+    for (int i = 0; i < M; ++i)
+    {
+        list.append(i);
+    }
+
+    BENCHMARK("append")
+    {
+        List grow;
+        for (int i = 0; i < N; ++i)
+        {
+            grow.append(i);
+        }
+        return grow.size();
+    };
+
+    // Take a snapshot, then keep appending to the original.
+    BENCHMARK("snapshot + append")
+    {
+        List snapshot = list;
+        list.append(0);
+        return snapshot.size();
+    };
+
+    BENCHMARK("random index")
+    {
+        return random_index(list);
+    };
+}
+
+TEST_CASE("MappedArrayList benchmark", "[list]")
+{
+    constexpr int M = 1 << 22;
+
+    std::string path = (std::filesystem::temp_directory_path() / "hellods_bench_mapped.bin").string();
+
+    BENCHMARK("ArrayList append")
+    {
+        ArrayList<int> list;
+        for (int i = 0; i < M; ++i)
+        {
+            list.append(i);
+        }
+        return list.size();
+    };
+
+    // The file is extended and remapped in large increments.
+    BENCHMARK("MappedArrayList append")
+    {
+        std::filesystem::remove(path);
+        MappedArrayList<int> list(path);
+        for (int i = 0; i < M; ++i)
+        {
+            list.append(i);
+        }
+        return list.size();
+    };
+
+    // Reopening maps the file back instead of reading it.
+    BENCHMARK("MappedArrayList reopen + scan")
+    {
+        MappedArrayList<int> list(path);
+        return std::accumulate(list.begin(), list.end(), 0LL);
+    };
+
+    std::filesystem::remove(path);
+}
+
+TEMPLATE_TEST_CASE("Relink benchmark", "[list]", LinkedList<int>, SinglyLinkedList<int>)
+{
+    using List = TestType;
+
+    List source;
+    List target;
+    for (int i = 0; i < N; ++i)
+    {
+        source.append(i);
+    }
+
+    // Move the back half over and back again, one element at a time.
+    BENCHMARK("move by copy")
+    {
+        for (int i = 0; i < N / 2; ++i)
+        {
+            target.append(source.remove(N / 2));
+        }
+        for (int i = 0; i < N / 2; ++i)
+        {
+            source.append(target.remove(0));
+        }
+        return source.size();
+    };
+
+    // The same moves by relinking nodes.
+    BENCHMARK("move by relink")
+    {
+        List half = source.split_at(N / 2);
+        target.concat(half);
+        source.splice(N / 2, target, 0, N / 2);
+        return source.size();
+    };
+}
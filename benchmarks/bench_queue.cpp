@@ -0,0 +1,431 @@
+#include "tool.hpp"
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../sources/Queue/ArrayQueue.hpp"
+#include "../sources/Queue/BlockingQueue.hpp"
+#include "../sources/Queue/LinkedQueue.hpp"
+#include "../sources/Queue/MpmcQueue.hpp"
+#include "../sources/Queue/SpscQueue.hpp"
+#include "../sources/Queue/UnrolledQueue.hpp"
+
+constexpr int N = 1 << 16;
+
+TEMPLATE_TEST_CASE("Unbounded queue benchmark", "[queue]", LinkedQueue<int>, UnrolledQueue<int>, ArrayQueue<int>)
+{
+    using Queue = TestType;
+
+    // Grow to N elements and drain them, allocating and freeing along the way.
+    BENCHMARK("fill + drain")
+    {
+        Queue queue;
+        for (int i = 0; i < N; ++i)
+        {
+            queue.enqueue(i);
+        }
+        long long sum = 0;
+        while (!queue.is_empty())
+        {
+            sum += queue.dequeue();
+        }
+        return sum;
+    };
+
+    // Keep the size steady, so the rear keeps growing into new chunks while the front releases them.
+    Queue queue;
+    for (int i = 0; i < N; ++i)
+    {
+        queue.enqueue(i);
+    }
+    BENCHMARK("steady enqueue + dequeue")
+    {
+        for (int i = 0; i < N; ++i)
+        {
+            queue.enqueue(queue.dequeue());
+        }
+        return queue.size();
+    };
+
+    BENCHMARK("iterate")
+    {
+        return std::accumulate(queue.begin(), queue.end(), 0LL);
+    };
+}
+
+// ArrayQueue guarded by a mutex, the baseline for handing items between threads.
+class LockedQueue
+{
+    ArrayQueue<int> queue_;
+    std::mutex mutex_;
+
+public:
+    explicit LockedQueue(int)
+    {
+    }
+
+    bool try_enqueue(int element)
+    {
+        std::lock_guard lock(mutex_);
+        queue_.enqueue(element);
+        return true;
+    }
+
+    bool try_dequeue(int& element)
+    {
+        std::lock_guard lock(mutex_);
+        if (queue_.is_empty())
+        {
+            return false;
+        }
+        element = queue_.dequeue();
+        return true;
+    }
+};
+
+// Spin until the element is enqueued, or use the waiting variant if the queue has one.
+template <typename Queue>
+static void put(Queue& queue, int element)
+{
+    if constexpr (requires { queue.enqueue_wait(element); })
+    {
+        queue.enqueue_wait(element);
+    }
+    else
+    {
+        while (!queue.try_enqueue(element))
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+// Spin until an element is dequeued, or use the waiting variant if the queue has one.
+template <typename Queue>
+static int take(Queue& queue)
+{
+    if constexpr (requires { queue.dequeue_wait(); })
+    {
+        return queue.dequeue_wait();
+    }
+    else
+    {
+        int element;
+        while (!queue.try_dequeue(element))
+        {
+            std::this_thread::yield();
+        }
+        return element;
+    }
+}
+
+// Send N elements from this thread to another one.
+template <typename Queue>
+static long long transfer()
+{
+    Queue queue(1024);
+    long long sum = 0;
+    std::thread consumer([&]
+                         {
+                             for (int i = 0; i < N; ++i)
+                             {
+                                 sum += take(queue);
+                             }
+                         });
+    for (int i = 0; i < N; ++i)
+    {
+        put(queue, i);
+    }
+    consumer.join();
+    return sum;
+}
+
+// Bounce one element between two threads N / 64 times.
+template <typename Queue>
+static int ping_pong()
+{
+    Queue ping(64);
+    Queue pong(64);
+    std::thread echo([&]
+                     {
+                         for (int i = 0; i < N / 64; ++i)
+                         {
+                             put(pong, take(ping));
+                         }
+                     });
+    int ball = 0;
+    for (int i = 0; i < N / 64; ++i)
+    {
+        put(ping, ball);
+        ball = take(pong) + 1;
+    }
+    echo.join();
+    return ball;
+}
+
+TEMPLATE_TEST_CASE("Queue handoff benchmark", "[queue]", LockedQueue, SpscQueue<int>)
+{
+    using Queue = TestType;
+
+    BENCHMARK("throughput")
+    {
+        return transfer<Queue>();
+    };
+
+    BENCHMARK("ping-pong")
+    {
+        return ping_pong<Queue>();
+    };
+}
+
+// Send N elements from the given number of producers to the given number of consumers.
+template <typename Queue>
+static long long fan(int producers, int consumers)
+{
+    Queue queue(1024);
+    std::atomic<long long> sum = 0;
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p)
+    {
+        threads.emplace_back([&]
+                             {
+                                 for (int i = 0; i < N / producers; ++i)
+                                 {
+                                     put(queue, i);
+                                 }
+                             });
+    }
+    for (int c = 0; c < consumers; ++c)
+    {
+        threads.emplace_back([&]
+                             {
+                                 long long local = 0;
+                                 for (int i = 0; i < N / consumers; ++i)
+                                 {
+                                     local += take(queue);
+                                 }
+                                 sum += local;
+                             });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    return sum;
+}
+
+TEMPLATE_TEST_CASE("Queue fan-in/fan-out benchmark", "[queue]", LockedQueue, MpmcQueue<int>)
+{
+    using Queue = TestType;
+
+    for (int producers = 1; producers <= 32; producers *= 2)
+    {
+        for (int consumers = 1; consumers <= 32; consumers *= 2)
+        {
+            BENCHMARK(std::to_string(producers) + " producers, " + std::to_string(consumers) + " consumers")
+            {
+                return fan<Queue>(producers, consumers);
+            };
+        }
+    }
+}
+
+TEST_CASE("Queue batch benchmark", "[queue]")
+{
+    std::vector<int> input(4096);
+    std::iota(input.begin(), input.end(), 0);
+    std::vector<int> output(4096);
+
+    for (int batch = 256; batch <= 4096; batch *= 4)
+    {
+        ArrayQueue<int> queue;
+
+        BENCHMARK("per item, batch " + std::to_string(batch))
+        {
+            for (int i = 0; i < N / batch; ++i)
+            {
+                for (int j = 0; j < batch; ++j)
+                {
+                    queue.enqueue(input[j]);
+                }
+                for (int j = 0; j < batch; ++j)
+                {
+                    output[j] = queue.dequeue();
+                }
+            }
+            return output[batch - 1];
+        };
+
+        BENCHMARK("range, batch " + std::to_string(batch))
+        {
+            for (int i = 0; i < N / batch; ++i)
+            {
+                queue.enqueue_range(input.begin(), input.begin() + batch);
+                queue.dequeue_into(output.begin(), batch);
+            }
+            return output[batch - 1];
+        };
+    }
+}
+
+// A worker that sees one burst and then steady light traffic, sampling the buffer size as it goes.
+template <typename Queue>
+static long long burst_then_steady(Queue& queue, std::vector<int>& samples)
+{
+    long long sum = 0;
+    for (int i = 0; i < 64 * N; ++i)
+    {
+        queue.enqueue(i);
+    }
+    samples.push_back(queue.capacity());
+    for (int round = 0; round < 8; ++round)
+    {
+        while (queue.size() > 64 * N >> (round + 1))
+        {
+            sum += queue.dequeue();
+        }
+        samples.push_back(queue.capacity());
+    }
+    for (int i = 0; i < 64 * N; ++i)
+    {
+        queue.enqueue(i);
+        sum += queue.dequeue();
+    }
+    samples.push_back(queue.capacity());
+    return sum;
+}
+
+TEST_CASE("Queue memory after burst benchmark", "[queue]")
+{
+    for (bool auto_shrink : {false, true})
+    {
+        std::string policy = auto_shrink ? "auto-shrink" : "grow only";
+
+        BENCHMARK(std::string(policy))
+        {
+            ArrayQueue<int> queue;
+            queue.set_auto_shrink(auto_shrink);
+            std::vector<int> samples;
+            return burst_then_steady(queue, samples);
+        };
+
+        // Memory over time: after the burst, after each halving of the backlog, and after the steady phase.
+        ArrayQueue<int> queue;
+        queue.set_auto_shrink(auto_shrink);
+        std::vector<int> samples;
+        burst_then_steady(queue, samples);
+        std::string timeline;
+        for (int capacity : samples)
+        {
+            timeline += std::to_string(capacity * sizeof(int) / 1024) + " KiB ";
+        }
+        WARN(policy << ": " << timeline);
+    }
+}
+
+// Blocking queue that wakes every waiter on every operation, the baseline for BlockingQueue.
+template <typename T>
+class StormQueue
+{
+    ArrayQueue<T> queue_;
+    int capacity_;
+    bool closed_ = false;
+    std::mutex mutex_;
+    std::condition_variable changed_;
+
+public:
+    explicit StormQueue(int capacity)
+        : capacity_(capacity)
+    {
+    }
+
+    void enqueue(const T& element)
+    {
+        std::unique_lock lock(mutex_);
+        changed_.wait(lock, [&] { return queue_.size() < capacity_; });
+        queue_.enqueue(element);
+        changed_.notify_all();
+    }
+
+    bool try_dequeue_for(T& element, std::chrono::seconds timeout)
+    {
+        std::unique_lock lock(mutex_);
+        changed_.wait_for(lock, timeout, [&] { return closed_ || !queue_.is_empty(); });
+        if (queue_.is_empty())
+        {
+            return false;
+        }
+        element = queue_.dequeue();
+        changed_.notify_all();
+        return true;
+    }
+
+    void close()
+    {
+        std::lock_guard lock(mutex_);
+        closed_ = true;
+        changed_.notify_all();
+    }
+};
+
+// Customer of the bank, with the number of time units of service.
+struct Customer
+{
+    int time;
+};
+
+// The bank of examples/simulate_bank_queuing.cpp with one thread per window:
+// the door lets customers into a waiting hall with a few seats, and each window serves the next customer in the hall.
+template <typename Queue>
+static long long simulate_bank(int windows)
+{
+    const int customers = N / 4;
+    const int max_time = 10;
+    Queue hall(windows * 2);
+    std::atomic<long long> served = 0;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < windows; ++i)
+    {
+        threads.emplace_back([&]
+                             {
+                                 long long local = 0;
+                                 for (Customer c; hall.try_dequeue_for(c, std::chrono::seconds(10));)
+                                 {
+                                     // each time unit of service is a little work
+                                     volatile int work = 0;
+                                     for (int unit = 0; unit < c.time * 16; ++unit)
+                                     {
+                                         work = work + unit;
+                                     }
+                                     local += c.time;
+                                 }
+                                 served += local;
+                             });
+    }
+
+    std::mt19937 gen(42);
+    for (int i = 0; i < customers; ++i)
+    {
+        hall.enqueue(Customer{1 + int(gen() % max_time)});
+    }
+    hall.close();
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    return served;
+}
+
+TEMPLATE_TEST_CASE("Bank simulation benchmark", "[queue]", StormQueue<Customer>, BlockingQueue<Customer>)
+{
+    using Queue = TestType;
+
+    for (int windows : {1, 2, 4, 8})
+    {
+        BENCHMARK(std::to_string(windows) + " windows")
+        {
+            return simulate_bank<Queue>(windows);
+        };
+    }
+}
@@ -0,0 +1,113 @@
+#include "tool.hpp"
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../sources/Stack/ArrayStack.hpp"
+#include "../sources/Stack/ConcurrentStack.hpp"
+#include "../sources/Stack/LinkedStack.hpp"
+#include "../sources/Stack/UnrolledStack.hpp"
+
+constexpr int N = 1 << 16;
+
+TEMPLATE_TEST_CASE("Stack benchmark", "[stack]", LinkedStack<int>, UnrolledStack<int>, ArrayStack<int>)
+{
+    using Stack = TestType;
+
+    // Grow to N elements and pop them all.
+    BENCHMARK("push + pop")
+    {
+        Stack stack;
+        for (int i = 0; i < N; ++i)
+        {
+            stack.push(i);
+        }
+        long long sum = 0;
+        while (!stack.is_empty())
+        {
+            sum += stack.pop();
+        }
+        return sum;
+    };
+
+    // Bounce around a chunk boundary, where a stack without a spare would allocate on every other push.
+    Stack stack;
+    for (int i = 0; i < 64; ++i)
+    {
+        stack.push(i);
+    }
+    BENCHMARK("push + pop at a boundary")
+    {
+        for (int i = 0; i < N; ++i)
+        {
+            stack.push(i);
+            stack.pop();
+        }
+        return stack.size();
+    };
+}
+
+// ArrayStack behind a mutex, the baseline for ConcurrentStack.
+template <typename T>
+class LockedStack
+{
+    ArrayStack<T> stack_;
+    std::mutex mutex_;
+
+public:
+    void push(const T& element)
+    {
+        std::lock_guard lock(mutex_);
+        stack_.push(element);
+    }
+
+    bool try_pop(T& element)
+    {
+        std::lock_guard lock(mutex_);
+        if (stack_.is_empty())
+        {
+            return false;
+        }
+        element = stack_.pop();
+        return true;
+    }
+};
+
+TEMPLATE_TEST_CASE("Stack contention benchmark", "[stack]", LockedStack<int>, ConcurrentStack<int>)
+{
+    using Stack = TestType;
+
+    // A shared LIFO pool, every thread pushes and pops in turn.
+    for (int workers : {1, 2, 4, 8})
+    {
+        BENCHMARK(std::to_string(workers) + " threads")
+        {
+            Stack stack;
+            std::atomic<long long> sum = 0;
+            std::vector<std::thread> threads;
+            for (int w = 0; w < workers; ++w)
+            {
+                threads.emplace_back([&]
+                                     {
+                                         long long local = 0;
+                                         for (int i = 0; i < N / workers; ++i)
+                                         {
+                                             int element;
+                                             stack.push(i);
+                                             if (stack.try_pop(element))
+                                             {
+                                                 local += element;
+                                             }
+                                         }
+                                         sum += local;
+                                     });
+            }
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+            return sum.load();
+        };
+    }
+}
@@ -0,0 +1,487 @@
+#include "tool.hpp"
+
+#include "../sources/Map/ConcurrentSkipListMap.hpp"
+#include "../sources/Map/TreeMap.hpp"
+#include "../sources/Tree/AVLTree.hpp"
+#include "../sources/Tree/BTree.hpp"
+#include "../sources/Tree/PersistentAVLTree.hpp"
+#include "../sources/Tree/RedBlackTree.hpp"
+#include "../sources/Tree/SplayTree.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <thread>
+
+constexpr int N = 1 << 18;
+
+// Counter of the bytes requested from operator new by this thread, set only while the memory report runs.
+// Every benchmark links into the same binary, so outside the report operator new costs a branch and touches no shared state.
+static thread_local std::size_t* counted_bytes = nullptr;
+
+// Out of line, so that the compiler does not pair the malloc and free across inlined new and delete expressions.
+[[gnu::noinline]] void* operator new(std::size_t size)
+{
+    if (counted_bytes != nullptr)
+    {
+        *counted_bytes += size;
+    }
+    if (void* p = std::malloc(size == 0 ? 1 : size))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+[[gnu::noinline]] void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+[[gnu::noinline]] void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+// Distinct keys in random order, the same for every tree.
+static const std::vector<int>& shuffled_keys()
+{
+    static std::vector<int> keys = []
+    {
+        std::vector<int> v(N);
+        std::iota(v.begin(), v.end(), 0);
+        std::shuffle(v.begin(), v.end(), std::mt19937(42));
+        return v;
+    }();
+    return keys;
+}
+
+TEMPLATE_TEST_CASE("Tree benchmark", "[tree]", AVLTree<int>, RedBlackTree<int>, BTree<int>)
+{
+    using Tree = TestType;
+
+    const auto& keys = shuffled_keys();
+    Tree tree;
+    for (int key : keys)
+    {
+        tree.insert(key);
+    }
+
+    BENCHMARK("insert")
+    {
+        Tree fresh;
+        for (int key : keys)
+        {
+            fresh.insert(key);
+        }
+        return fresh.size();
+    };
+
+    // The same keys from a sorted dump, once inserted one by one and once built in bulk.
+    std::vector<int> sorted(keys.begin(), keys.end());
+    std::sort(sorted.begin(), sorted.end());
+
+    BENCHMARK("insert sorted")
+    {
+        Tree fresh;
+        for (int key : sorted)
+        {
+            fresh.insert(key);
+        }
+        return fresh.size();
+    };
+
+    BENCHMARK("build from sorted")
+    {
+        Tree fresh(sorted.begin(), sorted.end());
+        return fresh.size();
+    };
+
+    // Lookups of random keys, half of them missing, far beyond the cache for the binary trees.
+    BENCHMARK("find")
+    {
+        int found = 0;
+        for (int i = 0; i < N; ++i)
+        {
+            found += tree.contains(int(rng()() % (2 * N)));
+        }
+        return found;
+    };
+
+    // Ordered scan of all elements.
+    BENCHMARK("iterate")
+    {
+        long long sum = 0;
+        for (const auto& e : tree)
+        {
+            sum += e;
+        }
+        return sum;
+    };
+
+    BENCHMARK("insert + remove")
+    {
+        Tree fresh;
+        for (int key : keys)
+        {
+            fresh.insert(key);
+        }
+        for (int key : keys)
+        {
+            fresh.remove(key);
+        }
+        return fresh.size();
+    };
+}
+
+TEMPLATE_TEST_CASE("Sorted stream benchmark", "[tree]", AVLTree<int>, RedBlackTree<int>)
+{
+    using Tree = TestType;
+
+    // Keys of a time series: strictly increasing, and nearly sorted with each key displaced by a few places.
+    std::vector<int> monotonic(N);
+    std::iota(monotonic.begin(), monotonic.end(), 0);
+    std::vector<int> nearly_sorted = monotonic;
+    for (int i = 0; i + 16 < N; i += 8)
+    {
+        std::swap(nearly_sorted[i], nearly_sorted[i + rng()() % 16]);
+    }
+
+    for (const auto& [name, keys] : {std::pair{"monotonic", &monotonic}, std::pair{"nearly sorted", &nearly_sorted}})
+    {
+        BENCHMARK(std::string(name) + " insert")
+        {
+            Tree tree;
+            for (int key : *keys)
+            {
+                tree.insert(key);
+            }
+            return tree.size();
+        };
+
+        BENCHMARK(std::string(name) + " insert with hint")
+        {
+            Tree tree;
+            auto hint = tree.end();
+            for (int key : *keys)
+            {
+                hint = tree.insert(hint, key);
+            }
+            return tree.size();
+        };
+
+        BENCHMARK(std::string(name) + " finger search")
+        {
+            Tree tree;
+            tree.set_finger_search(true);
+            for (int key : *keys)
+            {
+                tree.insert(key);
+            }
+            return tree.size();
+        };
+    }
+}
+
+TEMPLATE_TEST_CASE("TreeMap benchmark", "[map]", (TreeMap<int, int>), (TreeMap<int, int, BTree<detail::MapEntry<int, int>>>))
+{
+    using Map = TestType;
+
+    const auto& keys = shuffled_keys();
+    Map map;
+    for (int key : keys)
+    {
+        map.insert(key, key);
+    }
+
+    // Random lookups and updates through operator[].
+    BENCHMARK("lookup")
+    {
+        long long sum = 0;
+        for (int i = 0; i < N; ++i)
+        {
+            sum += map[keys[i]]++;
+        }
+        return sum;
+    };
+}
+
+TEST_CASE("TreeMap sorted stream benchmark", "[map]")
+{
+    // Samples of a time series, arriving in order of timestamp.
+    BENCHMARK("insert")
+    {
+        TreeMap<int, int> map;
+        for (int t = 0; t < N; ++t)
+        {
+            map.insert(t, t);
+        }
+        return map.size();
+    };
+
+    BENCHMARK("insert with hint")
+    {
+        TreeMap<int, int> map;
+        auto hint = map.end();
+        for (int t = 0; t < N; ++t)
+        {
+            hint = map.insert(hint, t, t);
+        }
+        return map.size();
+    };
+
+    BENCHMARK("finger search")
+    {
+        TreeMap<int, int> map;
+        map.set_finger_search(true);
+        for (int t = 0; t < N; ++t)
+        {
+            map.insert(t, t);
+        }
+        return map.size();
+    };
+}
+
+TEMPLATE_TEST_CASE("TreeMap snapshot benchmark", "[map]", (TreeMap<int, int>), (TreeMap<int, int, PersistentAVLTree<detail::MapEntry<int, int>>>))
+{
+    using Map = TestType;
+
+    const auto& keys = shuffled_keys();
+    Map map;
+    for (int key : keys)
+    {
+        map.insert(key, key);
+    }
+
+    // A consistent copy of the index per request, followed by a few updates of the original.
+    BENCHMARK("snapshot + update")
+    {
+        long long sum = 0;
+        for (int request = 0; request < 16; ++request)
+        {
+            const Map snapshot = map;
+            for (int i = 0; i < 64; ++i)
+            {
+                map[keys[rng()() % N]]++;
+            }
+            sum += snapshot[keys[request]];
+        }
+        return sum;
+    };
+}
+
+// TreeMap behind a mutex, the baseline for ConcurrentSkipListMap.
+class LockedTreeMap
+{
+    TreeMap<int, int> map_;
+    mutable std::mutex mutex_;
+
+public:
+    bool insert(int key, int value)
+    {
+        std::lock_guard lock(mutex_);
+        return map_.insert(key, value);
+    }
+
+    bool remove(int key)
+    {
+        std::lock_guard lock(mutex_);
+        return map_.remove(key);
+    }
+
+    long long sum_range(int lo, int hi) const
+    {
+        std::lock_guard lock(mutex_);
+        long long sum = 0;
+        for (const auto& entry : map_.range(lo, hi))
+        {
+            sum += entry.value();
+        }
+        return sum;
+    }
+};
+
+// The same for ConcurrentSkipListMap, without a lock.
+class SkipListMap
+{
+    ConcurrentSkipListMap<int, int> map_;
+
+public:
+    bool insert(int key, int value)
+    {
+        return map_.insert(key, value);
+    }
+
+    bool remove(int key)
+    {
+        return map_.remove(key);
+    }
+
+    long long sum_range(int lo, int hi) const
+    {
+        long long sum = 0;
+        for (const auto& entry : map_.range(lo, hi))
+        {
+            sum += entry.value();
+        }
+        return sum;
+    }
+};
+
+TEMPLATE_TEST_CASE("Order book benchmark", "[map]", LockedTreeMap, SkipListMap)
+{
+    using Book = TestType;
+
+    // Feed threads add and cancel price levels on interleaved prices, and scan the 16 levels above a random price now and then.
+    const auto& keys = shuffled_keys();
+    for (int workers : {1, 2, 4, 8})
+    {
+        BENCHMARK(std::to_string(workers) + " threads")
+        {
+            Book book;
+            std::atomic<long long> sum = 0;
+            std::vector<std::thread> threads;
+            for (int w = 0; w < workers; ++w)
+            {
+                threads.emplace_back([&, w]
+                                     {
+                                         long long local = 0;
+                                         for (int i = w; i < N; i += workers)
+                                         {
+                                             book.insert(keys[i], i);
+                                             if (i % 4 == 0)
+                                             {
+                                                 book.remove(keys[i - i % 8]);
+                                             }
+                                             if (i % 16 == 0)
+                                             {
+                                                 local += book.sum_range(keys[i], keys[i] + 16);
+                                             }
+                                         }
+                                         sum += local;
+                                     });
+            }
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+            return sum.load();
+        };
+    }
+}
+
+TEST_CASE("Order statistics benchmark", "[tree]")
+{
+    RedBlackTree<int> tree;
+    for (int key : shuffled_keys())
+    {
+        tree.insert(key);
+    }
+
+    // The k-th smallest element by walking the iterator, O(k) per query.
+    BENCHMARK("select by iteration")
+    {
+        long long sum = 0;
+        for (int i = 0; i < 16; ++i)
+        {
+            sum += *std::next(tree.begin(), int(rng()() % N));
+        }
+        return sum;
+    };
+
+    // The same by subtree counts, O(log N) per query.
+    BENCHMARK("select")
+    {
+        long long sum = 0;
+        for (int i = 0; i < 16; ++i)
+        {
+            sum += tree.select(int(rng()() % N));
+        }
+        return sum;
+    };
+}
+
+TEMPLATE_TEST_CASE("Set operations benchmark", "[tree]", AVLTree<int>, RedBlackTree<int>)
+{
+    using Tree = TestType;
+
+    // Two overlapping sets of N keys each.
+    const auto& keys = shuffled_keys();
+    std::vector<int> evens(N);
+    std::vector<int> thirds(N);
+    for (int i = 0; i < N; ++i)
+    {
+        evens[i] = 2 * keys[i];
+        thirds[i] = 3 * keys[i];
+    }
+    const Tree a(evens.begin(), evens.end());
+    const Tree b(thirds.begin(), thirds.end());
+
+    // Each run works on its own copies, made outside the measurement.
+    auto copies = [](const Tree& tree, int runs)
+    { return std::vector<Tree>(runs, tree); };
+
+    // Element by element, as without the set operations.
+    BENCHMARK_ADVANCED("union by insert")(Catch::Benchmark::Chronometer meter)
+    {
+        auto xs = copies(a, meter.runs());
+        meter.measure([&](int i)
+                      {
+                          for (int e : b)
+                          {
+                              xs[i].insert(e);
+                          }
+                          return xs[i].size();
+                      });
+    };
+
+    BENCHMARK_ADVANCED("union_with")(Catch::Benchmark::Chronometer meter)
+    {
+        auto xs = copies(a, meter.runs());
+        auto ys = copies(b, meter.runs());
+        meter.measure([&](int i)
+                      {
+                          xs[i].union_with(std::move(ys[i]));
+                          return xs[i].size();
+                      });
+    };
+
+    BENCHMARK_ADVANCED("intersect_with")(Catch::Benchmark::Chronometer meter)
+    {
+        auto xs = copies(a, meter.runs());
+        auto ys = copies(b, meter.runs());
+        meter.measure([&](int i)
+                      {
+                          xs[i].intersect_with(std::move(ys[i]));
+                          return xs[i].size();
+                      });
+    };
+}
+
+// Bytes per element of a tree of N ints, counted as the bytes requested while inserting
+// (neither the binary trees nor the B+ tree free anything on insertion), without the allocator overhead.
+template <typename Tree>
+static void report_memory(const char* name)
+{
+    const auto& keys = shuffled_keys();
+    std::size_t bytes = 0;
+    counted_bytes = &bytes;
+    Tree tree;
+    for (int key : keys)
+    {
+        tree.insert(key);
+    }
+    counted_bytes = nullptr;
+    WARN(name << ": " << double(bytes) / tree.size() << " bytes per element");
+}
+
+TEST_CASE("Tree memory report", "[tree]")
+{
+    report_memory<BinarySearchTree<int>>("BinarySearchTree");
+    report_memory<SplayTree<int>>("SplayTree");
+    report_memory<AVLTree<int>>("AVLTree");
+    report_memory<RedBlackTree<int>>("RedBlackTree");
+    report_memory<BTree<int>>("BTree");
+    report_memory<PersistentAVLTree<int>>("PersistentAVLTree");
+}
@@ -0,0 +1,17 @@
+#include <filesystem>
+#include <numeric>
+#include <random>
+
+#include <catch2/catch_all.hpp>
+
+namespace hellods
+{
+}
+using namespace hellods;
+
+// Fixed-seed random number generator, so that every container sees the same workload.
+inline std::mt19937& rng()
+{
+    static std::mt19937 engine(42);
+    return engine;
+}
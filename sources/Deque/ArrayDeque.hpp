@@ -15,6 +15,8 @@ namespace hellods
 {
 
 /// Deque implemented by array.
+///
+/// The capacity of the ring buffer is always a power of two, so wrapping an index around is a bitmask instead of a modulo.
 template <typename T>
 class ArrayDeque : public Deque<T, std::random_access_iterator_tag>
 {
@@ -26,20 +28,20 @@ class ArrayDeque : public Deque<T, std::random_access_iterator_tag>
     protected:
         using Value = std::conditional_t<Const, const T, T>;
 
-        // Virtual pointer = buffer_begin_ + head_ + offset_ (linear, no modulo).
-        Value* current_;
+        // Virtual index = front_ + offset (linear, wrapped by the mask on dereference).
+        std::ptrdiff_t current_;
 
         // Begin of the ring buffer.
-        Value* buffer_begin_;
+        Value* buffer_;
 
-        // End of the ring buffer.
-        Value* buffer_end_;
+        // Capacity of the ring buffer - 1.
+        std::ptrdiff_t mask_;
 
         // Create an iterator that point to the current data of deque.
-        Iter(Value* current, Value* begin, Value* end)
+        Iter(std::ptrdiff_t current, Value* buffer, std::ptrdiff_t mask)
             : current_(current)
-            , buffer_begin_(begin)
-            , buffer_end_(end)
+            , buffer_(buffer)
+            , mask_(mask)
         {
         }
 
@@ -47,7 +49,7 @@ class ArrayDeque : public Deque<T, std::random_access_iterator_tag>
         /// Dereference.
         Value& operator*() const
         {
-            return current_ < buffer_end_ ? *current_ : *(current_ - (buffer_end_ - buffer_begin_));
+            return buffer_[current_ & mask_];
         }
 
         /// Check if two iterators are same.
@@ -112,7 +114,7 @@ class ArrayDeque : public Deque<T, std::random_access_iterator_tag>
             return *(*this + n);
         }
 
-        /// Ordering comparisons (based on virtual pointer position).
+        /// Ordering comparisons (based on virtual index).
         bool operator<(const Iter& that) const
         {
             return current_ < that.current_;
@@ -137,7 +139,9 @@ class ArrayDeque : public Deque<T, std::random_access_iterator_tag>
 protected:
     using Base = Deque<T, std::random_access_iterator_tag>;
     using Base::INIT_CAPACITY;
-    using Base::MAX_CAPACITY;
+
+    // Maximum capacity, the largest power of two within the limit of the base.
+    static constexpr int MAX_CAPACITY = int(std::bit_floor(unsigned(Base::MAX_CAPACITY)));
 
     // Index of front in ring buffer. data[front] is the first element, except size == 0.
     int front_;
@@ -145,31 +149,46 @@ protected:
     // Number of elements.
     int size_;
 
-    // Available capacity.
+    // Available capacity, always a power of two.
     int capacity_;
 
     // Pointer to ring buffer.
     T* data_;
 
+    // Whether to shrink the capacity automatically when elements are removed.
+    bool auto_shrink_;
+
     // Convert logic index to ring buffer physical index.
     int access(int logic_index) const
     {
-        return (front_ + logic_index) % capacity_;
+        return (front_ + logic_index) & (capacity_ - 1);
     }
 
-    // Expand capacity safely for ring buffer. Require size == capacity.
-    void expand_capacity()
+    // Move the elements into a ring buffer of the power of two not less than the given capacity, starting at index 0.
+    // Require size <= capacity <= MAX_CAPACITY.
+    void reallocate(int min_capacity)
     {
-        capacity_ = (capacity_ < MAX_CAPACITY / 2) ? capacity_ * 2 : MAX_CAPACITY; // double the capacity until MAX_CAPACITY
+        int head = std::min(size_, capacity_ - front_); // elements before wrapping around
+        capacity_ = int(std::bit_ceil(unsigned(min_capacity)));
         T* new_data = new T[capacity_];
-        std::copy(data_ + front_, data_ + capacity_, new_data);
-        std::copy(data_, data_ + front_, new_data + (capacity_ - front_));
+        std::move(data_ + front_, data_ + front_ + head, new_data);
+        std::move(data_, data_ + (size_ - head), new_data + head);
 
         delete[] data_;
         data_ = new_data;
         front_ = 0;
     }
 
+    // Shrink capacity if auto-shrink is on and less than a quarter is used, leaving the buffer about half full.
+    // Growing again takes doubling the size and shrinking again takes halving it, so the two never alternate.
+    void shrink_if_sparse()
+    {
+        if (auto_shrink_ && size_ < capacity_ / 4 && capacity_ > INIT_CAPACITY)
+        {
+            reallocate(std::max(size_ * 2, int(INIT_CAPACITY)));
+        }
+    }
+
     // Swap with another deque.
     void swap(ArrayDeque& that)
     {
@@ -177,6 +196,7 @@ protected:
         std::swap(size_, that.size_);
         std::swap(capacity_, that.capacity_);
         std::swap(data_, that.data_);
+        std::swap(auto_shrink_, that.auto_shrink_);
     }
 
 public:
@@ -189,6 +209,7 @@ public:
         , size_(0)
         , capacity_(INIT_CAPACITY)
         , data_(new T[capacity_])
+        , auto_shrink_(false)
     {
     }
 
@@ -196,8 +217,9 @@ public:
     ArrayDeque(const std::initializer_list<T>& il)
         : front_(0)
         , size_(int(il.size()))
-        , capacity_(size_ > INIT_CAPACITY ? size_ : INIT_CAPACITY)
+        , capacity_(int(std::bit_ceil(unsigned(size_ > INIT_CAPACITY ? size_ : INIT_CAPACITY))))
         , data_(new T[capacity_])
+        , auto_shrink_(false)
     {
         std::copy(il.begin(), il.end(), data_);
     }
@@ -208,6 +230,7 @@ public:
         , size_(that.size_)
         , capacity_(that.capacity_)
         , data_(new T[capacity_])
+        , auto_shrink_(that.auto_shrink_)
     {
         std::copy(that.data_, that.data_ + capacity_, data_);
     }
@@ -238,23 +261,23 @@ public:
     /// Return an iterator to the first element of the deque.
     Base::Iterator begin() override
     {
-        return typename Base::Iterator(Iter<false>(data_ + front_, data_, data_ + capacity_));
+        return typename Base::Iterator(Iter<false>(front_, data_, capacity_ - 1));
     }
 
     Base::ConstIterator begin() const override
     {
-        return typename Base::ConstIterator(Iter<true>(data_ + front_, data_, data_ + capacity_));
+        return typename Base::ConstIterator(Iter<true>(front_, data_, capacity_ - 1));
     }
 
     /// Return an iterator to the element following the last element of the deque.
     Base::Iterator end() override
     {
-        return typename Base::Iterator(Iter<false>(data_ + front_ + size_, data_, data_ + capacity_));
+        return typename Base::Iterator(Iter<false>(std::ptrdiff_t(front_) + size_, data_, capacity_ - 1));
     }
 
     Base::ConstIterator end() const override
     {
-        return typename Base::ConstIterator(Iter<true>(data_ + front_ + size_, data_, data_ + capacity_));
+        return typename Base::ConstIterator(Iter<true>(std::ptrdiff_t(front_) + size_, data_, capacity_ - 1));
     }
     /// @}
 
@@ -278,6 +301,20 @@ public:
     }
 
     using Base::back; // const
+
+    /// Return the elements as two contiguous segments in order: from the front to the end of the buffer, then the wrapped-around part.
+    /// The second segment is empty if the elements do not wrap around. The segments are invalidated by any change of the deque.
+    std::pair<std::span<T>, std::span<T>> segments()
+    {
+        int head = std::min(size_, capacity_ - front_);
+        return {std::span<T>(data_ + front_, head), std::span<T>(data_, size_ - head)};
+    }
+
+    std::pair<std::span<const T>, std::span<const T>> segments() const
+    {
+        int head = std::min(size_, capacity_ - front_);
+        return {std::span<const T>(data_ + front_, head), std::span<const T>(data_, size_ - head)};
+    }
     /// @}
 
     /// @name Examination
@@ -288,6 +325,12 @@ public:
     {
         return size_;
     }
+
+    /// Get the number of elements that the deque can hold before growing, always a power of two.
+    int capacity() const
+    {
+        return capacity_;
+    }
     /// @}
 
     /// @name Manipulation
@@ -300,10 +343,10 @@ public:
 
         if (size_ == capacity_)
         {
-            expand_capacity();
+            reallocate(size_ + 1);
         }
 
-        front_ = (front_ + capacity_ - 1) % capacity_;
+        front_ = (front_ - 1) & (capacity_ - 1);
         data_[front_] = element;
         size_++;
     }
@@ -315,7 +358,7 @@ public:
 
         if (size_ == capacity_)
         {
-            expand_capacity();
+            reallocate(size_ + 1);
         }
 
         data_[access(size_)] = element;
@@ -328,8 +371,9 @@ public:
         detail::check_empty(size_);
 
         T data = std::move(data_[front_]);
-        front_ = (front_ + 1) % capacity_;
+        front_ = (front_ + 1) & (capacity_ - 1);
         size_--;
+        shrink_if_sparse();
 
         return data;
     }
@@ -341,10 +385,63 @@ public:
 
         T data = std::move(data_[access(size_ - 1)]);
         size_--;
+        shrink_if_sparse();
 
         return data;
     }
 
+    /// Push back all elements in the range [first, last), growing the buffer at most once and copying in at most two segments.
+    /// The range must not refer to the elements of this container.
+    template <std::input_iterator InputIt>
+    void push_back_range(InputIt first, InputIt last)
+    {
+        if constexpr (std::forward_iterator<InputIt>)
+        {
+            // check
+            int count = int(std::distance(first, last));
+            detail::check_full(size_, MAX_CAPACITY - count + 1);
+
+            // expand capacity if need
+            if (size_ + count > capacity_)
+            {
+                reallocate(size_ + count);
+            }
+
+            // copy up to the end of the buffer, then wrap around
+            int rear = access(size_);
+            int head = std::min(count, capacity_ - rear);
+            auto middle = std::next(first, head);
+            std::copy(first, middle, data_ + rear);
+            std::copy(middle, last, data_);
+            size_ += count;
+        }
+        else
+        {
+            for (; first != last; ++first)
+            {
+                push_back(*first);
+            }
+        }
+    }
+
+    /// Pop up to count front elements of the deque into the output iterator, moving them in at most two segments.
+    /// Return the number of popped elements.
+    template <std::output_iterator<T> OutputIt>
+    int pop_front_n(OutputIt out, int count)
+    {
+        count = std::clamp(count, 0, size_);
+
+        // move up to the end of the buffer, then wrap around
+        int head = std::min(count, capacity_ - front_);
+        out = std::move(data_ + front_, data_ + front_ + head, out);
+        std::move(data_, data_ + (count - head), out);
+
+        front_ = access(count);
+        size_ -= count;
+        shrink_if_sparse();
+        return count;
+    }
+
     /// Remove all of the elements from the deque.
     void clear() override
     {
@@ -352,6 +449,24 @@ public:
         // Managing the pointer is the user's responsibility.
         size_ = 0;
         front_ = 0;
+        shrink_if_sparse();
+    }
+
+    /// Reduce the capacity to the smallest power of two that holds the elements, but not below the initial capacity.
+    void shrink_to_fit()
+    {
+        if (capacity_ > int(std::bit_ceil(unsigned(std::max(size_, int(INIT_CAPACITY))))))
+        {
+            reallocate(std::max(size_, int(INIT_CAPACITY)));
+        }
+    }
+
+    /// Turn automatic shrinking on or off (default off).
+    /// When on, a removal that leaves less than a quarter of the capacity in use shrinks it to about twice the number of elements.
+    void set_auto_shrink(bool enabled)
+    {
+        auto_shrink_ = enabled;
+        shrink_if_sparse();
     }
 
     /// @}
@@ -0,0 +1,470 @@
+/**
+ * @file BlockDeque.hpp
+ * @author Chen QingYu <chen_qingyu@qq.com>
+ * @brief Deque implemented by a map of fixed-size blocks.
+ * @date 2026.10.18
+ */
+
+#ifndef BLOCKDEQUE_HPP
+#define BLOCKDEQUE_HPP
+
+#include "../core.hpp"
+#include "Deque.hpp"
+
+namespace hellods
+{
+
+/// Deque implemented by a map of fixed-size blocks.
+///
+/// The elements live in blocks of BLOCK_SIZE slots, and an array of block pointers (the map) keeps the blocks in order, like std::deque.
+/// Growing at either end allocates at most one block and, when the map runs out of room, copies the block pointers but never the elements,
+/// so references to the elements stay valid until the elements are popped. Iterators are invalidated by pushes and pops.
+/// Element i sits at position front + i counted from the first block, so random access is a shift and a mask.
+/// One emptied block is kept as a spare, so pushing and popping across a block boundary does not allocate every time.
+template <typename T>
+class BlockDeque : public Deque<T, std::random_access_iterator_tag>
+{
+public:
+    /// Number of elements in a block, a power of two covering about 4 KiB.
+    static constexpr int BLOCK_SIZE = int(std::bit_floor(std::max(std::size_t(16), std::size_t(4096) / sizeof(T))));
+
+protected:
+    // log2(BLOCK_SIZE), the position shifted right by it is the block.
+    static constexpr int BLOCK_SHIFT = std::countr_zero(unsigned(BLOCK_SIZE));
+
+    // BLOCK_SIZE - 1, the position masked by it is the slot in the block.
+    static constexpr std::size_t BLOCK_MASK = std::size_t(BLOCK_SIZE) - 1;
+
+    template <bool Const>
+    class Iter
+    {
+        friend class BlockDeque;
+
+    protected:
+        using Value = std::conditional_t<Const, const T, T>;
+
+        // Position counted from the begin of the first block.
+        std::ptrdiff_t current_;
+
+        // Map entry of the first block.
+        T* const* blocks_;
+
+        // Create an iterator that point to the current position of deque.
+        Iter(std::ptrdiff_t current, T* const* blocks)
+            : current_(current)
+            , blocks_(blocks)
+        {
+        }
+
+    public:
+        /// Dereference.
+        Value& operator*() const
+        {
+            return blocks_[std::size_t(current_) >> BLOCK_SHIFT][std::size_t(current_) & BLOCK_MASK];
+        }
+
+        /// Check if two iterators are same.
+        bool operator==(const Iter& that) const
+        {
+            return current_ == that.current_;
+        }
+
+        /// Increment the iterator.
+        Iter& operator++()
+        {
+            ++current_;
+            return *this;
+        }
+
+        /// Decrement the iterator.
+        Iter& operator--()
+        {
+            --current_;
+            return *this;
+        }
+
+        /// Advance by n elements.
+        Iter& operator+=(std::ptrdiff_t n)
+        {
+            current_ += n;
+            return *this;
+        }
+
+        /// Return a copy advanced by n elements.
+        Iter operator+(std::ptrdiff_t n) const
+        {
+            auto tmp = *this;
+            tmp += n;
+            return tmp;
+        }
+
+        /// Retreat by n elements.
+        Iter& operator-=(std::ptrdiff_t n)
+        {
+            current_ -= n;
+            return *this;
+        }
+
+        /// Return a copy retreated by n elements.
+        Iter operator-(std::ptrdiff_t n) const
+        {
+            auto tmp = *this;
+            tmp -= n;
+            return tmp;
+        }
+
+        /// Signed distance (number of elements) between two iterators.
+        std::ptrdiff_t operator-(const Iter& that) const
+        {
+            return current_ - that.current_;
+        }
+
+        /// Access the element at offset n without advancing.
+        Value& operator[](std::ptrdiff_t n) const
+        {
+            return *(*this + n);
+        }
+
+        /// Ordering comparisons (based on position).
+        bool operator<(const Iter& that) const
+        {
+            return current_ < that.current_;
+        }
+
+        bool operator<=(const Iter& that) const
+        {
+            return current_ <= that.current_;
+        }
+
+        bool operator>(const Iter& that) const
+        {
+            return current_ > that.current_;
+        }
+
+        bool operator>=(const Iter& that) const
+        {
+            return current_ >= that.current_;
+        }
+    };
+
+protected:
+    using Base = Deque<T, std::random_access_iterator_tag>;
+    using Base::INIT_CAPACITY;
+
+    // Maximum capacity, leaving room for the partly used blocks at both ends so positions fit in int.
+    static constexpr int MAX_CAPACITY = Base::MAX_CAPACITY - 2 * BLOCK_SIZE;
+
+    // Map of block pointers. map_[first_] to map_[first_ + blocks_ - 1] are the blocks in use.
+    T** map_;
+
+    // Number of entries in the map.
+    int map_capacity_;
+
+    // Map index of the first block.
+    int first_;
+
+    // Number of blocks in use, at least one.
+    int blocks_;
+
+    // Position of the front element in the first block, less than BLOCK_SIZE.
+    int front_;
+
+    // Number of elements.
+    int size_;
+
+    // An emptied block kept for the next allocation, or nullptr.
+    T* spare_;
+
+    // Return the slot at the given position counted from the begin of the first block, which is never negative.
+    T& at(int pos) const
+    {
+        return map_[first_ + (std::size_t(pos) >> BLOCK_SHIFT)][std::size_t(pos) & BLOCK_MASK];
+    }
+
+    // Take the spare block, or allocate a new one.
+    T* take_block()
+    {
+        return spare_ ? std::exchange(spare_, nullptr) : new T[BLOCK_SIZE];
+    }
+
+    // Keep the block as the spare, or free it if there is one already.
+    void release_block(T* block)
+    {
+        if (spare_)
+        {
+            delete[] block;
+        }
+        else
+        {
+            spare_ = block;
+        }
+    }
+
+    // Move the block pointers to the middle of a map with room for at least one more block at each end.
+    void reserve_map()
+    {
+        int new_capacity = std::max(map_capacity_, (blocks_ + 1) * 2);
+        int new_first = (new_capacity - blocks_) / 2;
+        T** new_map = new T*[new_capacity];
+        std::copy(map_ + first_, map_ + first_ + blocks_, new_map + new_first);
+
+        delete[] map_;
+        map_ = new_map;
+        map_capacity_ = new_capacity;
+        first_ = new_first;
+    }
+
+    // Swap with another deque.
+    void swap(BlockDeque& that)
+    {
+        std::swap(map_, that.map_);
+        std::swap(map_capacity_, that.map_capacity_);
+        std::swap(first_, that.first_);
+        std::swap(blocks_, that.blocks_);
+        std::swap(front_, that.front_);
+        std::swap(size_, that.size_);
+        std::swap(spare_, that.spare_);
+    }
+
+public:
+    /// @name Lifecycle
+    /// @{
+
+    /// Create an empty deque, with one block whose middle is ready for both ends.
+    BlockDeque()
+        : map_(new T*[INIT_CAPACITY])
+        , map_capacity_(INIT_CAPACITY)
+        , first_(INIT_CAPACITY / 2)
+        , blocks_(1)
+        , front_(BLOCK_SIZE / 2)
+        , size_(0)
+        , spare_(nullptr)
+    {
+        map_[first_] = new T[BLOCK_SIZE];
+    }
+
+    /// Create a deque based on the given initializer list.
+    BlockDeque(const std::initializer_list<T>& il)
+        : BlockDeque()
+    {
+        for (auto it = il.begin(); it != il.end(); ++it)
+        {
+            push_back(*it);
+        }
+    }
+
+    /// Copy constructor.
+    BlockDeque(const BlockDeque& that)
+        : BlockDeque()
+    {
+        for (auto it = that.begin(); it != that.end(); ++it)
+        {
+            push_back(*it);
+        }
+    }
+
+    /// Move constructor.
+    BlockDeque(BlockDeque&& that)
+        : BlockDeque()
+    {
+        swap(that);
+    }
+
+    BlockDeque& operator=(BlockDeque that)
+    {
+        swap(that);
+        return *this;
+    }
+
+    /// Destroy the deque object.
+    ~BlockDeque()
+    {
+        for (int i = first_; i < first_ + blocks_; ++i)
+        {
+            delete[] map_[i];
+        }
+        delete[] spare_;
+        delete[] map_;
+    }
+    /// @}
+
+    /// @name Iterator
+    /// @{
+
+    /// Return an iterator to the first element of the deque.
+    Base::Iterator begin() override
+    {
+        return typename Base::Iterator(Iter<false>(front_, map_ + first_));
+    }
+
+    Base::ConstIterator begin() const override
+    {
+        return typename Base::ConstIterator(Iter<true>(front_, map_ + first_));
+    }
+
+    /// Return an iterator to the element following the last element of the deque.
+    Base::Iterator end() override
+    {
+        return typename Base::Iterator(Iter<false>(front_ + size_, map_ + first_));
+    }
+
+    Base::ConstIterator end() const override
+    {
+        return typename Base::ConstIterator(Iter<true>(front_ + size_, map_ + first_));
+    }
+    /// @}
+
+    /// @name Access
+    /// @{
+
+    /// Return the reference to the element at the specified position in the deque.
+    T& operator[](int index)
+    {
+        detail::check_bounds(index, 0, size_);
+
+        return at(front_ + index);
+    }
+
+    /// Return the const reference to element at the specified position in the deque.
+    const T& operator[](int index) const
+    {
+        return const_cast<BlockDeque&>(*this)[index];
+    }
+
+    /// Return the reference to the element at the front in the deque.
+    T& front() override
+    {
+        detail::check_empty(size_);
+        return at(front_);
+    }
+
+    using Base::front; // const
+
+    /// Return the reference to the element at the back in the deque.
+    T& back() override
+    {
+        detail::check_empty(size_);
+        return at(front_ + size_ - 1);
+    }
+
+    using Base::back; // const
+    /// @}
+
+    /// @name Examination
+    /// @{
+
+    /// Get the number of elements.
+    int size() const override
+    {
+        return size_;
+    }
+    /// @}
+
+    /// @name Manipulation
+    /// @{
+
+    /// Push front, insert an element at the front of the deque.
+    void push_front(const T& element) override
+    {
+        detail::check_full(size_, MAX_CAPACITY);
+
+        // the first block is full at the front, add a block before it
+        if (front_ == 0)
+        {
+            if (first_ == 0)
+            {
+                reserve_map();
+            }
+            map_[--first_] = take_block();
+            blocks_++;
+            front_ = BLOCK_SIZE;
+        }
+
+        at(--front_) = element;
+        size_++;
+    }
+
+    /// Push back, insert an element at the back of the deque.
+    void push_back(const T& element) override
+    {
+        detail::check_full(size_, MAX_CAPACITY);
+
+        // the last block is full at the back, add a block after it
+        if (front_ + size_ == blocks_ * BLOCK_SIZE)
+        {
+            if (first_ + blocks_ == map_capacity_)
+            {
+                reserve_map();
+            }
+            map_[first_ + blocks_] = take_block();
+            blocks_++;
+        }
+
+        at(front_ + size_) = element;
+        size_++;
+    }
+
+    /// Pop front, pop the front element of the deque.
+    T pop_front() override
+    {
+        detail::check_empty(size_);
+
+        T data = std::move(at(front_));
+        front_++;
+        size_--;
+
+        // the first block is drained
+        if (front_ == BLOCK_SIZE && blocks_ > 1)
+        {
+            release_block(map_[first_++]);
+            blocks_--;
+            front_ = 0;
+        }
+        if (size_ == 0)
+        {
+            front_ = BLOCK_SIZE / 2;
+        }
+
+        return data;
+    }
+
+    /// Pop back, pop the back element of the deque.
+    T pop_back() override
+    {
+        detail::check_empty(size_);
+
+        T data = std::move(at(front_ + size_ - 1));
+        size_--;
+
+        // the last block is drained
+        if (front_ + size_ == (blocks_ - 1) * BLOCK_SIZE && blocks_ > 1)
+        {
+            release_block(map_[first_ + --blocks_]);
+        }
+        if (size_ == 0)
+        {
+            front_ = BLOCK_SIZE / 2;
+        }
+
+        return data;
+    }
+
+    /// Remove all of the elements from the deque, keeping one block.
+    void clear() override
+    {
+        // If the elements themselves are pointers, the pointed-to memory is not touched in any way.
+        // Managing the pointer is the user's responsibility.
+        while (blocks_ > 1)
+        {
+            release_block(map_[first_ + --blocks_]);
+        }
+        size_ = 0;
+        front_ = BLOCK_SIZE / 2;
+    }
+
+    /// @}
+};
+
+} // namespace hellods
+
+#endif // BLOCKDEQUE_HPP
@@ -0,0 +1,396 @@
+/**
+ * @file UnrolledDeque.hpp
+ * @author Chen QingYu <chen_qingyu@qq.com>
+ * @brief Deque implemented by unrolled (chunked) linked list.
+ * @date 2026.10.18
+ */
+
+#ifndef UNROLLEDDEQUE_HPP
+#define UNROLLEDDEQUE_HPP
+
+#include "../core.hpp"
+#include "Deque.hpp"
+
+namespace hellods
+{
+
+/// Deque implemented by unrolled (chunked) linked list.
+///
+/// Elements are stored in fixed-size chunks that are doubly linked, so a push allocates once per CHUNK_CAPACITY elements
+/// instead of once per element, and neighbouring elements share cache lines. The first chunk is filled from its back towards the front,
+/// the last chunk from its front towards the back, and the chunks in between are full, so elements never move and references stay valid.
+/// One drained chunk is kept as a spare, so pushing and popping across a chunk boundary does not allocate every time.
+template <typename T>
+class UnrolledDeque : public Deque<T>
+{
+protected:
+    // Number of elements per chunk.
+    static constexpr int CHUNK_CAPACITY = 64;
+
+    // Chunk of unrolled linked list.
+    struct Chunk
+    {
+        // Predecessor.
+        Chunk* pred_;
+
+        // Successor.
+        Chunk* succ_;
+
+        // Elements stored in the chunk.
+        T data_[CHUNK_CAPACITY];
+
+        // Create an unlinked chunk.
+        Chunk()
+            : pred_(nullptr)
+            , succ_(nullptr)
+            , data_()
+        {
+        }
+    };
+
+    template <bool Const>
+    class Iter
+    {
+        friend class UnrolledDeque;
+
+    protected:
+        using Value = std::conditional_t<Const, const T, T>;
+        using ChunkPtr = std::conditional_t<Const, const Chunk*, Chunk*>;
+
+        // Current chunk.
+        ChunkPtr current_;
+
+        // Offset in the current chunk.
+        int offset_;
+
+        // Create an iterator that point to the element at offset of the chunk.
+        Iter(ChunkPtr current, int offset)
+            : current_(current)
+            , offset_(offset)
+        {
+        }
+
+    public:
+        /// Dereference.
+        Value& operator*() const
+        {
+            return current_->data_[offset_];
+        }
+
+        /// Check if two iterators are same.
+        bool operator==(const Iter& that) const
+        {
+            return current_ == that.current_ && offset_ == that.offset_;
+        }
+
+        /// Increment the iterator.
+        Iter& operator++()
+        {
+            // the end of the last chunk stays as the end iterator
+            if (++offset_ == CHUNK_CAPACITY && current_->succ_ != nullptr)
+            {
+                current_ = current_->succ_;
+                offset_ = 0;
+            }
+            return *this;
+        }
+
+        /// Decrement the iterator.
+        Iter& operator--()
+        {
+            if (offset_ == 0)
+            {
+                current_ = current_->pred_;
+                offset_ = CHUNK_CAPACITY;
+            }
+            --offset_;
+            return *this;
+        }
+    };
+
+protected:
+    using Deque<T>::MAX_CAPACITY;
+
+    // Number of elements.
+    int size_;
+
+    // First chunk, never null.
+    Chunk* head_chunk_;
+
+    // Last chunk, the same as the first one if there is only one chunk.
+    Chunk* tail_chunk_;
+
+    // Offset of the front element in the first chunk, less than CHUNK_CAPACITY unless empty.
+    int head_;
+
+    // Offset following the back element in the last chunk, greater than 0 unless there is only one chunk.
+    int tail_;
+
+    // A drained chunk kept for the next allocation, or nullptr.
+    Chunk* spare_;
+
+    // Take the spare chunk, or allocate a new one.
+    Chunk* take_chunk()
+    {
+        return spare_ ? std::exchange(spare_, nullptr) : new Chunk();
+    }
+
+    // Keep the chunk as the spare, or free it if there is one already.
+    void release_chunk(Chunk* chunk)
+    {
+        if (spare_)
+        {
+            delete chunk;
+        }
+        else
+        {
+            chunk->pred_ = chunk->succ_ = nullptr;
+            spare_ = chunk;
+        }
+    }
+
+    // Start over in the middle of the first chunk, so both ends can grow. Require that it is the only chunk.
+    void recenter()
+    {
+        head_ = tail_ = CHUNK_CAPACITY / 2;
+    }
+
+    // Swap with another deque.
+    void swap(UnrolledDeque& that)
+    {
+        std::swap(size_, that.size_);
+        std::swap(head_chunk_, that.head_chunk_);
+        std::swap(tail_chunk_, that.tail_chunk_);
+        std::swap(head_, that.head_);
+        std::swap(tail_, that.tail_);
+        std::swap(spare_, that.spare_);
+    }
+
+public:
+    /// @name Lifecycle
+    /// @{
+
+    /// Create an empty deque.
+    UnrolledDeque()
+        : size_(0)
+        , head_chunk_(new Chunk())
+        , tail_chunk_(head_chunk_)
+        , head_(CHUNK_CAPACITY / 2)
+        , tail_(CHUNK_CAPACITY / 2)
+        , spare_(nullptr)
+    {
+    }
+
+    /// Create a deque based on the given initializer list.
+    UnrolledDeque(const std::initializer_list<T>& il)
+        : UnrolledDeque()
+    {
+        for (auto it = il.begin(); it != il.end(); ++it)
+        {
+            push_back(*it);
+        }
+    }
+
+    /// Copy constructor.
+    UnrolledDeque(const UnrolledDeque& that)
+        : UnrolledDeque()
+    {
+        for (auto it = that.begin(); it != that.end(); ++it)
+        {
+            push_back(*it);
+        }
+    }
+
+    /// Move constructor.
+    UnrolledDeque(UnrolledDeque&& that)
+        : UnrolledDeque()
+    {
+        swap(that);
+    }
+
+    UnrolledDeque& operator=(UnrolledDeque that)
+    {
+        swap(that);
+        return *this;
+    }
+
+    /// Destroy the deque object.
+    ~UnrolledDeque()
+    {
+        while (head_chunk_ != nullptr)
+        {
+            delete std::exchange(head_chunk_, head_chunk_->succ_);
+        }
+        delete spare_;
+    }
+    /// @}
+
+    /// @name Iterator
+    /// @{
+
+    /// Return an iterator to the first element of the deque.
+    Deque<T>::Iterator begin() override
+    {
+        return typename Deque<T>::Iterator(Iter<false>(head_chunk_, head_));
+    }
+
+    Deque<T>::ConstIterator begin() const override
+    {
+        return typename Deque<T>::ConstIterator(Iter<true>(head_chunk_, head_));
+    }
+
+    /// Return an iterator to the element following the last element of the deque.
+    Deque<T>::Iterator end() override
+    {
+        return typename Deque<T>::Iterator(Iter<false>(tail_chunk_, tail_));
+    }
+
+    Deque<T>::ConstIterator end() const override
+    {
+        return typename Deque<T>::ConstIterator(Iter<true>(tail_chunk_, tail_));
+    }
+    /// @}
+
+    /// @name Access
+    /// @{
+
+    /// Return the reference to the element at the front in the deque.
+    T& front() override
+    {
+        detail::check_empty(size_);
+        return head_chunk_->data_[head_];
+    }
+
+    using Deque<T>::front; // const
+
+    /// Return the reference to the element at the back in the deque.
+    T& back() override
+    {
+        detail::check_empty(size_);
+        return tail_chunk_->data_[tail_ - 1];
+    }
+
+    using Deque<T>::back; // const
+    /// @}
+
+    /// @name Examination
+    /// @{
+
+    /// Get the number of elements.
+    int size() const override
+    {
+        return size_;
+    }
+    /// @}
+
+    /// @name Manipulation
+    /// @{
+
+    /// Push front, insert an element at the front of the deque.
+    void push_front(const T& element) override
+    {
+        detail::check_full(size_, MAX_CAPACITY);
+
+        // the first chunk is full at the front, link a chunk before it
+        if (head_ == 0)
+        {
+            Chunk* chunk = take_chunk();
+            chunk->succ_ = head_chunk_;
+            head_chunk_->pred_ = chunk;
+            head_chunk_ = chunk;
+            head_ = CHUNK_CAPACITY;
+        }
+
+        head_chunk_->data_[--head_] = element;
+        size_++;
+    }
+
+    /// Push back, insert an element at the back of the deque.
+    void push_back(const T& element) override
+    {
+        detail::check_full(size_, MAX_CAPACITY);
+
+        // the last chunk is full at the back, link a chunk after it
+        if (tail_ == CHUNK_CAPACITY)
+        {
+            Chunk* chunk = take_chunk();
+            chunk->pred_ = tail_chunk_;
+            tail_chunk_->succ_ = chunk;
+            tail_chunk_ = chunk;
+            tail_ = 0;
+        }
+
+        tail_chunk_->data_[tail_++] = element;
+        size_++;
+    }
+
+    /// Pop front, pop the front element of the deque.
+    T pop_front() override
+    {
+        detail::check_empty(size_);
+
+        T data = std::move(head_chunk_->data_[head_++]);
+        size_--;
+
+        if (size_ == 0)
+        {
+            recenter();
+        }
+        else if (head_ == CHUNK_CAPACITY) // the first chunk is drained
+        {
+            Chunk* chunk = head_chunk_;
+            head_chunk_ = chunk->succ_;
+            head_chunk_->pred_ = nullptr;
+            release_chunk(chunk);
+            head_ = 0;
+        }
+
+        return data;
+    }
+
+    /// Pop back, pop the back element of the deque.
+    T pop_back() override
+    {
+        detail::check_empty(size_);
+
+        T data = std::move(tail_chunk_->data_[--tail_]);
+        size_--;
+
+        if (size_ == 0)
+        {
+            recenter();
+        }
+        else if (tail_ == 0) // the last chunk is drained
+        {
+            Chunk* chunk = tail_chunk_;
+            tail_chunk_ = chunk->pred_;
+            tail_chunk_->succ_ = nullptr;
+            release_chunk(chunk);
+            tail_ = CHUNK_CAPACITY;
+        }
+
+        return data;
+    }
+
+    /// Remove all of the elements from the deque, keeping the first chunk.
+    void clear() override
+    {
+        // If the elements themselves are pointers, the pointed-to memory is not touched in any way.
+        // Managing the pointer is the user's responsibility.
+        while (tail_chunk_ != head_chunk_)
+        {
+            Chunk* chunk = tail_chunk_;
+            tail_chunk_ = chunk->pred_;
+            release_chunk(chunk);
+        }
+        head_chunk_->succ_ = nullptr;
+        size_ = 0;
+        recenter();
+    }
+
+    /// @}
+};
+
+} // namespace hellods
+
+#endif // UNROLLEDDEQUE_HPP
@@ -0,0 +1,352 @@
+/**
+ * @file WorkStealingDeque.hpp
+ * @author Chen QingYu <chen_qingyu@qq.com>
+ * @brief Lock-free work-stealing deque implemented by growable ring buffer (Chase-Lev).
+ * @date 2026.10.18
+ */
+
+#ifndef WORKSTEALINGDEQUE_HPP
+#define WORKSTEALINGDEQUE_HPP
+
+#include "../core.hpp"
+
+namespace hellods
+{
+
+/// Lock-free work-stealing deque implemented by growable ring buffer (Chase-Lev).
+///
+/// One owner thread pushes and pops at the bottom without locks, like push_back() and pop_back() of ArrayDeque,
+/// while any number of thief threads steal from the top with a CAS, like pop_front(). Only the last element is contended.
+/// The memory orderings follow Lê et al., "Correct and Efficient Work-Stealing for Weak Memory Models" (PPoPP 2013).
+///
+/// When the ring buffer is full the owner copies it into one twice as large. A thief may still be reading the old buffer,
+/// so old buffers are retired rather than freed, and released together with the deque. They add up to less than the current buffer.
+///
+/// Elements must be trivially copyable (typically task pointers or handles), since a thief reads an element before it knows it won the race.
+/// Lifecycle operations, comparison, iteration and printing require that no other thread is using the deque.
+template <typename T>
+class WorkStealingDeque : public detail::ConstIterable<T>
+{
+    static_assert(std::is_trivially_copyable_v<T>, "WorkStealingDeque requires trivially copyable elements.");
+
+protected:
+    // Slot of the ring buffer, aligned to be accessed through std::atomic_ref.
+    struct Cell
+    {
+        alignas(std::atomic_ref<T>::required_alignment) T value_;
+    };
+
+    // Ring buffer.
+    struct Array
+    {
+        // Capacity, always a power of two.
+        std::int64_t capacity_;
+
+        // Slots.
+        Cell* data_;
+
+        // Previously retired array, to be released with the deque.
+        Array* retired_;
+
+        // Create an array with the given capacity.
+        Array(std::int64_t capacity, Array* retired = nullptr)
+            : capacity_(capacity)
+            , data_(new Cell[capacity]())
+            , retired_(retired)
+        {
+        }
+
+        ~Array()
+        {
+            delete[] data_;
+        }
+
+        // Return the slot at the given position.
+        Cell& at(std::int64_t pos) const
+        {
+            return data_[pos & (capacity_ - 1)];
+        }
+
+        // Read the element at the given position, may race with a write of the owner that the reader later discards.
+        T load(std::int64_t pos) const
+        {
+            return std::atomic_ref<T>(at(pos).value_).load(std::memory_order_relaxed);
+        }
+
+        // Write the element at the given position.
+        void store(std::int64_t pos, const T& element) const
+        {
+            std::atomic_ref<T>(at(pos).value_).store(element, std::memory_order_relaxed);
+        }
+    };
+
+    template <bool Const>
+    class Iter
+    {
+        friend class WorkStealingDeque;
+
+    protected:
+        using Value = std::conditional_t<Const, const T, T>;
+
+        // Current position.
+        std::int64_t current_;
+
+        // Ring buffer.
+        const Array* array_;
+
+        // Create an iterator that point to the current position of the ring buffer.
+        Iter(std::int64_t current, const Array* array)
+            : current_(current)
+            , array_(array)
+        {
+        }
+
+    public:
+        /// Dereference.
+        Value& operator*() const
+        {
+            return array_->at(current_).value_;
+        }
+
+        /// Check if two iterators are same.
+        bool operator==(const Iter& that) const
+        {
+            return current_ == that.current_;
+        }
+
+        /// Increment the iterator.
+        Iter& operator++()
+        {
+            ++current_;
+            return *this;
+        }
+
+        /// Decrement the iterator.
+        Iter& operator--()
+        {
+            --current_;
+            return *this;
+        }
+    };
+
+protected:
+    using detail::ConstIterable<T>::INIT_CAPACITY;
+    using detail::ConstIterable<T>::MAX_CAPACITY;
+
+    // Position of the top element, advanced by thieves (and by the owner taking the last element).
+    alignas(detail::CACHE_LINE_SIZE) std::atomic<std::int64_t> top_;
+
+    // Position following the bottom element, written by the owner only.
+    alignas(detail::CACHE_LINE_SIZE) std::atomic<std::int64_t> bottom_;
+
+    // Current ring buffer, replaced by the owner only.
+    std::atomic<Array*> array_;
+
+    // Copy the elements into a ring buffer twice as large, publish it and retire the old one. Owner side.
+    Array* grow(Array* array, std::int64_t top, std::int64_t bottom)
+    {
+        detail::check_full(int(bottom - top), MAX_CAPACITY);
+
+        Array* bigger = new Array(array->capacity_ * 2, array);
+        for (std::int64_t pos = top; pos < bottom; ++pos)
+        {
+            bigger->store(pos, array->load(pos));
+        }
+        array_.store(bigger, std::memory_order_release);
+        return bigger;
+    }
+
+    // Swap with another deque.
+    void swap(WorkStealingDeque& that)
+    {
+        top_.store(that.top_.exchange(top_.load()));
+        bottom_.store(that.bottom_.exchange(bottom_.load()));
+        array_.store(that.array_.exchange(array_.load()));
+    }
+
+public:
+    /// @name Lifecycle
+    /// @{
+
+    /// Create an empty deque.
+    WorkStealingDeque()
+        : top_(0)
+        , bottom_(0)
+        , array_(new Array(INIT_CAPACITY))
+    {
+    }
+
+    /// Create a deque based on the given initializer list, from top to bottom.
+    WorkStealingDeque(const std::initializer_list<T>& il)
+        : WorkStealingDeque()
+    {
+        for (auto it = il.begin(); it != il.end(); ++it)
+        {
+            push(*it);
+        }
+    }
+
+    /// Copy constructor.
+    WorkStealingDeque(const WorkStealingDeque& that)
+        : WorkStealingDeque()
+    {
+        for (auto it = that.begin(); it != that.end(); ++it)
+        {
+            push(*it);
+        }
+    }
+
+    /// Move constructor.
+    WorkStealingDeque(WorkStealingDeque&& that)
+        : WorkStealingDeque()
+    {
+        swap(that);
+    }
+
+    WorkStealingDeque& operator=(WorkStealingDeque that)
+    {
+        swap(that);
+        return *this;
+    }
+
+    /// Destroy the deque object, together with the retired ring buffers.
+    ~WorkStealingDeque()
+    {
+        for (Array* array = array_.load(); array != nullptr;)
+        {
+            Array* retired = array->retired_;
+            delete array;
+            array = retired;
+        }
+    }
+
+    /// Return the type name for printing.
+    const char* name() const override
+    {
+        return "Deque";
+    }
+    /// @}
+
+    /// @name Iterator
+    /// @{
+
+    /// Return an iterator to the top element of the deque.
+    detail::ConstIterable<T>::Iterator begin() const override
+    {
+        return typename detail::ConstIterable<T>::Iterator(Iter<true>(top_.load(), array_.load()));
+    }
+
+    /// Return an iterator to the element following the bottom element of the deque.
+    detail::ConstIterable<T>::Iterator end() const override
+    {
+        return typename detail::ConstIterable<T>::Iterator(Iter<true>(top_.load() + size(), array_.load()));
+    }
+    /// @}
+
+    /// @name Examination
+    /// @{
+
+    /// Get the number of elements. A snapshot while other threads are operating.
+    int size() const override
+    {
+        std::int64_t top = top_.load(std::memory_order_acquire);
+        std::int64_t bottom = bottom_.load(std::memory_order_acquire);
+        return int(std::max(bottom - top, std::int64_t(0)));
+    }
+    /// @}
+
+    /// @name Manipulation
+    /// @{
+
+    /// Push an element at the bottom of the deque. Owner side.
+    void push(const T& element)
+    {
+        std::int64_t bottom = bottom_.load(std::memory_order_relaxed);
+        std::int64_t top = top_.load(std::memory_order_acquire);
+        Array* array = array_.load(std::memory_order_relaxed);
+
+        if (bottom - top > array->capacity_ - 1)
+        {
+            array = grow(array, top, bottom);
+        }
+
+        array->store(bottom, element);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    /// Try to pop the bottom element of the deque into the given reference, return false if the deque is empty. Owner side.
+    bool try_pop(T& element)
+    {
+        // reserve the bottom element before looking at the top
+        std::int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        Array* array = array_.load(std::memory_order_relaxed);
+        bottom_.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t top = top_.load(std::memory_order_relaxed);
+
+        // empty
+        if (top > bottom)
+        {
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        // more than one element, no thief can reach the bottom one
+        T popped = array->load(bottom);
+        if (top < bottom)
+        {
+            element = popped;
+            return true;
+        }
+
+        // the last element, race against thieves for it, the value is discarded if a thief wins
+        bool won = top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+        if (won)
+        {
+            element = popped;
+        }
+        return won;
+    }
+
+    /// Try to steal the top element of the deque into the given reference. Thief side, any thread.
+    /// Return false if the deque is empty or another thread took the element first.
+    bool steal(T& element)
+    {
+        std::int64_t top = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t bottom = bottom_.load(std::memory_order_acquire);
+
+        if (top >= bottom)
+        {
+            return false;
+        }
+
+        // read before claiming, the value is discarded if the claim fails
+        T stolen = array_.load(std::memory_order_acquire)->load(top);
+        if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+            return false;
+        }
+
+        element = stolen;
+        return true;
+    }
+
+    /// Remove all of the elements from the deque. Owner side, elements are popped one by one so thieves stay safe.
+    void clear() override
+    {
+        // a trivially copyable element needs no destruction, so raw storage is enough to pop into
+        alignas(T) unsigned char buffer[sizeof(T)];
+        while (try_pop(*reinterpret_cast<T*>(buffer)))
+        {
+        }
+    }
+
+    /// @}
+};
+
+} // namespace hellods
+
+#endif // WORKSTEALINGDEQUE_HPP
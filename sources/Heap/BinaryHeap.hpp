@@ -91,6 +91,12 @@ public:
     {
         return list_.size();
     }
+
+    /// Get the number of elements that the heap can hold before growing.
+    int capacity() const
+    {
+        return list_.capacity();
+    }
     /// @}
 
     /// @name Manipulation
@@ -127,6 +133,19 @@ public:
     {
         list_.clear();
     }
+
+    /// Reduce the capacity to fit the elements, but not below the initial capacity.
+    void shrink_to_fit()
+    {
+        list_.shrink_to_fit();
+    }
+
+    /// Turn automatic shrinking on or off (default off).
+    /// When on, a removal that leaves less than a quarter of the capacity in use shrinks it to about twice the number of elements.
+    void set_auto_shrink(bool enabled)
+    {
+        list_.set_auto_shrink(enabled);
+    }
     /// @}
 
     /// @name Iterator
@@ -33,14 +33,38 @@ protected:
     // Pointer to the data.
     T* data_;
 
-    // Expand capacity safely.
-    void expand_capacity()
+    // Whether to shrink the capacity automatically when elements are removed.
+    bool auto_shrink_;
+
+    // Move the elements into a buffer of the given capacity. Require size <= capacity.
+    void reallocate(int capacity)
     {
-        capacity_ = (capacity_ < MAX_CAPACITY / 2) ? capacity_ * 2 : MAX_CAPACITY; // double the capacity until MAX_CAPACITY
-        T* new_data = new T[capacity_];
-        std::copy(data_, data_ + size_, new_data);
+        T* new_data = new T[capacity];
+        std::move(data_, data_ + size_, new_data);
         delete[] data_;
         data_ = new_data;
+        capacity_ = capacity;
+    }
+
+    // Expand capacity safely, to at least the given capacity.
+    void expand_capacity(int min_capacity)
+    {
+        int capacity = capacity_;
+        while (capacity < min_capacity)
+        {
+            capacity = (capacity < MAX_CAPACITY / 2) ? capacity * 2 : MAX_CAPACITY; // double the capacity until MAX_CAPACITY
+        }
+        reallocate(capacity);
+    }
+
+    // Shrink capacity if auto-shrink is on and less than a quarter is used, leaving the buffer half full.
+    // Growing again takes doubling the size and shrinking again takes halving it, so the two never alternate.
+    void shrink_if_sparse()
+    {
+        if (auto_shrink_ && size_ < capacity_ / 4 && capacity_ > INIT_CAPACITY)
+        {
+            reallocate(std::max(size_ * 2, int(INIT_CAPACITY)));
+        }
     }
 
     // Swap with another list.
@@ -49,6 +73,7 @@ protected:
         std::swap(size_, that.size_);
         std::swap(capacity_, that.capacity_);
         std::swap(data_, that.data_);
+        std::swap(auto_shrink_, that.auto_shrink_);
     }
 
 public:
@@ -60,6 +85,7 @@ public:
         : size_(0)
         , capacity_(INIT_CAPACITY)
         , data_(new T[capacity_])
+        , auto_shrink_(false)
     {
     }
 
@@ -68,6 +94,7 @@ public:
         : size_(size)
         , capacity_(size > INIT_CAPACITY ? size : INIT_CAPACITY)
         , data_(new T[capacity_]())
+        , auto_shrink_(false)
     {
     }
 
@@ -76,6 +103,7 @@ public:
         : size_(int(il.size()))
         , capacity_(size_ > INIT_CAPACITY ? size_ : INIT_CAPACITY)
         , data_(new T[capacity_])
+        , auto_shrink_(false)
     {
         std::copy(il.begin(), il.end(), data_);
     }
@@ -85,6 +113,7 @@ public:
         : size_(that.size_)
         , capacity_(that.capacity_)
         , data_(new T[capacity_])
+        , auto_shrink_(that.auto_shrink_)
     {
         std::copy(that.begin(), that.end(), data_);
     }
@@ -160,6 +189,12 @@ public:
         return size_;
     }
 
+    /// Get the number of elements that the list can hold before growing.
+    int capacity() const
+    {
+        return capacity_;
+    }
+
     /// @}
 
     /// @name Manipulation
@@ -174,7 +209,7 @@ public:
         // expand capacity if need
         if (size_ == capacity_)
         {
-            expand_capacity();
+            expand_capacity(size_ + 1);
         }
 
         // insert and resize
@@ -191,7 +226,7 @@ public:
         // expand capacity if need
         if (size_ == capacity_)
         {
-            expand_capacity();
+            expand_capacity(size_ + 1);
         }
 
         // shift
@@ -219,17 +254,66 @@ public:
 
         // resize
         --size_;
+        shrink_if_sparse();
 
         // return element
         return element;
     }
 
+    /// Append all elements in the range [first, last) to the list, growing the buffer at most once.
+    /// The range must not refer to the elements of this container.
+    template <std::input_iterator InputIt>
+    void append_range(InputIt first, InputIt last)
+    {
+        if constexpr (std::forward_iterator<InputIt>)
+        {
+            // check
+            int count = int(std::distance(first, last));
+            detail::check_full(size_, MAX_CAPACITY - count + 1);
+
+            // expand capacity if need
+            if (size_ + count > capacity_)
+            {
+                expand_capacity(size_ + count);
+            }
+
+            // copy and resize
+            std::copy(first, last, data_ + size_);
+            size_ += count;
+        }
+        else
+        {
+            for (; first != last; ++first)
+            {
+                append(*first);
+            }
+        }
+    }
+
     /// Remove all of the elements from the list.
     void clear() override
     {
         // If the elements themselves are pointers, the pointed-to memory is not touched in any way.
         // Managing the pointer is the user's responsibility.
         size_ = 0;
+        shrink_if_sparse();
+    }
+
+    /// Reduce the capacity to the number of elements, but not below the initial capacity.
+    void shrink_to_fit()
+    {
+        if (capacity_ > std::max(size_, int(INIT_CAPACITY)))
+        {
+            reallocate(std::max(size_, int(INIT_CAPACITY)));
+        }
+    }
+
+    /// Turn automatic shrinking on or off (default off).
+    /// When on, a removal that leaves less than a quarter of the capacity in use shrinks it to twice the number of elements.
+    void set_auto_shrink(bool enabled)
+    {
+        auto_shrink_ = enabled;
+        shrink_if_sparse();
     }
 
     /// @}
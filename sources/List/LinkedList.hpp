@@ -63,6 +63,48 @@ protected:
         return element;
     }
 
+    // Return the node at the given rank (0 <= index <= size), walking from the nearer end.
+    Node* node_at(int index) const
+    {
+        Node* current = nullptr;
+        if (index < size_ / 2)
+        {
+            current = header_->succ_;
+            for (int i = 0; i < index; i++)
+            {
+                current = current->succ_;
+            }
+        }
+        else
+        {
+            current = trailer_; // be careful, index may be same as size
+            for (int i = size_; i > index; i--)
+            {
+                current = current->pred_;
+            }
+        }
+        return current;
+    }
+
+    // Unlink the nodes [first, last] from their list and link them before the given position.
+    static void relink(Node* pos, Node* first, Node* last)
+    {
+        first->pred_->succ_ = last->succ_;
+        last->succ_->pred_ = first->pred_;
+
+        first->pred_ = pos->pred_;
+        last->succ_ = pos;
+        pos->pred_->succ_ = first;
+        pos->pred_ = last;
+    }
+
+    // Reset the cache for operator[]().
+    void reset_cache()
+    {
+        latest_ = -1;
+        p_latest_ = header_;
+    }
+
 protected:
     template <bool Const>
     class Iter
@@ -141,8 +183,7 @@ protected:
         size_ = 0;
         header_->succ_ = trailer_;
         trailer_->pred_ = header_;
-        latest_ = -1;
-        p_latest_ = header_;
+        reset_cache();
     }
 
     // Swap with another list.
@@ -321,31 +362,11 @@ public:
         detail::check_full(size_, MAX_CAPACITY);
         detail::check_bounds(index, 0, size_ + 1);
 
-        // index
-        Node* current = nullptr;
-        if (index < size_ / 2)
-        {
-            current = header_->succ_;
-            for (int i = 0; i < index; i++)
-            {
-                current = current->succ_;
-            }
-        }
-        else
-        {
-            current = trailer_; // be careful, index may be same as size
-            for (int i = size_; i > index; i--)
-            {
-                current = current->pred_;
-            }
-        }
-
         // insert
-        insert_node(current, element);
+        insert_node(node_at(index), element);
 
         // reset cache
-        latest_ = -1;
-        p_latest_ = header_;
+        reset_cache();
     }
 
     /// Remove and return the element at the specified position in the list.
@@ -356,30 +377,119 @@ public:
         detail::check_bounds(index, 0, size_);
 
         // index
-        Node* current = nullptr;
-        if (index < size_ / 2)
+        Node* current = node_at(index);
+
+        // reset cache
+        reset_cache();
+
+        // remove and return data
+        return remove_node(current);
+    }
+
+    /// Move the elements [first, last) of that list before the specified position in this list.
+    /// The nodes are relinked rather than copied, so apart from locating the positions it takes O(1).
+    /// Within the same list, the position must not lie strictly inside the moved range.
+    void splice(int index, LinkedList& that, int first, int last)
+    {
+        // check
+        detail::check_bounds(index, 0, size_ + 1);
+        detail::check_bounds(first, 0, that.size_ + 1);
+        detail::check_bounds(last, first, that.size_ + 1);
+        if (this == &that && index > first && index < last)
         {
-            current = header_->succ_;
-            for (int i = 0; i < index; i++)
+            throw std::runtime_error("Error: Index out of range.");
+        }
+        if (first == last || (this == &that && (index == first || index == last)))
+        {
+            return;
+        }
+        if (this != &that)
+        {
+            detail::check_full(size_, MAX_CAPACITY - (last - first) + 1);
+        }
+
+        // relink
+        relink(node_at(index), that.node_at(first), that.node_at(last - 1));
+
+        // resize
+        if (this != &that)
+        {
+            size_ += last - first;
+            that.size_ -= last - first;
+        }
+
+        // reset cache
+        reset_cache();
+        that.reset_cache();
+    }
+
+    /// Move all elements of that list to the end of this list in O(1), leaving that list empty.
+    void concat(LinkedList& that)
+    {
+        if (this == &that)
+        {
+            LinkedList copy(that);
+            concat(copy);
+            return;
+        }
+
+        splice(size_, that, 0, that.size_);
+    }
+
+    /// Split the list at the specified position, locating it from the nearer end and relinking in O(1).
+    /// This list keeps the elements before index, and the elements from index on are returned as a new list.
+    LinkedList split_at(int index)
+    {
+        detail::check_bounds(index, 0, size_ + 1);
+
+        LinkedList tail;
+        tail.splice(0, *this, index, size_);
+        return tail;
+    }
+
+    /// Merge that sorted list into this sorted list in O(n + m) by relinking nodes, leaving that list empty.
+    /// The merge is stable: of equal elements, those from this list come first.
+    void merge(LinkedList& that)
+    {
+        // check
+        if (this == &that)
+        {
+            return;
+        }
+        detail::check_full(size_, MAX_CAPACITY - that.size_ + 1);
+
+        // move each run of that list which goes before the current node of this list
+        Node* current = header_->succ_;
+        while (that.header_->succ_ != that.trailer_)
+        {
+            Node* first = that.header_->succ_;
+            while (current != trailer_ && !(first->data_ < current->data_))
             {
                 current = current->succ_;
             }
-        }
-        else
-        {
-            current = trailer_->pred_;
-            for (int i = size_ - 1; i > index; i--)
+
+            Node* last = first;
+            if (current == trailer_)
             {
-                current = current->pred_;
+                last = that.trailer_->pred_;
+            }
+            else
+            {
+                while (last->succ_ != that.trailer_ && last->succ_->data_ < current->data_)
+                {
+                    last = last->succ_;
+                }
             }
+            relink(current, first, last);
         }
 
-        // reset cache
-        latest_ = -1;
-        p_latest_ = header_;
+        // resize
+        size_ += that.size_;
+        that.size_ = 0;
 
-        // remove and return data
-        return remove_node(current);
+        // reset cache
+        reset_cache();
+        that.reset_cache();
     }
 
     /// Remove all of the elements from the list.
@@ -0,0 +1,488 @@
+/**
+ * @file MappedArrayList.hpp
+ * @author Chen QingYu <chen_qingyu@qq.com>
+ * @brief List implemented by array in a memory-mapped file.
+ * @date 2026.10.18
+ */
+
+#ifndef MAPPEDARRAYLIST_HPP
+#define MAPPEDARRAYLIST_HPP
+
+#include "List.hpp"
+
+#include <cstdint> // std::uint64_t std::int64_t
+#include <cstring> // std::memcpy
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>    // open
+#include <sys/mman.h> // mmap munmap msync madvise
+#include <sys/stat.h> // fstat
+#include <unistd.h>   // close ftruncate
+#else
+#include <fstream> // std::ifstream std::ofstream
+#endif
+
+namespace hellods
+{
+
+/// List implemented by array in a memory-mapped file.
+///
+/// The buffer of a list opened with a path lives in that file: a small header records the element size and the number of elements,
+/// followed by the raw elements. Reopening an existing file maps it back without parsing, and the OS page cache decides which pages stay in memory.
+/// The file grows by extending and remapping it in large increments, so a long run of appends remaps rarely.
+/// Changes reach the file at the discretion of the OS, call flush() to write them through synchronously.
+///
+/// A list created without a path (default, copied, etc.) is backed by anonymous memory and behaves like ArrayList.
+/// On platforms without mmap the buffer is kept on the heap, the file is read on open and written by flush() and on destruction.
+template <typename T>
+class MappedArrayList : public List<T, std::contiguous_iterator_tag>
+{
+    static_assert(std::is_trivially_copyable_v<T>, "MappedArrayList requires trivially copyable elements.");
+    static_assert(alignof(T) <= detail::CACHE_LINE_SIZE, "MappedArrayList requires elements aligned within a cache line.");
+
+protected:
+    using Base = List<T, std::contiguous_iterator_tag>;
+    using Base::MAX_CAPACITY;
+
+    // Header at the beginning of the mapping.
+    struct Header
+    {
+        // Magic number to recognize the file.
+        std::uint64_t magic_;
+
+        // Size of an element in bytes, to reject reopening with another element type.
+        std::uint64_t element_size_;
+
+        // Number of elements.
+        std::int64_t size_;
+    };
+
+    // "HelloDS" + format version.
+    static constexpr std::uint64_t MAGIC = 0x48656C6C6F445301;
+
+    // Bytes reserved for the header, elements start on a cache line boundary.
+    static constexpr std::size_t HEADER_BYTES = detail::CACHE_LINE_SIZE;
+
+    // Minimum growth of the mapping in bytes.
+    static constexpr std::size_t GROW_BYTES = std::size_t(1) << 20;
+
+    // Path of the backing file, empty for anonymous memory.
+    std::string path_;
+
+#if defined(__unix__) || defined(__APPLE__)
+    // File descriptor of the backing file, -1 for anonymous memory.
+    int fd_;
+#endif
+
+    // Pointer to the mapping.
+    char* base_;
+
+    // Size of the mapping in bytes.
+    std::size_t bytes_;
+
+    // Available capacity.
+    int capacity_;
+
+    // Header of the mapping.
+    Header* header() const
+    {
+        return reinterpret_cast<Header*>(base_);
+    }
+
+    // Pointer to the data.
+    T* data() const
+    {
+        return reinterpret_cast<T*>(base_ + HEADER_BYTES);
+    }
+
+    // Map a region of the given size, the file (if any) is extended to cover it.
+    void map(std::size_t bytes)
+    {
+#if defined(__unix__) || defined(__APPLE__)
+        void* base;
+        if (fd_ >= 0)
+        {
+            struct stat st;
+            if (::fstat(fd_, &st) != 0 || (std::size_t(st.st_size) < bytes && ::ftruncate(fd_, off_t(bytes)) != 0))
+            {
+                throw std::runtime_error("Error: Failed to extend the mapped file.");
+            }
+            base = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        }
+        else
+        {
+            base = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        }
+        if (base == MAP_FAILED)
+        {
+            throw std::runtime_error("Error: Failed to map memory.");
+        }
+        ::madvise(base, bytes, MADV_SEQUENTIAL); // only a hint, failure is harmless
+        base_ = static_cast<char*>(base);
+#else
+        base_ = new char[bytes]();
+#endif
+        bytes_ = bytes;
+        capacity_ = int(std::min((bytes - HEADER_BYTES) / sizeof(T), std::size_t(MAX_CAPACITY)));
+    }
+
+    // Unmap a region returned by map().
+    static void unmap(char* base, std::size_t bytes)
+    {
+#if defined(__unix__) || defined(__APPLE__)
+        ::munmap(base, bytes);
+#else
+        (void)bytes;
+        delete[] base;
+#endif
+    }
+
+    // Whether the mapping is shared with the backing file, so that a new mapping of the file already holds the elements.
+    bool shared() const
+    {
+#if defined(__unix__) || defined(__APPLE__)
+        return fd_ >= 0;
+#else
+        return false;
+#endif
+    }
+
+    // Expand capacity safely.
+    void expand_capacity()
+    {
+        char* old_base = base_;
+        std::size_t old_bytes = bytes_;
+
+        // double the mapping, by at least GROW_BYTES
+        map(std::max(old_bytes * 2, old_bytes + GROW_BYTES));
+        if (!shared())
+        {
+            std::memcpy(base_, old_base, HEADER_BYTES + std::size_t(reinterpret_cast<Header*>(old_base)->size_) * sizeof(T));
+        }
+        unmap(old_base, old_bytes);
+    }
+
+    // Swap with another list.
+    void swap(MappedArrayList& that)
+    {
+        std::swap(path_, that.path_);
+#if defined(__unix__) || defined(__APPLE__)
+        std::swap(fd_, that.fd_);
+#endif
+        std::swap(base_, that.base_);
+        std::swap(bytes_, that.bytes_);
+        std::swap(capacity_, that.capacity_);
+    }
+
+public:
+    /// @name Lifecycle
+    /// @{
+
+    /// Create an empty list backed by anonymous memory.
+    MappedArrayList()
+        : path_()
+#if defined(__unix__) || defined(__APPLE__)
+        , fd_(-1)
+#endif
+        , base_(nullptr)
+        , bytes_(0)
+        , capacity_(0)
+    {
+        map(GROW_BYTES);
+        *header() = {MAGIC, sizeof(T), 0};
+    }
+
+    /// Open the list stored in the file at the given path, or create an empty one if the file does not exist or is empty.
+    explicit MappedArrayList(const std::string& path)
+        : path_(path)
+#if defined(__unix__) || defined(__APPLE__)
+        , fd_(::open(path.c_str(), O_RDWR | O_CREAT, 0644))
+#endif
+        , base_(nullptr)
+        , bytes_(0)
+        , capacity_(0)
+    {
+        // close the file if the list cannot be opened, the destructor does not run for a throwing constructor
+        try
+        {
+            // find the size of the existing file
+            std::size_t bytes = 0;
+#if defined(__unix__) || defined(__APPLE__)
+            struct stat st;
+            if (fd_ < 0 || ::fstat(fd_, &st) != 0)
+            {
+                throw std::runtime_error("Error: Failed to open the mapped file.");
+            }
+            bytes = std::size_t(st.st_size);
+#else
+            std::ifstream file(path, std::ios::binary | std::ios::ate);
+            if (file)
+            {
+                bytes = std::size_t(file.tellg());
+                file.seekg(0);
+            }
+#endif
+
+            // create, or validate and map
+            if (bytes == 0)
+            {
+                map(GROW_BYTES);
+                *header() = {MAGIC, sizeof(T), 0};
+            }
+            else
+            {
+                // reject a truncated file before mapping, so that a failed open never extends it
+                if (bytes < HEADER_BYTES)
+                {
+                    throw std::runtime_error("Error: The file does not hold a list of this element type.");
+                }
+                map(bytes);
+#if !(defined(__unix__) || defined(__APPLE__))
+                file.read(base_, std::streamsize(bytes));
+#endif
+                if (header()->magic_ != MAGIC || header()->element_size_ != sizeof(T) || header()->size_ < 0 || header()->size_ > capacity_)
+                {
+                    unmap(base_, bytes_);
+                    throw std::runtime_error("Error: The file does not hold a list of this element type.");
+                }
+            }
+        }
+        catch (...)
+        {
+#if defined(__unix__) || defined(__APPLE__)
+            if (fd_ >= 0)
+            {
+                ::close(fd_);
+            }
+#endif
+            throw;
+        }
+    }
+
+    /// Create a list with the specified number of value-initialized elements.
+    explicit MappedArrayList(int size)
+        : MappedArrayList()
+    {
+        for (int i = 0; i < size; ++i)
+        {
+            append(T());
+        }
+    }
+
+    /// Create a list based on the given initializer list.
+    MappedArrayList(const std::initializer_list<T>& il)
+        : MappedArrayList()
+    {
+        for (auto it = il.begin(); it != il.end(); ++it)
+        {
+            append(*it);
+        }
+    }
+
+    /// Copy constructor. The copy is backed by anonymous memory.
+    MappedArrayList(const MappedArrayList& that)
+        : MappedArrayList()
+    {
+        *this = that;
+    }
+
+    /// Move constructor.
+    MappedArrayList(MappedArrayList&& that)
+        : MappedArrayList()
+    {
+        swap(that);
+    }
+
+    /// Copy assignment. The elements are copied into the storage of this list, so a file-backed list stays file-backed.
+    MappedArrayList& operator=(const MappedArrayList& that)
+    {
+        if (this != &that)
+        {
+            while (capacity_ < that.size())
+            {
+                expand_capacity();
+            }
+            std::memcpy(data(), that.data(), std::size_t(that.size()) * sizeof(T));
+            header()->size_ = that.size();
+        }
+        return *this;
+    }
+
+    /// Move assignment. This list takes over the storage of that list, file-backed or not.
+    MappedArrayList& operator=(MappedArrayList&& that)
+    {
+        swap(that);
+        return *this;
+    }
+
+    /// Destroy the list object. Pending changes of a file-backed list are left to the OS to write back.
+    ~MappedArrayList()
+    {
+#if defined(__unix__) || defined(__APPLE__)
+        unmap(base_, bytes_);
+        if (fd_ >= 0)
+        {
+            ::close(fd_);
+        }
+#else
+        flush();
+        unmap(base_, bytes_);
+#endif
+    }
+
+    /// @}
+
+    /// @name Access
+    /// @{
+
+    /// Return the reference to the element at the specified position in the list.
+    T& operator[](int index) override
+    {
+        detail::check_bounds(index, 0, size());
+        return data()[index];
+    }
+
+    using Base::operator[]; // const
+
+    /// @}
+
+    /// @name Iterator
+    /// @{
+
+    /// Return an iterator to the first element of the list.
+    Base::Iterator begin() override
+    {
+        return typename Base::Iterator(data());
+    }
+
+    Base::ConstIterator begin() const override
+    {
+        return typename Base::ConstIterator(data());
+    }
+
+    /// Return an iterator to the element following the last element of the list.
+    Base::Iterator end() override
+    {
+        return typename Base::Iterator(data() + size());
+    }
+
+    Base::ConstIterator end() const override
+    {
+        return typename Base::ConstIterator(data() + size());
+    }
+
+    /// @}
+
+    /// @name Examination
+    /// @{
+
+    /// Get the number of elements.
+    int size() const override
+    {
+        return int(header()->size_);
+    }
+
+    /// Get the path of the backing file, or an empty string for anonymous memory.
+    const std::string& path() const
+    {
+        return path_;
+    }
+
+    /// @}
+
+    /// @name Manipulation
+    /// @{
+
+    /// Append the specified element to the list.
+    void append(const T& element) override
+    {
+        // check
+        detail::check_full(size(), MAX_CAPACITY);
+
+        // expand capacity if need
+        if (size() == capacity_)
+        {
+            expand_capacity();
+        }
+
+        // insert and resize
+        data()[header()->size_++] = element;
+    }
+
+    /// Insert the specified element at the specified position in the list.
+    void insert(int index, const T& element) override
+    {
+        // check
+        detail::check_full(size(), MAX_CAPACITY);
+        detail::check_bounds(index, 0, size() + 1);
+
+        // expand capacity if need
+        if (size() == capacity_)
+        {
+            expand_capacity();
+        }
+
+        // shift
+        std::copy_backward(data() + index, data() + size(), data() + size() + 1);
+
+        // insert
+        data()[index] = element;
+
+        // resize
+        ++header()->size_;
+    }
+
+    /// Remove and return the element at the specified position in the list.
+    T remove(int index) override
+    {
+        // check
+        detail::check_empty(size());
+        detail::check_bounds(index, 0, size());
+
+        // copy element
+        T element = data()[index];
+
+        // shift
+        std::copy(data() + index + 1, data() + size(), data() + index);
+
+        // resize
+        --header()->size_;
+
+        // return element
+        return element;
+    }
+
+    /// Remove all of the elements from the list. The file keeps its size.
+    void clear() override
+    {
+        header()->size_ = 0;
+    }
+
+    /// Write the header and elements through to the backing file, return after the data has reached it.
+    /// Does nothing for anonymous memory.
+    void flush() const
+    {
+        if (path_.empty())
+        {
+            return;
+        }
+#if defined(__unix__) || defined(__APPLE__)
+        if (::msync(base_, HEADER_BYTES + std::size_t(size()) * sizeof(T), MS_SYNC) != 0)
+        {
+            throw std::runtime_error("Error: Failed to flush the mapped file.");
+        }
+#else
+        std::ofstream file(path_, std::ios::binary);
+        if (!file.write(base_, std::streamsize(HEADER_BYTES + std::size_t(size()) * sizeof(T))).flush())
+        {
+            throw std::runtime_error("Error: Failed to flush the mapped file.");
+        }
+#endif
+    }
+
+    /// @}
+};
+
+} // namespace hellods
+
+#endif // MAPPEDARRAYLIST_HPP
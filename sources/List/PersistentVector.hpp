@@ -0,0 +1,618 @@
+/**
+ * @file PersistentVector.hpp
+ * @author Chen QingYu <chen_qingyu@qq.com>
+ * @brief Persistent vector implemented by 32-way radix-balanced trie.
+ * @date 2026.10.18
+ */
+
+#ifndef PERSISTENTVECTOR_HPP
+#define PERSISTENTVECTOR_HPP
+
+#include "../core.hpp"
+
+namespace hellods
+{
+
+/// Persistent vector implemented by 32-way radix-balanced trie with a tail buffer.
+///
+/// Elements live in 32-element leaves under a trie indexed by the bits of the position, and the last
+/// (partial) leaf is kept aside as the tail. Nodes are shared between copies through atomic reference
+/// counts, so copying a vector is O(1). Updates copy only the shared nodes on the root-to-leaf path,
+/// so append, set and pop are O(log32 n) and never disturb other copies.
+///
+/// A copy is a consistent snapshot: different threads may freely read their own copies while
+/// another thread keeps updating the original. A single object itself is not thread-safe.
+template <typename T>
+class PersistentVector : public detail::ConstIterable<T, std::random_access_iterator_tag>
+{
+protected:
+    using Base = detail::ConstIterable<T, std::random_access_iterator_tag>;
+    using Base::MAX_CAPACITY;
+
+    // Number of index bits consumed per trie level.
+    static constexpr int BITS = 5;
+
+    // Number of children per branch and elements per leaf.
+    static constexpr int WIDTH = 1 << BITS;
+
+    // Mask of the index bits of one level.
+    static constexpr int MASK = WIDTH - 1;
+
+    // Common part of trie nodes.
+    struct Node
+    {
+        // Number of vectors and branches that refer to this node.
+        std::atomic<int> refs_;
+
+        Node()
+            : refs_(1)
+        {
+        }
+    };
+
+    // Inner node of the trie.
+    struct Branch : Node
+    {
+        // Children, either all branches or all leaves depending on the level.
+        Node* child_[WIDTH];
+
+        // Create an empty branch.
+        Branch()
+            : child_()
+        {
+        }
+
+        // Create a branch sharing the children of that branch.
+        Branch(const Branch& that)
+        {
+            for (int i = 0; i < WIDTH; ++i)
+            {
+                child_[i] = that.child_[i];
+                if (child_[i] != nullptr)
+                {
+                    child_[i]->refs_.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        }
+    };
+
+    // Leaf node of the trie, a chunk of contiguous elements.
+    struct Leaf : Node
+    {
+        // Elements stored in the leaf.
+        T data_[WIDTH];
+
+        // Create an empty leaf.
+        Leaf()
+            : data_()
+        {
+        }
+
+        // Create a leaf with a copy of the elements of that leaf.
+        Leaf(const Leaf& that)
+        {
+            std::copy(that.data_, that.data_ + WIDTH, data_);
+        }
+    };
+
+    // Number of elements.
+    int size_;
+
+    // Level of the root, in bits (the children of a branch at level BITS are leaves).
+    int shift_;
+
+    // Pointer to the root of the trie, nullptr if all elements fit in the tail.
+    Branch* root_;
+
+    // Pointer to the tail leaf, nullptr if empty.
+    Leaf* tail_;
+
+    // Drop a reference to the node at the given level, destroy it if it was the last one.
+    static void release(Node* node, int level)
+    {
+        if (node == nullptr || node->refs_.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        {
+            return;
+        }
+
+        if (level == 0)
+        {
+            delete static_cast<Leaf*>(node);
+        }
+        else
+        {
+            Branch* branch = static_cast<Branch*>(node);
+            for (int i = 0; i < WIDTH; ++i)
+            {
+                release(branch->child_[i], level - BITS);
+            }
+            delete branch;
+        }
+    }
+
+    // Return a branch that is owned only by the caller: itself if not shared, otherwise a copy of it.
+    // The caller's reference to the original branch is consumed.
+    static Branch* unique(Branch* branch, int level)
+    {
+        if (branch->refs_.load(std::memory_order_acquire) == 1)
+        {
+            return branch;
+        }
+
+        Branch* copy = new Branch(*branch);
+        release(branch, level);
+        return copy;
+    }
+
+    // Return a leaf that is owned only by the caller: itself if not shared, otherwise a copy of it.
+    // The caller's reference to the original leaf is consumed.
+    static Leaf* unique(Leaf* leaf)
+    {
+        if (leaf->refs_.load(std::memory_order_acquire) == 1)
+        {
+            return leaf;
+        }
+
+        Leaf* copy = new Leaf(*leaf);
+        release(leaf, 0);
+        return copy;
+    }
+
+    // Index of the first element in the tail.
+    int tail_offset() const
+    {
+        return size_ < WIDTH ? 0 : ((size_ - 1) >> BITS) << BITS;
+    }
+
+    // Return the leaf holding the element at the given index.
+    const Leaf* leaf_for(int index) const
+    {
+        if (index >= tail_offset())
+        {
+            return tail_;
+        }
+
+        const Node* node = root_;
+        for (int level = shift_; level > 0; level -= BITS)
+        {
+            node = static_cast<const Branch*>(node)->child_[(index >> level) & MASK];
+        }
+        return static_cast<const Leaf*>(node);
+    }
+
+    // Create a path of single-child branches from the given level down to the leaf.
+    static Node* new_path(int level, Leaf* leaf)
+    {
+        if (level == 0)
+        {
+            return leaf;
+        }
+
+        Branch* branch = new Branch();
+        branch->child_[0] = new_path(level - BITS, leaf);
+        return branch;
+    }
+
+    // Put the full tail leaf into the subtree at the given level, copying shared nodes on the path.
+    Branch* push_leaf(int level, Branch* parent, Leaf* leaf)
+    {
+        Branch* branch = unique(parent, level);
+        Node*& child = branch->child_[((size_ - 1) >> level) & MASK];
+
+        if (level == BITS)
+        {
+            child = leaf;
+        }
+        else
+        {
+            child = child != nullptr ? push_leaf(level - BITS, static_cast<Branch*>(child), leaf) : new_path(level - BITS, leaf);
+        }
+
+        return branch;
+    }
+
+    // Remove the last leaf from the subtree at the given level, copying shared nodes on the path.
+    // Return nullptr if the subtree becomes empty.
+    Branch* pop_leaf(int level, Branch* parent)
+    {
+        int sub = ((size_ - 2) >> level) & MASK;
+
+        if (level > BITS)
+        {
+            Branch* branch = unique(parent, level);
+            Branch* child = pop_leaf(level - BITS, static_cast<Branch*>(branch->child_[sub]));
+            branch->child_[sub] = child;
+            if (child == nullptr && sub == 0)
+            {
+                release(branch, level);
+                return nullptr;
+            }
+            return branch;
+        }
+
+        if (sub == 0)
+        {
+            release(parent, level);
+            return nullptr;
+        }
+
+        Branch* branch = unique(parent, level);
+        release(branch->child_[sub], 0);
+        branch->child_[sub] = nullptr;
+        return branch;
+    }
+
+    // Swap with another vector.
+    void swap(PersistentVector& that)
+    {
+        std::swap(size_, that.size_);
+        std::swap(shift_, that.shift_);
+        std::swap(root_, that.root_);
+        std::swap(tail_, that.tail_);
+    }
+
+protected:
+    class Iter
+    {
+        friend class PersistentVector;
+
+    protected:
+        // Vector being iterated.
+        const PersistentVector* vector_;
+
+        // Index of the current element.
+        int index_;
+
+        // Leaf holding the current element, nullptr if out of range.
+        const Leaf* leaf_;
+
+        // Create an iterator that point to the element at index of the vector.
+        Iter(const PersistentVector* vector, int index)
+            : vector_(vector)
+            , index_(index)
+            , leaf_(nullptr)
+        {
+            load();
+        }
+
+        // Look up the leaf of the current index.
+        void load()
+        {
+            leaf_ = (index_ >= 0 && index_ < vector_->size_) ? vector_->leaf_for(index_) : nullptr;
+        }
+
+    public:
+        /// Dereference.
+        const T& operator*() const
+        {
+            return leaf_->data_[index_ & MASK];
+        }
+
+        /// Check if two iterators are same.
+        bool operator==(const Iter& that) const
+        {
+            return index_ == that.index_;
+        }
+
+        /// Increment the iterator, the leaf is looked up only when crossing into the next chunk.
+        Iter& operator++()
+        {
+            if ((++index_ & MASK) == 0)
+            {
+                load();
+            }
+            return *this;
+        }
+
+        /// Decrement the iterator, the leaf is looked up only when crossing into the previous chunk or leaving end.
+        Iter& operator--()
+        {
+            if ((index_-- & MASK) == 0 || leaf_ == nullptr)
+            {
+                load();
+            }
+            return *this;
+        }
+
+        /// Advance by n elements.
+        Iter& operator+=(std::ptrdiff_t n)
+        {
+            index_ += int(n);
+            load();
+            return *this;
+        }
+
+        /// Return a copy advanced by n elements.
+        Iter operator+(std::ptrdiff_t n) const
+        {
+            auto tmp = *this;
+            tmp += n;
+            return tmp;
+        }
+
+        /// Retreat by n elements.
+        Iter& operator-=(std::ptrdiff_t n)
+        {
+            return *this += -n;
+        }
+
+        /// Return a copy retreated by n elements.
+        Iter operator-(std::ptrdiff_t n) const
+        {
+            auto tmp = *this;
+            tmp -= n;
+            return tmp;
+        }
+
+        /// Signed distance (number of elements) between two iterators.
+        std::ptrdiff_t operator-(const Iter& that) const
+        {
+            return index_ - that.index_;
+        }
+
+        /// Access the element at offset n without advancing.
+        const T& operator[](std::ptrdiff_t n) const
+        {
+            return *(*this + n);
+        }
+
+        /// Ordering comparisons.
+        bool operator<(const Iter& that) const
+        {
+            return index_ < that.index_;
+        }
+
+        bool operator<=(const Iter& that) const
+        {
+            return index_ <= that.index_;
+        }
+
+        bool operator>(const Iter& that) const
+        {
+            return index_ > that.index_;
+        }
+
+        bool operator>=(const Iter& that) const
+        {
+            return index_ >= that.index_;
+        }
+    };
+
+public:
+    /// @name Lifecycle
+    /// @{
+
+    /// Create an empty vector.
+    PersistentVector()
+        : size_(0)
+        , shift_(BITS)
+        , root_(nullptr)
+        , tail_(nullptr)
+    {
+    }
+
+    /// Create a vector based on the given initializer list.
+    PersistentVector(const std::initializer_list<T>& il)
+        : PersistentVector()
+    {
+        for (auto it = il.begin(); it != il.end(); ++it)
+        {
+            append(*it);
+        }
+    }
+
+    /// Copy constructor. O(1), the copy shares all nodes with that vector.
+    PersistentVector(const PersistentVector& that)
+        : size_(that.size_)
+        , shift_(that.shift_)
+        , root_(that.root_)
+        , tail_(that.tail_)
+    {
+        if (root_ != nullptr)
+        {
+            root_->refs_.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (tail_ != nullptr)
+        {
+            tail_->refs_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /// Move constructor.
+    PersistentVector(PersistentVector&& that)
+        : PersistentVector()
+    {
+        swap(that);
+    }
+
+    PersistentVector& operator=(PersistentVector that)
+    {
+        swap(that);
+        return *this;
+    }
+
+    /// Destroy the vector object.
+    ~PersistentVector()
+    {
+        release(root_, shift_);
+        release(tail_, 0);
+    }
+
+    /// Return the type name for printing.
+    const char* name() const override
+    {
+        return "List";
+    }
+    /// @}
+
+    /// @name Access
+    /// @{
+
+    /// Return the const reference to the element at the specified position in the vector.
+    const T& operator[](int index) const
+    {
+        detail::check_bounds(index, 0, size_);
+        return leaf_for(index)->data_[index & MASK];
+    }
+    /// @}
+
+    /// @name Iterator
+    /// @{
+
+    /// Return an iterator to the first element of the vector.
+    Base::Iterator begin() const override
+    {
+        return typename Base::Iterator(Iter(this, 0));
+    }
+
+    /// Return an iterator to the element following the last element of the vector.
+    Base::Iterator end() const override
+    {
+        return typename Base::Iterator(Iter(this, size_));
+    }
+
+    /// Call action on each chunk of contiguous elements in order, with the pointer to the first element and the chunk length.
+    void for_each_chunk(const std::function<void(const T*, int)>& action) const
+    {
+        for (int offset = 0; offset < size_; offset += WIDTH)
+        {
+            action(leaf_for(offset)->data_, std::min(WIDTH, size_ - offset));
+        }
+    }
+    /// @}
+
+    /// @name Examination
+    /// @{
+
+    /// Get the number of elements.
+    int size() const override
+    {
+        return size_;
+    }
+    /// @}
+
+    /// @name Manipulation
+    /// @{
+
+    /// Append the specified element to the vector.
+    void append(const T& element)
+    {
+        detail::check_full(size_, MAX_CAPACITY);
+
+        if (tail_ == nullptr)
+        {
+            tail_ = new Leaf();
+        }
+        else if (size_ - tail_offset() == WIDTH) // tail is full, push it into the trie
+        {
+            if (root_ == nullptr)
+            {
+                root_ = new Branch();
+                root_->child_[0] = tail_;
+            }
+            else if ((size_ >> BITS) > (1 << shift_)) // root is full, grow a level
+            {
+                Branch* root = new Branch();
+                root->child_[0] = root_;
+                root->child_[1] = new_path(shift_, tail_);
+                root_ = root;
+                shift_ += BITS;
+            }
+            else
+            {
+                root_ = push_leaf(shift_, root_, tail_);
+            }
+            tail_ = new Leaf();
+        }
+        else
+        {
+            tail_ = unique(tail_);
+        }
+
+        tail_->data_[size_ & MASK] = element;
+        ++size_;
+    }
+
+    /// Replace the element at the specified position in the vector.
+    void set(int index, const T& element)
+    {
+        detail::check_bounds(index, 0, size_);
+
+        if (index >= tail_offset())
+        {
+            tail_ = unique(tail_);
+            tail_->data_[index & MASK] = element;
+            return;
+        }
+
+        root_ = unique(root_, shift_);
+        Branch* branch = root_;
+        for (int level = shift_; level > BITS; level -= BITS)
+        {
+            Node*& child = branch->child_[(index >> level) & MASK];
+            child = unique(static_cast<Branch*>(child), level - BITS);
+            branch = static_cast<Branch*>(child);
+        }
+
+        Node*& leaf = branch->child_[(index >> BITS) & MASK];
+        leaf = unique(static_cast<Leaf*>(leaf));
+        static_cast<Leaf*>(leaf)->data_[index & MASK] = element;
+    }
+
+    /// Remove and return the last element in the vector.
+    T pop()
+    {
+        detail::check_empty(size_);
+
+        int last = (size_ - 1) & MASK;
+        T element = tail_->refs_.load(std::memory_order_acquire) == 1 ? std::move(tail_->data_[last]) : tail_->data_[last];
+
+        if (size_ == 1)
+        {
+            release(tail_, 0);
+            tail_ = nullptr;
+        }
+        else if (last == 0) // tail becomes empty, the last leaf of the trie becomes the new tail
+        {
+            Leaf* tail = const_cast<Leaf*>(leaf_for(size_ - 2));
+            tail->refs_.fetch_add(1, std::memory_order_relaxed);
+
+            root_ = pop_leaf(shift_, root_);
+            if (root_ == nullptr)
+            {
+                shift_ = BITS;
+            }
+            else if (shift_ > BITS && root_->child_[1] == nullptr) // root has a single child, drop a level
+            {
+                Branch* root = root_;
+                root_ = static_cast<Branch*>(root->child_[0]);
+                root_->refs_.fetch_add(1, std::memory_order_relaxed);
+                release(root, shift_);
+                shift_ -= BITS;
+            }
+
+            release(tail_, 0);
+            tail_ = tail;
+        }
+
+        --size_;
+        return element;
+    }
+
+    /// Remove all of the elements from the vector.
+    void clear() override
+    {
+        release(root_, shift_);
+        release(tail_, 0);
+        size_ = 0;
+        shift_ = BITS;
+        root_ = nullptr;
+        tail_ = nullptr;
+    }
+
+    /// @}
+};
+
+} // namespace hellods
+
+#endif // PERSISTENTVECTOR_HPP
@@ -103,6 +103,17 @@ protected:
         tail_ = nullptr;
     }
 
+    // Return the node before the given rank (0 <= index <= size), the header for index 0.
+    Node* node_before(int index) const
+    {
+        Node* current = header_;
+        for (int i = 0; i < index; i++)
+        {
+            current = current->succ_;
+        }
+        return current;
+    }
+
     // Swap with another list.
     void swap(SinglyLinkedList& that)
     {
@@ -332,6 +343,157 @@ public:
         return data;
     }
 
+    /// Move the elements [first, last) of that list before the specified position in this list.
+    /// The nodes are relinked rather than copied, the cost is only walking to the positions.
+    /// Within the same list, the position must not lie strictly inside the moved range.
+    void splice(int index, SinglyLinkedList& that, int first, int last)
+    {
+        // check
+        detail::check_bounds(index, 0, size_ + 1);
+        detail::check_bounds(first, 0, that.size_ + 1);
+        detail::check_bounds(last, first, that.size_ + 1);
+        if (this == &that && index > first && index < last)
+        {
+            throw std::runtime_error("Error: Index out of range.");
+        }
+        if (first == last || (this == &that && (index == first || index == last)))
+        {
+            return;
+        }
+        if (this != &that)
+        {
+            detail::check_full(size_, MAX_CAPACITY - (last - first) + 1);
+        }
+
+        // index
+        Node* pos = node_before(index);
+        Node* before = that.node_before(first);
+        Node* back = before;
+        for (int i = first; i < last; ++i)
+        {
+            back = back->succ_;
+        }
+        Node* front = before->succ_;
+
+        // unlink from that list
+        before->succ_ = back->succ_;
+        if (that.tail_ == back)
+        {
+            that.tail_ = (before == that.header_) ? nullptr : before;
+        }
+
+        // link into this list
+        if (pos->succ_ == nullptr)
+        {
+            tail_ = back;
+        }
+        back->succ_ = pos->succ_;
+        pos->succ_ = front;
+
+        // resize
+        if (this != &that)
+        {
+            size_ += last - first;
+            that.size_ -= last - first;
+        }
+    }
+
+    /// Move all elements of that list to the end of this list in O(1), leaving that list empty.
+    void concat(SinglyLinkedList& that)
+    {
+        // check
+        if (this == &that)
+        {
+            SinglyLinkedList copy(that);
+            concat(copy);
+            return;
+        }
+        if (that.size_ == 0)
+        {
+            return;
+        }
+        detail::check_full(size_, MAX_CAPACITY - that.size_ + 1);
+
+        // link
+        (tail_ == nullptr ? header_ : tail_)->succ_ = that.header_->succ_;
+        tail_ = that.tail_;
+        size_ += that.size_;
+
+        // reset that list
+        that.header_->succ_ = nullptr;
+        that.tail_ = nullptr;
+        that.size_ = 0;
+    }
+
+    /// Split the list at the specified position, walking to it and relinking in O(1).
+    /// This list keeps the elements before index, and the elements from index on are returned as a new list.
+    SinglyLinkedList split_at(int index)
+    {
+        detail::check_bounds(index, 0, size_ + 1);
+
+        Node* pos = node_before(index);
+
+        SinglyLinkedList tail;
+        if (index < size_)
+        {
+            tail.header_->succ_ = pos->succ_;
+            tail.tail_ = tail_;
+            tail.size_ = size_ - index;
+
+            pos->succ_ = nullptr;
+            tail_ = (pos == header_) ? nullptr : pos;
+            size_ = index;
+        }
+        return tail;
+    }
+
+    /// Merge that sorted list into this sorted list in O(n + m) by relinking nodes, leaving that list empty.
+    /// The merge is stable: of equal elements, those from this list come first.
+    void merge(SinglyLinkedList& that)
+    {
+        // check
+        if (this == &that)
+        {
+            return;
+        }
+        detail::check_full(size_, MAX_CAPACITY - that.size_ + 1);
+
+        // move each run of that list which goes after the current node of this list
+        Node* current = header_;
+        while (that.header_->succ_ != nullptr)
+        {
+            Node* front = that.header_->succ_;
+            while (current->succ_ != nullptr && !(front->data_ < current->succ_->data_))
+            {
+                current = current->succ_;
+            }
+
+            // the rest of that list goes to the end
+            if (current->succ_ == nullptr)
+            {
+                current->succ_ = front;
+                tail_ = that.tail_;
+                that.header_->succ_ = nullptr;
+                break;
+            }
+
+            Node* back = front;
+            while (back->succ_ != nullptr && back->succ_->data_ < current->succ_->data_)
+            {
+                back = back->succ_;
+            }
+            that.header_->succ_ = back->succ_;
+            back->succ_ = current->succ_;
+            current->succ_ = front;
+            current = back;
+        }
+
+        // resize
+        size_ += that.size_;
+        that.size_ = 0;
+        that.tail_ = nullptr;
+    }
+
     /// Remove all of the elements from the list.
     void clear() override
     {
@@ -0,0 +1,654 @@
+/**
+ * @file TreeList.hpp
+ * @author Chen QingYu <chen_qingyu@qq.com>
+ * @brief List implemented by AVL tree with implicit keys.
+ * @date 2026.10.18
+ */
+
+#ifndef TREELIST_HPP
+#define TREELIST_HPP
+
+#include "List.hpp"
+
+namespace hellods
+{
+
+/// List implemented by AVL tree with implicit keys.
+///
+/// The in-order position of a node is its index, and every node records the size of its subtree
+/// in place of a key. Locating an index descends by subtree sizes, so access, insert and remove
+/// at any position are all O(log n). The tree can also be split at an index and concatenated
+/// with another list in O(log n).
+template <typename T>
+class TreeList : public List<T>
+{
+protected:
+    // Tree node.
+    struct Node
+    {
+        // Data stored in the node.
+        T data_;
+
+        // Pointer to the parent.
+        Node* parent_;
+
+        // Pointer to the left child.
+        Node* left_;
+
+        // Pointer to the right child.
+        Node* right_;
+
+        // Height of node (leaf height = 1).
+        int height_;
+
+        // Number of nodes in the subtree rooted at this node.
+        int size_;
+
+        // Create a node with given element.
+        Node(const T& data)
+            : data_(data)
+            , parent_(nullptr)
+            , left_(nullptr)
+            , right_(nullptr)
+            , height_(1)
+            , size_(1)
+        {
+        }
+    };
+
+protected:
+    template <bool Const>
+    class Iter
+    {
+        friend class TreeList;
+
+    protected:
+        using Value = std::conditional_t<Const, const T, T>;
+        using NodePtr = std::conditional_t<Const, const Node*, Node*>;
+
+        // Current node pointer.
+        NodePtr current_;
+
+        // Create an iterator that point to the current node of list.
+        Iter(NodePtr current)
+            : current_(current)
+        {
+        }
+
+    public:
+        /// Dereference.
+        Value& operator*() const
+        {
+            return current_->data_;
+        }
+
+        /// Check if two iterators are same.
+        bool operator==(const Iter& that) const
+        {
+            return current_ == that.current_;
+        }
+
+        /// Increment the iterator.
+        Iter& operator++()
+        {
+            if (current_->right_) // have right sub tree
+            {
+                current_ = current_->right_;
+                while (current_->left_) // find first in right sub tree
+                {
+                    current_ = current_->left_;
+                }
+            }
+            else // back to the next node in order
+            {
+                // due to the presence of end node, ensured current_->parent_ is not nullptr
+                while (current_->parent_->right_ == current_)
+                {
+                    current_ = current_->parent_;
+                }
+                current_ = current_->parent_;
+            }
+            return *this;
+        }
+
+        /// Decrement the iterator.
+        Iter& operator--()
+        {
+            if (current_->left_) // have left sub tree
+            {
+                current_ = current_->left_;
+                while (current_->right_) // find last in left sub tree
+                {
+                    current_ = current_->right_;
+                }
+            }
+            else // back to the previous node in order
+            {
+                while (current_->parent_->left_ == current_)
+                {
+                    current_ = current_->parent_;
+                }
+                current_ = current_->parent_;
+            }
+            return *this;
+        }
+    };
+
+protected:
+    using List<T>::MAX_CAPACITY;
+
+    // Number of elements.
+    int size_;
+
+    // Virtual end node, the root is its left child. Same as BinarySearchTree, it lets the iterator move back from end.
+    Node* end_;
+
+    // Pointer to the root.
+    Node* root_;
+
+    // Return the height of the node (nullptr has height 0).
+    static int height(const Node* node)
+    {
+        return node == nullptr ? 0 : node->height_;
+    }
+
+    // Return the subtree size of the node (nullptr has size 0).
+    static int count(const Node* node)
+    {
+        return node == nullptr ? 0 : node->size_;
+    }
+
+    // Return the balance factor of the node.
+    static int balance_factor(const Node* node)
+    {
+        return height(node->left_) - height(node->right_);
+    }
+
+    // Relink the children to the node and update its height and size. Return the node.
+    static Node* pull(Node* node)
+    {
+        if (node->left_)
+        {
+            node->left_->parent_ = node;
+        }
+        if (node->right_)
+        {
+            node->right_->parent_ = node;
+        }
+        node->height_ = 1 + std::max(height(node->left_), height(node->right_));
+        node->size_ = 1 + count(node->left_) + count(node->right_);
+        return node;
+    }
+
+    // Rotate right, return the new subtree root.
+    static Node* rotate_right(Node* node)
+    {
+        Node* left = node->left_;
+        node->left_ = left->right_;
+        left->right_ = pull(node);
+        return pull(left);
+    }
+
+    // Rotate left, return the new subtree root.
+    static Node* rotate_left(Node* node)
+    {
+        Node* right = node->right_;
+        node->right_ = right->left_;
+        right->left_ = pull(node);
+        return pull(right);
+    }
+
+    // Rebalance the subtree rooted at the node, return the new subtree root.
+    static Node* rebalance(Node* node)
+    {
+        pull(node);
+
+        int bf = balance_factor(node);
+
+        // Left heavy
+        if (bf > 1)
+        {
+            if (balance_factor(node->left_) < 0) // LR case
+            {
+                node->left_ = rotate_left(node->left_);
+            }
+            return rotate_right(node);
+        }
+
+        // Right heavy
+        if (bf < -1)
+        {
+            if (balance_factor(node->right_) > 0) // RL case
+            {
+                node->right_ = rotate_right(node->right_);
+            }
+            return rotate_left(node);
+        }
+
+        return node;
+    }
+
+    // Build a perfectly balanced subtree from the next n elements of the iterator.
+    template <typename It>
+    static Node* build(It& it, int n)
+    {
+        if (n == 0)
+        {
+            return nullptr;
+        }
+
+        Node* left = build(it, n / 2);
+        Node* node = new Node(*it);
+        ++it;
+        node->left_ = left;
+        node->right_ = build(it, n - n / 2 - 1);
+        return pull(node);
+    }
+
+    // Return the node at the given index of the subtree.
+    static Node* node_at(Node* node, int index)
+    {
+        while (true)
+        {
+            int left_size = count(node->left_);
+            if (index < left_size)
+            {
+                node = node->left_;
+            }
+            else if (index > left_size)
+            {
+                index -= left_size + 1;
+                node = node->right_;
+            }
+            else
+            {
+                return node;
+            }
+        }
+    }
+
+    // Insert a node at the given index of the subtree recursively, return the new subtree root.
+    static Node* insert_node(Node* node, int index, const T& element)
+    {
+        if (node == nullptr)
+        {
+            return new Node(element);
+        }
+
+        int left_size = count(node->left_);
+        if (index <= left_size)
+        {
+            node->left_ = insert_node(node->left_, index, element);
+        }
+        else
+        {
+            node->right_ = insert_node(node->right_, index - left_size - 1, element);
+        }
+
+        return rebalance(node);
+    }
+
+    // Detach the first node of the subtree into first, return the new subtree root.
+    static Node* remove_first(Node* node, Node*& first)
+    {
+        if (node->left_ == nullptr)
+        {
+            first = node;
+            return node->right_;
+        }
+
+        node->left_ = remove_first(node->left_, first);
+        return rebalance(node);
+    }
+
+    // Detach the last node of the subtree into last, return the new subtree root.
+    static Node* remove_last(Node* node, Node*& last)
+    {
+        if (node->right_ == nullptr)
+        {
+            last = node;
+            return node->left_;
+        }
+
+        node->right_ = remove_last(node->right_, last);
+        return rebalance(node);
+    }
+
+    // Detach the node at the given index of the subtree into removed, return the new subtree root.
+    static Node* remove_node(Node* node, int index, Node*& removed)
+    {
+        int left_size = count(node->left_);
+        if (index < left_size)
+        {
+            node->left_ = remove_node(node->left_, index, removed);
+        }
+        else if (index > left_size)
+        {
+            node->right_ = remove_node(node->right_, index - left_size - 1, removed);
+        }
+        else // found, relink the successor in its place instead of copying data
+        {
+            removed = node;
+            if (node->left_ == nullptr || node->right_ == nullptr)
+            {
+                return node->left_ ? node->left_ : node->right_;
+            }
+
+            Node* successor = nullptr;
+            Node* right = remove_first(node->right_, successor);
+            successor->left_ = node->left_;
+            successor->right_ = right;
+            node = successor;
+        }
+
+        return rebalance(node);
+    }
+
+    // Join left subtree, middle node and right subtree, where all of left precede mid and all of right follow it.
+    // Return the new subtree root. Cost is O(|height(left) - height(right)|).
+    static Node* join(Node* left, Node* mid, Node* right)
+    {
+        if (height(left) > height(right) + 1)
+        {
+            left->right_ = join(left->right_, mid, right);
+            return rebalance(left);
+        }
+
+        if (height(right) > height(left) + 1)
+        {
+            right->left_ = join(left, mid, right->left_);
+            return rebalance(right);
+        }
+
+        mid->left_ = left;
+        mid->right_ = right;
+        return pull(mid);
+    }
+
+    // Join two subtrees, where all of left precede right. Return the new subtree root.
+    static Node* join(Node* left, Node* right)
+    {
+        if (left == nullptr)
+        {
+            return right;
+        }
+
+        Node* last = nullptr;
+        left = remove_last(left, last);
+        return join(left, last, right);
+    }
+
+    // Split the subtree into the first index nodes (left) and the rest (right).
+    static void split(Node* node, int index, Node*& left, Node*& right)
+    {
+        if (node == nullptr)
+        {
+            left = right = nullptr;
+            return;
+        }
+
+        Node* node_left = node->left_;
+        Node* node_right = node->right_;
+        int left_size = count(node_left);
+        if (index <= left_size)
+        {
+            split(node_left, index, left, right);
+            right = join(right, node, node_right);
+        }
+        else
+        {
+            split(node_right, index - left_size - 1, left, right);
+            left = join(node_left, node, left);
+        }
+    }
+
+    // Destroy the subtree rooted at that node recursively.
+    static void destroy(Node* node)
+    {
+        if (node)
+        {
+            destroy(node->left_);
+            destroy(node->right_);
+            delete node;
+        }
+    }
+
+    // Replace the root node.
+    void set_root(Node* node)
+    {
+        root_ = node;
+        end_->left_ = node;
+        if (node != nullptr)
+        {
+            node->parent_ = end_;
+        }
+    }
+
+    // Return the first node, or end_ if empty.
+    Node* first_node() const
+    {
+        Node* node = end_;
+        while (node->left_)
+        {
+            node = node->left_;
+        }
+        return node;
+    }
+
+    // Swap with another list.
+    void swap(TreeList& that)
+    {
+        std::swap(size_, that.size_);
+        std::swap(end_, that.end_);
+        std::swap(root_, that.root_);
+    }
+
+public:
+    /// @name Lifecycle
+    /// @{
+
+    /// Create an empty list.
+    TreeList()
+        : size_(0)
+        , end_(new Node(T()))
+        , root_(nullptr)
+    {
+    }
+
+    /// Create a list with the specified number of default-inserted elements.
+    explicit TreeList(int size)
+        : TreeList()
+    {
+        for (int i = 0; i < size; ++i)
+        {
+            append(T());
+        }
+    }
+
+    /// Create a list based on the given initializer list.
+    TreeList(const std::initializer_list<T>& il)
+        : TreeList()
+    {
+        auto it = il.begin();
+        set_root(build(it, int(il.size())));
+        size_ = int(il.size());
+    }
+
+    /// Copy constructor.
+    TreeList(const TreeList& that)
+        : TreeList()
+    {
+        auto it = that.begin();
+        set_root(build(it, that.size_));
+        size_ = that.size_;
+    }
+
+    /// Move constructor.
+    TreeList(TreeList&& that)
+        : TreeList()
+    {
+        swap(that);
+    }
+
+    TreeList& operator=(TreeList that)
+    {
+        swap(that);
+        return *this;
+    }
+
+    /// Destroy the list object.
+    ~TreeList()
+    {
+        destroy(root_);
+        delete end_;
+    }
+    /// @}
+
+    /// @name Access
+    /// @{
+
+    /// Return the reference to the element at the specified position in the list.
+    T& operator[](int index) override
+    {
+        detail::check_bounds(index, 0, size_);
+        return node_at(root_, index)->data_;
+    }
+
+    using List<T>::operator[]; // const
+    /// @}
+
+    /// @name Iterator
+    /// @{
+
+    /// Return an iterator to the first element of the list.
+    /// If the list is empty, the returned iterator will be equal to end().
+    typename List<T>::Iterator begin() override
+    {
+        return typename List<T>::Iterator(Iter<false>(first_node()));
+    }
+
+    typename List<T>::ConstIterator begin() const override
+    {
+        return typename List<T>::ConstIterator(Iter<true>(first_node()));
+    }
+
+    /// Return an iterator to the element following the last element of the list.
+    /// This element acts as a placeholder, attempting to access it results in undefined behavior.
+    typename List<T>::Iterator end() override
+    {
+        return typename List<T>::Iterator(Iter<false>(end_));
+    }
+
+    typename List<T>::ConstIterator end() const override
+    {
+        return typename List<T>::ConstIterator(Iter<true>(end_));
+    }
+    /// @}
+
+    /// @name Examination
+    /// @{
+
+    /// Get the number of elements.
+    int size() const override
+    {
+        return size_;
+    }
+    /// @}
+
+    /// @name Manipulation
+    /// @{
+
+    /// Append the specified element to the list.
+    void append(const T& element) override
+    {
+        insert(size_, element);
+    }
+
+    /// Insert the specified element at the specified position in the list.
+    void insert(int index, const T& element) override
+    {
+        // check
+        detail::check_full(size_, MAX_CAPACITY);
+        detail::check_bounds(index, 0, size_ + 1);
+
+        // insert and resize
+        set_root(insert_node(root_, index, element));
+        ++size_;
+    }
+
+    /// Remove and return the element at the specified position in the list.
+    T remove(int index) override
+    {
+        // check
+        detail::check_empty(size_);
+        detail::check_bounds(index, 0, size_);
+
+        // remove
+        Node* removed = nullptr;
+        set_root(remove_node(root_, index, removed));
+        --size_;
+
+        // move data and free node
+        T element = std::move(removed->data_);
+        delete removed;
+
+        // return element
+        return element;
+    }
+
+    /// Move all elements of that list to the end of this list in O(log n), leaving that list empty.
+    void concat(TreeList& that)
+    {
+        if (this == &that)
+        {
+            TreeList copy(that);
+            concat(copy);
+            return;
+        }
+
+        detail::check_full(size_, MAX_CAPACITY - that.size_ + 1);
+
+        set_root(join(root_, that.root_));
+        size_ += that.size_;
+
+        that.set_root(nullptr);
+        that.size_ = 0;
+    }
+
+    /// Split the list at the specified position in O(log n).
+    /// This list keeps the elements before index, and the elements from index on are returned as a new list.
+    TreeList split_at(int index)
+    {
+        detail::check_bounds(index, 0, size_ + 1);
+
+        Node* left = nullptr;
+        Node* right = nullptr;
+        split(root_, index, left, right);
+
+        TreeList tail;
+        tail.set_root(right);
+        tail.size_ = size_ - index;
+
+        set_root(left);
+        size_ = index;
+
+        return tail;
+    }
+
+    /// Remove all of the elements from the list.
+    void clear() override
+    {
+        if (size_ != 0)
+        {
+            destroy(root_);
+            set_root(nullptr);
+            size_ = 0;
+        }
+    }
+
+    /// @}
+};
+
+} // namespace hellods
+
+#endif // TREELIST_HPP
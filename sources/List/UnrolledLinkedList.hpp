@@ -0,0 +1,435 @@
+/**
+ * @file UnrolledLinkedList.hpp
+ * @author Chen QingYu <chen_qingyu@qq.com>
+ * @brief List implemented by unrolled (chunked) linked list.
+ * @date 2026.10.18
+ */
+
+#ifndef UNROLLEDLINKEDLIST_HPP
+#define UNROLLEDLINKEDLIST_HPP
+
+#include "List.hpp"
+
+namespace hellods
+{
+
+/// List implemented by unrolled (chunked) linked list.
+///
+/// Elements are stored in fixed-size chunks that span a few cache lines, and the chunks are doubly linked.
+/// Each chunk records its own element count, so locating an index skips whole chunks,
+/// and inserting or removing in the middle only shifts the elements of one chunk.
+template <typename T>
+class UnrolledLinkedList : public List<T>
+{
+protected:
+    // Number of elements per chunk, so that the elements of a chunk span at least four cache lines.
+    static constexpr int CHUNK_CAPACITY = std::max(8, int(4 * detail::CACHE_LINE_SIZE / sizeof(T)));
+
+    // Chunk of unrolled linked list.
+    struct alignas(detail::CACHE_LINE_SIZE) Chunk
+    {
+        // Number of elements in the chunk, data_[0, count_) are valid.
+        int count_;
+
+        // Predecessor.
+        Chunk* pred_;
+
+        // Successor.
+        Chunk* succ_;
+
+        // Elements stored in the chunk.
+        T data_[CHUNK_CAPACITY];
+
+        // Create an empty chunk.
+        Chunk(Chunk* pred = nullptr, Chunk* succ = nullptr)
+            : count_(0)
+            , pred_(pred)
+            , succ_(succ)
+            , data_()
+        {
+        }
+    };
+
+protected:
+    template <bool Const>
+    class Iter
+    {
+        friend class UnrolledLinkedList;
+
+    protected:
+        using Value = std::conditional_t<Const, const T, T>;
+        using ChunkPtr = std::conditional_t<Const, const Chunk*, Chunk*>;
+
+        // Current chunk.
+        ChunkPtr current_;
+
+        // Offset in the current chunk.
+        int offset_;
+
+        // Create an iterator that point to the element at offset of the chunk.
+        Iter(ChunkPtr current, int offset)
+            : current_(current)
+            , offset_(offset)
+        {
+        }
+
+    public:
+        /// Dereference.
+        Value& operator*() const
+        {
+            return current_->data_[offset_];
+        }
+
+        /// Check if two iterators are same.
+        bool operator==(const Iter& that) const
+        {
+            return current_ == that.current_ && offset_ == that.offset_;
+        }
+
+        /// Increment the iterator.
+        Iter& operator++()
+        {
+            // there is no empty chunk in the list, so the successor starts with a valid element or is the trailer
+            if (++offset_ == current_->count_)
+            {
+                current_ = current_->succ_;
+                offset_ = 0;
+            }
+            return *this;
+        }
+
+        /// Decrement the iterator.
+        Iter& operator--()
+        {
+            if (offset_ == 0)
+            {
+                current_ = current_->pred_;
+                offset_ = current_->count_;
+            }
+            --offset_;
+            return *this;
+        }
+    };
+
+protected:
+    using List<T>::MAX_CAPACITY;
+
+    // Number of elements.
+    int size_;
+
+    // Pointer to the header chunk (always empty).
+    Chunk* header_;
+
+    // Pointer to the trailer chunk (always empty).
+    Chunk* trailer_;
+
+    // Link a new empty chunk after the given chunk, return the new chunk.
+    Chunk* link_chunk(Chunk* pos)
+    {
+        Chunk* chunk = new Chunk(pos, pos->succ_);
+        pos->succ_->pred_ = chunk;
+        pos->succ_ = chunk;
+        return chunk;
+    }
+
+    // Unlink and delete the given chunk.
+    void unlink_chunk(Chunk* chunk)
+    {
+        chunk->pred_->succ_ = chunk->succ_;
+        chunk->succ_->pred_ = chunk->pred_;
+        delete chunk;
+    }
+
+    // Move the upper half of a full chunk into a new chunk after it.
+    void split_chunk(Chunk* chunk)
+    {
+        Chunk* next = link_chunk(chunk);
+        int half = CHUNK_CAPACITY / 2;
+        std::move(chunk->data_ + half, chunk->data_ + chunk->count_, next->data_);
+        next->count_ = chunk->count_ - half;
+        chunk->count_ = half;
+    }
+
+    // Merge the successor into the chunk if the chunk is less than half full and both fit in one chunk.
+    void merge_chunk(Chunk* chunk)
+    {
+        Chunk* next = chunk->succ_;
+        if (chunk->count_ < CHUNK_CAPACITY / 2 && next != trailer_ && chunk->count_ + next->count_ <= CHUNK_CAPACITY)
+        {
+            std::move(next->data_, next->data_ + next->count_, chunk->data_ + chunk->count_);
+            chunk->count_ += next->count_;
+            unlink_chunk(next);
+        }
+    }
+
+    // Return the chunk holding the element at the given index, and convert the index to the offset in that chunk.
+    Chunk* locate(int& index) const
+    {
+        if (index < size_ / 2) // closer to the header
+        {
+            Chunk* chunk = header_->succ_;
+            while (index >= chunk->count_)
+            {
+                index -= chunk->count_;
+                chunk = chunk->succ_;
+            }
+            return chunk;
+        }
+        else // closer to the trailer
+        {
+            Chunk* chunk = trailer_->pred_;
+            int first = size_ - chunk->count_; // index of the first element in the chunk
+            while (index < first)
+            {
+                chunk = chunk->pred_;
+                first -= chunk->count_;
+            }
+            index -= first;
+            return chunk;
+        }
+    }
+
+    // Clear the stored data.
+    void clear_data()
+    {
+        while (header_->succ_ != trailer_)
+        {
+            unlink_chunk(header_->succ_);
+        }
+
+        size_ = 0;
+    }
+
+    // Swap with another list.
+    void swap(UnrolledLinkedList& that)
+    {
+        std::swap(size_, that.size_);
+        std::swap(header_, that.header_);
+        std::swap(trailer_, that.trailer_);
+    }
+
+public:
+    /// @name Lifecycle
+    /// @{
+
+    /// Create an empty list.
+    UnrolledLinkedList()
+        : size_(0)
+        , header_(new Chunk())
+        , trailer_(new Chunk())
+    {
+        header_->succ_ = trailer_;
+        trailer_->pred_ = header_;
+    }
+
+    /// Create a list with the specified number of default-inserted elements.
+    explicit UnrolledLinkedList(int size)
+        : UnrolledLinkedList()
+    {
+        for (int i = 0; i < size; ++i)
+        {
+            append(T());
+        }
+    }
+
+    /// Create a list based on the given initializer list.
+    UnrolledLinkedList(const std::initializer_list<T>& il)
+        : UnrolledLinkedList()
+    {
+        for (auto it = il.begin(); it != il.end(); ++it)
+        {
+            append(*it);
+        }
+    }
+
+    /// Copy constructor.
+    UnrolledLinkedList(const UnrolledLinkedList& that)
+        : UnrolledLinkedList()
+    {
+        for (auto it = that.begin(); it != that.end(); ++it)
+        {
+            append(*it);
+        }
+    }
+
+    /// Move constructor.
+    UnrolledLinkedList(UnrolledLinkedList&& that)
+        : UnrolledLinkedList()
+    {
+        swap(that);
+    }
+
+    UnrolledLinkedList& operator=(UnrolledLinkedList that)
+    {
+        swap(that);
+        return *this;
+    }
+
+    /// Destroy the list object.
+    ~UnrolledLinkedList()
+    {
+        clear_data();
+        delete header_;
+        delete trailer_;
+    }
+    /// @}
+
+    /// @name Access
+    /// @{
+
+    /// Return the reference to the element at the specified position in the list. Whole chunks are skipped while locating.
+    T& operator[](int index) override
+    {
+        detail::check_bounds(index, 0, size_);
+
+        Chunk* chunk = locate(index);
+        return chunk->data_[index];
+    }
+
+    using List<T>::operator[]; // const
+    /// @}
+
+    /// @name Iterator
+    /// @{
+
+    /// Return an iterator to the first element of the list.
+    /// If the list is empty, the returned iterator will be equal to end().
+    typename List<T>::Iterator begin() override
+    {
+        return typename List<T>::Iterator(Iter<false>(header_->succ_, 0));
+    }
+
+    typename List<T>::ConstIterator begin() const override
+    {
+        return typename List<T>::ConstIterator(Iter<true>(header_->succ_, 0));
+    }
+
+    /// Return an iterator to the element following the last element of the list.
+    /// This element acts as a placeholder, attempting to access it results in undefined behavior.
+    typename List<T>::Iterator end() override
+    {
+        return typename List<T>::Iterator(Iter<false>(trailer_, 0));
+    }
+
+    typename List<T>::ConstIterator end() const override
+    {
+        return typename List<T>::ConstIterator(Iter<true>(trailer_, 0));
+    }
+    /// @}
+
+    /// @name Examination
+    /// @{
+
+    /// Get the number of elements.
+    int size() const override
+    {
+        return size_;
+    }
+    /// @}
+
+    /// @name Manipulation
+    /// @{
+
+    /// Append the specified element to the list.
+    void append(const T& element) override
+    {
+        // check
+        detail::check_full(size_, MAX_CAPACITY);
+
+        // start a new chunk if the last one is full, so that appended chunks stay full
+        Chunk* chunk = trailer_->pred_;
+        if (chunk == header_ || chunk->count_ == CHUNK_CAPACITY)
+        {
+            chunk = link_chunk(chunk);
+        }
+
+        // insert and resize
+        chunk->data_[chunk->count_++] = element;
+        ++size_;
+    }
+
+    /// Insert the specified element at the specified position in the list.
+    void insert(int index, const T& element) override
+    {
+        // check
+        detail::check_full(size_, MAX_CAPACITY);
+        detail::check_bounds(index, 0, size_ + 1);
+
+        if (index == size_)
+        {
+            append(element);
+            return;
+        }
+
+        // index
+        Chunk* chunk = locate(index);
+
+        // split if the chunk is full
+        if (chunk->count_ == CHUNK_CAPACITY)
+        {
+            split_chunk(chunk);
+            if (index > chunk->count_)
+            {
+                index -= chunk->count_;
+                chunk = chunk->succ_;
+            }
+        }
+
+        // shift within the chunk
+        std::move_backward(chunk->data_ + index, chunk->data_ + chunk->count_, chunk->data_ + chunk->count_ + 1);
+
+        // insert and resize
+        chunk->data_[index] = element;
+        ++chunk->count_;
+        ++size_;
+    }
+
+    /// Remove and return the element at the specified position in the list.
+    T remove(int index) override
+    {
+        // check
+        detail::check_empty(size_);
+        detail::check_bounds(index, 0, size_);
+
+        // index
+        Chunk* chunk = locate(index);
+
+        // move element
+        T element = std::move(chunk->data_[index]);
+
+        // shift within the chunk
+        std::move(chunk->data_ + index + 1, chunk->data_ + chunk->count_, chunk->data_ + index);
+
+        // resize
+        --chunk->count_;
+        --size_;
+
+        // keep chunks non-empty and reasonably full
+        if (chunk->count_ == 0)
+        {
+            unlink_chunk(chunk);
+        }
+        else
+        {
+            merge_chunk(chunk);
+        }
+
+        // return element
+        return element;
+    }
+
+    /// Remove all of the elements from the list.
+    void clear() override
+    {
+        if (size_ != 0)
+        {
+            clear_data();
+        }
+    }
+
+    /// @}
+};
+
+} // namespace hellods
+
+#endif // UNROLLEDLINKEDLIST_HPP
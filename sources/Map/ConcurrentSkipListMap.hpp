@@ -0,0 +1,272 @@
+/**
+ * @file ConcurrentSkipListMap.hpp
+ * @author Chen QingYu <chen_qingyu@qq.com>
+ * @brief Lock-free ordered map implemented by skip list.
+ * @date 2026.10.18
+ */
+
+#ifndef CONCURRENTSKIPLISTMAP_HPP
+#define CONCURRENTSKIPLISTMAP_HPP
+
+#include "../Set/ConcurrentSkipListSet.hpp"
+#include "Map.hpp"
+
+#include <optional> // std::optional
+
+namespace hellods
+{
+
+/// Lock-free ordered map implemented by skip list.
+///
+/// Any number of threads may insert, remove, search and scan ranges concurrently, see ConcurrentSkipListSet.
+/// The entries themselves are not synchronized: a value may be updated in place only while no other thread reads it.
+/// operator[] must not race with the removal of its entry, which may be freed as soon as it returns the reference;
+/// get() returns a copy instead, and an iterator keeps its entry alive.
+/// Lifecycle operations, comparison and printing require that no other thread is using the map.
+template <typename K, typename V>
+class ConcurrentSkipListMap : public Map<K, V>
+{
+    using EntrySet = ConcurrentSkipListSet<detail::MapEntry<K, V>>;
+
+    EntrySet set_;
+
+    // Wraps the set's const iterator to provide mutable access.
+    class Iter : public EntrySet::Iterator
+    {
+        using Base = typename EntrySet::Iterator;
+
+    public:
+        explicit Iter(Base it)
+            : Base(std::move(it))
+        {
+        }
+
+        typename Map<K, V>::Entry& operator*() const
+        {
+            return const_cast<typename Map<K, V>::Entry&>(Base::operator*());
+        }
+    };
+
+public:
+    /// @name Lifecycle
+    /// @{
+
+    /// Create an empty map.
+    ConcurrentSkipListMap() = default;
+
+    /// Create a map based on the given initializer list.
+    ConcurrentSkipListMap(const std::initializer_list<std::pair<const K, V>>& il)
+        : set_()
+    {
+        for (auto it = il.begin(); it != il.end(); ++it)
+        {
+            insert(it->first, it->second);
+        }
+    }
+
+    ConcurrentSkipListMap(const ConcurrentSkipListMap&) = default;
+    ConcurrentSkipListMap(ConcurrentSkipListMap&&) = default;
+
+    ConcurrentSkipListMap& operator=(const ConcurrentSkipListMap&) = default;
+    ConcurrentSkipListMap& operator=(ConcurrentSkipListMap&&) = default;
+    /// @}
+
+    /// @name Comparison
+    /// @{
+
+    /// Check whether two maps are equal.
+    bool operator==(const ConcurrentSkipListMap& that) const
+    {
+        return set_.size() == that.set_.size() && std::equal(set_.begin(), set_.end(), that.set_.begin(), [](const auto& a, const auto& b)
+                                                             { return a.key() == b.key() && a.value() == b.value(); });
+    }
+    /// @}
+
+    /// @name Access
+    /// @{
+
+    /// Return the reference of value for key if key is in the map, else throw exception.
+    /// Unsafe while another thread may remove the key: use get() or find() then.
+    V& operator[](const K& key) override
+    {
+        auto it = set_.find(detail::MapEntry<K, V>{key});
+        if (it == set_.end())
+        {
+            throw std::runtime_error("Error: The key-value pair does not exist.");
+        }
+        return const_cast<V&>(it->value());
+    }
+
+    /// Return the const reference of value for key if key is in the map, else throw exception.
+    /// Unsafe while another thread may remove the key: use get() or find() then.
+    const V& operator[](const K& key) const override
+    {
+        auto it = set_.find(detail::MapEntry<K, V>{key});
+        if (it == set_.end())
+        {
+            throw std::runtime_error("Error: The key-value pair does not exist.");
+        }
+        return it->value();
+    }
+
+    /// Return a copy of the value for key, or std::nullopt if key is not in the map.
+    /// Safe while other threads remove the key, as the entry is kept alive until the copy is made.
+    std::optional<V> get(const K& key) const
+    {
+        auto it = set_.find(detail::MapEntry<K, V>{key});
+        if (it == set_.end())
+        {
+            return std::nullopt;
+        }
+        return it->value();
+    }
+    /// @}
+
+    /// @name Iterator
+    /// @{
+
+    /// Return an iterator to the first element of the map.
+    Map<K, V>::Iterator begin() override
+    {
+        return typename Map<K, V>::Iterator(Iter(set_.begin()));
+    }
+
+    Map<K, V>::ConstIterator begin() const override
+    {
+        return set_.begin();
+    }
+
+    /// Return an iterator to the element following the last element of the map.
+    Map<K, V>::Iterator end() override
+    {
+        return typename Map<K, V>::Iterator(Iter(set_.end()));
+    }
+
+    Map<K, V>::ConstIterator end() const override
+    {
+        return set_.end();
+    }
+    /// @}
+
+    /// @name Examination
+    /// @{
+
+    /// Get the number of elements. A snapshot while other threads are operating.
+    int size() const override
+    {
+        return set_.size();
+    }
+
+    /// Return an iterator to the entry with the specified key, or end() if the map does not contain the key.
+    Map<K, V>::Iterator find(const K& key) override
+    {
+        return typename Map<K, V>::Iterator(Iter(set_.find(detail::MapEntry<K, V>{key})));
+    }
+
+    /// Return a const iterator to the entry with the specified key, or end() if the map does not contain the key.
+    Map<K, V>::ConstIterator find(const K& key) const override
+    {
+        return set_.find(detail::MapEntry<K, V>{key});
+    }
+
+    /// Check if the map contains the specified key.
+    bool contains(const K& key) const override
+    {
+        return set_.contains(detail::MapEntry<K, V>{key});
+    }
+
+    /// Return an iterator to the first entry whose key is not less than the specified key, or end() if there is no such entry.
+    Map<K, V>::Iterator lower_bound(const K& key)
+    {
+        return typename Map<K, V>::Iterator(Iter(set_.lower_bound(detail::MapEntry<K, V>{key})));
+    }
+
+    Map<K, V>::ConstIterator lower_bound(const K& key) const
+    {
+        return set_.lower_bound(detail::MapEntry<K, V>{key});
+    }
+
+    /// Return an iterator to the first entry whose key is greater than the specified key, or end() if there is no such entry.
+    Map<K, V>::Iterator upper_bound(const K& key)
+    {
+        return typename Map<K, V>::Iterator(Iter(set_.upper_bound(detail::MapEntry<K, V>{key})));
+    }
+
+    Map<K, V>::ConstIterator upper_bound(const K& key) const
+    {
+        return set_.upper_bound(detail::MapEntry<K, V>{key});
+    }
+
+    /// Return the range of entries with the specified key, as the pair of lower_bound() and upper_bound().
+    std::pair<typename Map<K, V>::Iterator, typename Map<K, V>::Iterator> equal_range(const K& key)
+    {
+        return {lower_bound(key), upper_bound(key)};
+    }
+
+    std::pair<typename Map<K, V>::ConstIterator, typename Map<K, V>::ConstIterator> equal_range(const K& key) const
+    {
+        return {lower_bound(key), upper_bound(key)};
+    }
+
+    /// Return an iterator to the entry with the largest key not greater than the specified key, or end() if there is no such entry.
+    Map<K, V>::Iterator floor(const K& key)
+    {
+        return typename Map<K, V>::Iterator(Iter(set_.floor(detail::MapEntry<K, V>{key})));
+    }
+
+    Map<K, V>::ConstIterator floor(const K& key) const
+    {
+        return set_.floor(detail::MapEntry<K, V>{key});
+    }
+
+    /// Return an iterator to the entry with the smallest key not less than the specified key, or end() if there is no such entry.
+    Map<K, V>::Iterator ceiling(const K& key)
+    {
+        return lower_bound(key);
+    }
+
+    Map<K, V>::ConstIterator ceiling(const K& key) const
+    {
+        return lower_bound(key);
+    }
+
+    /// Return a view of the entries with keys in the range [lo, hi), in O(log N + K) expected for K entries. Empty if !(lo < hi).
+    std::ranges::subrange<typename Map<K, V>::Iterator> range(const K& lo, const K& hi)
+    {
+        auto first = lower_bound(lo);
+        return {first, lo < hi ? lower_bound(hi) : first};
+    }
+
+    std::ranges::subrange<typename Map<K, V>::ConstIterator> range(const K& lo, const K& hi) const
+    {
+        return set_.range(detail::MapEntry<K, V>{lo}, detail::MapEntry<K, V>{hi});
+    }
+    /// @}
+
+    /// @name Manipulation
+    /// @{
+
+    /// Insert a new key-value pair into the map. Return whether the pair was newly inserted.
+    bool insert(const K& key, const V& value) override
+    {
+        return set_.insert(detail::MapEntry<K, V>{key, value});
+    }
+
+    /// Remove the key-value pair corresponding to the key in the map. Return whether the key was present and removed by this call.
+    bool remove(const K& key) override
+    {
+        return set_.remove(detail::MapEntry<K, V>{key});
+    }
+
+    /// Remove all of the elements from the map. Entries inserted concurrently may remain.
+    void clear() override
+    {
+        set_.clear();
+    }
+
+    /// @}
+};
+
+} // namespace hellods
+
+#endif // CONCURRENTSKIPLISTMAP_HPP
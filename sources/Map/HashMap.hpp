@@ -43,6 +43,9 @@ protected:
     // Pointer to the slots.
     Slot* data_;
 
+    // Whether to shrink the capacity automatically when elements are removed.
+    bool auto_shrink_;
+
 public:
     /// Map iterator class.
     ///
@@ -187,15 +190,12 @@ protected:
         return n;
     }
 
-    // Expand capacity and rehash.
-    void expand_capacity()
+    // Rehash into the given number of slots. Require size <= capacity / 2.
+    void rehash(int new_capacity)
     {
         int old_capacity = capacity_;
         Slot* old_data = data_;
 
-        // expand to the next prime greater than twice the current capacity
-        int new_capacity = next_prime(capacity_ * 2);
-
         // create new slots (value-initialized: state zeroed to EMPTY)
         Slot* new_data = new Slot[new_capacity]();
 
@@ -215,12 +215,30 @@ protected:
         delete[] old_data;
     }
 
+    // Expand capacity and rehash.
+    void expand_capacity()
+    {
+        // expand to the next prime greater than twice the current capacity
+        rehash(next_prime(capacity_ * 2));
+    }
+
+    // Shrink capacity if auto-shrink is on and the loading factor drops below 1/8, rehashing to a loading factor of about 1/4.
+    // Growing again takes doubling the size and shrinking again takes halving it, so the two never alternate.
+    void shrink_if_sparse()
+    {
+        if (auto_shrink_ && size_ < capacity_ / 8 && capacity_ > INIT_PRIME_CAPACITY)
+        {
+            rehash(next_prime(size_ * 4));
+        }
+    }
+
     // Swap with another map.
     void swap(HashMap& that)
     {
         std::swap(size_, that.size_);
         std::swap(capacity_, that.capacity_);
         std::swap(data_, that.data_);
+        std::swap(auto_shrink_, that.auto_shrink_);
     }
 
 public:
@@ -232,6 +250,7 @@ public:
         : size_(0)
         , capacity_(INIT_PRIME_CAPACITY)
         , data_(new Slot[capacity_]())
+        , auto_shrink_(false)
     {
     }
 
@@ -250,6 +269,7 @@ public:
         : size_(0)
         , capacity_(that.capacity_)
         , data_(new Slot[capacity_]())
+        , auto_shrink_(that.auto_shrink_)
     {
         for (int i = 0; i < that.capacity_; ++i)
         {
@@ -369,6 +389,12 @@ public:
         return size_;
     }
 
+    /// Get the number of slots, kept at least twice the number of elements.
+    int capacity() const
+    {
+        return capacity_;
+    }
+
     /// Return an iterator to the first occurrence of the specified key, or end() if the map does not contains the key.
     Map<K, V>::Iterator find(const K& key) override
     {
@@ -423,6 +449,7 @@ public:
 
         data_[pos].second = DELETED;
         size_--;
+        shrink_if_sparse();
         return true;
     }
 
@@ -437,6 +464,24 @@ public:
             }
             size_ = 0;
         }
+        shrink_if_sparse();
+    }
+
+    /// Reduce the capacity to the smallest prime that keeps the loading factor within 1/2, dropping the deleted slots too.
+    void shrink_to_fit()
+    {
+        if (int capacity = next_prime(size_ * 2); capacity < capacity_)
+        {
+            rehash(capacity);
+        }
+    }
+
+    /// Turn automatic shrinking on or off (default off).
+    /// When on, a removal that leaves the loading factor below 1/8 shrinks the capacity to about four times the number of elements.
+    void set_auto_shrink(bool enabled)
+    {
+        auto_shrink_ = enabled;
+        shrink_if_sparse();
     }
 
     /// @}
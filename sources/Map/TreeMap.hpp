@@ -15,28 +15,131 @@ namespace hellods
 {
 
 /// Map implemented by tree.
+///
+/// With a persistent tree like PersistentAVLTree, copying the map is O(1) and the copy is a snapshot that other threads may read
+/// while this map keeps changing. Lookups through a mutable map (operator[], find, bounds, begin) copy only the path to their entry,
+/// so they stay O(log N) after a copy, and a mutable iterator copies its entry again if the map is copied while it is held.
+/// The first move of such an iterator after a copy copies all the entries still shared, since it may reach any of them,
+/// so iterate over the map through a const reference where possible.
 template <typename K, typename V, typename Tree = RedBlackTree<detail::MapEntry<K, V>>>
 class TreeMap : public Map<K, V>
 {
     Tree tree_;
 
+    // Whether the tree shares its nodes between copies, so that writes through the iterators must copy them first.
+    static constexpr bool PERSISTENT = requires(Tree& tree) { tree.find_unshared(detail::MapEntry<K, V>{}); };
+
     // Wraps the tree's const iterator to provide mutable access.
-    class Iter : public Tree::Iterator
+    class Iter
     {
         using Base = typename Tree::Iterator;
 
+        // Position in the tree, moved onto the copied nodes whenever the entry is copied out of the snapshots.
+        mutable Base it_;
+
+        // Map of a persistent tree, or nullptr.
+        TreeMap* map_;
+
+        // Generation of the tree in which the path to the current entry was copied out of the snapshots.
+        mutable unsigned generation_;
+
+        // Whether all the entries were copied out of the snapshots in that generation, not only the path to the current one.
+        mutable bool whole_;
+
     public:
-        explicit Iter(Base it)
-            : Base(std::move(it))
+        explicit Iter(Base it, TreeMap* map = nullptr)
+            : it_(std::move(it))
+            , map_(map)
+            , generation_(0)
+            , whole_(false)
         {
+            if constexpr (PERSISTENT)
+            {
+                generation_ = map_ != nullptr ? map_->tree_.generation() : 0;
+            }
         }
 
         typename Map<K, V>::Entry& operator*() const
         {
-            return const_cast<typename Map<K, V>::Entry&>(Base::operator*());
+            if constexpr (PERSISTENT)
+            {
+                // the map was copied since, so the entry is shared with the copy and must be copied before a write
+                if (map_ != nullptr && generation_ != map_->tree_.generation())
+                {
+                    it_ = map_->tree_.find_unshared(detail::MapEntry<K, V>{it_->key()});
+                    generation_ = map_->tree_.generation();
+                    whole_ = false;
+                }
+            }
+            return const_cast<typename Map<K, V>::Entry&>(*it_);
+        }
+
+        Iter& operator++()
+        {
+            unshare();
+            ++it_;
+            return *this;
+        }
+
+        Iter& operator--()
+        {
+            unshare();
+            --it_;
+            return *this;
+        }
+
+        bool operator==(const Iter& that) const
+        {
+            return it_ == that.it_;
+        }
+
+    private:
+        // Copy all the entries still shared with snapshots before a move, and find the current entry again in the copied nodes.
+        void unshare()
+        {
+            if constexpr (PERSISTENT)
+            {
+                if (map_ == nullptr || (whole_ && generation_ == map_->tree_.generation()))
+                {
+                    return;
+                }
+
+                Tree& tree = map_->tree_;
+                if (it_ == tree.end())
+                {
+                    tree.unshare();
+                    it_ = tree.end();
+                }
+                else
+                {
+                    detail::MapEntry<K, V> key{it_->key()};
+                    tree.unshare();
+                    it_ = tree.find(key);
+                }
+                generation_ = tree.generation();
+                whole_ = true;
+            }
         }
     };
 
+    // Wrap the tree iterator for mutable access. For a persistent tree, only the path to the entry is copied out of the snapshots here,
+    // and the iterator copies the rest before its first move.
+    typename Map<K, V>::Iterator make_iterator(typename Tree::Iterator it)
+    {
+        if constexpr (PERSISTENT)
+        {
+            if (it != tree_.end())
+            {
+                it = tree_.find_unshared(*it);
+            }
+            return typename Map<K, V>::Iterator(Iter(std::move(it), this));
+        }
+        else
+        {
+            return typename Map<K, V>::Iterator(Iter(std::move(it)));
+        }
+    }
+
 public:
     /// @name Lifecycle
     /// @{
@@ -54,6 +157,17 @@ public:
         }
     }
 
+    /// Create a map of the key-value pairs of the range [first, last), built in O(N) if they are in ascending order of keys.
+    /// Of pairs with equal keys, the first one is kept.
+    template <std::input_iterator InputIt>
+    TreeMap(InputIt first, InputIt last)
+        : tree_()
+    {
+        auto entries = std::ranges::subrange(first, last) | std::views::transform([](const auto& pair)
+                                                                                  { return detail::MapEntry<K, V>{pair.first, pair.second}; });
+        tree_.build_from_sorted(entries.begin(), entries.end());
+    }
+
     TreeMap(const TreeMap&) = default;
     TreeMap(TreeMap&&) = default;
 
@@ -94,7 +208,15 @@ public:
     /// Return the reference of value for key if key is in the map, else throw exception.
     V& operator[](const K& key) override
     {
-        auto tree_it = tree_.find(detail::MapEntry<K, V>{key});
+        typename Tree::Iterator tree_it;
+        if constexpr (PERSISTENT)
+        {
+            tree_it = tree_.find_unshared(detail::MapEntry<K, V>{key});
+        }
+        else
+        {
+            tree_it = tree_.find(detail::MapEntry<K, V>{key});
+        }
         if (tree_it == tree_.end())
         {
             throw std::runtime_error("Error: The key-value pair does not exist.");
@@ -120,7 +242,7 @@ public:
     /// Return an iterator to the first element of the map.
     Map<K, V>::Iterator begin() override
     {
-        return typename Map<K, V>::Iterator(Iter(tree_.begin()));
+        return make_iterator(tree_.begin());
     }
 
     Map<K, V>::ConstIterator begin() const override
@@ -131,7 +253,7 @@ public:
     /// Return an iterator to the element following the last element of the map.
     Map<K, V>::Iterator end() override
     {
-        return typename Map<K, V>::Iterator(Iter(tree_.end()));
+        return make_iterator(tree_.end());
     }
 
     Map<K, V>::ConstIterator end() const override
@@ -152,7 +274,15 @@ public:
     /// Return an iterator to the first occurrence of the specified key, or end() if the map does not contains the key.
     Map<K, V>::Iterator find(const K& key) override
     {
-        return typename Map<K, V>::Iterator(Iter(tree_.find(detail::MapEntry<K, V>{key})));
+        if constexpr (PERSISTENT)
+        {
+            auto tree_it = tree_.find_unshared(detail::MapEntry<K, V>{key});
+            return typename Map<K, V>::Iterator(Iter(std::move(tree_it), this));
+        }
+        else
+        {
+            return make_iterator(tree_.find(detail::MapEntry<K, V>{key}));
+        }
     }
 
     /// Return a const iterator to the first occurrence of the specified key, or end() if the map does not contains the key.
@@ -160,6 +290,91 @@ public:
     {
         return tree_.find(detail::MapEntry<K, V>{key});
     }
+
+    /// Return an iterator to the first entry whose key is not less than the specified key, or end() if there is no such entry.
+    Map<K, V>::Iterator lower_bound(const K& key)
+    {
+        return make_iterator(tree_.lower_bound(detail::MapEntry<K, V>{key}));
+    }
+
+    Map<K, V>::ConstIterator lower_bound(const K& key) const
+    {
+        return tree_.lower_bound(detail::MapEntry<K, V>{key});
+    }
+
+    /// Return an iterator to the first entry whose key is greater than the specified key, or end() if there is no such entry.
+    Map<K, V>::Iterator upper_bound(const K& key)
+    {
+        return make_iterator(tree_.upper_bound(detail::MapEntry<K, V>{key}));
+    }
+
+    Map<K, V>::ConstIterator upper_bound(const K& key) const
+    {
+        return tree_.upper_bound(detail::MapEntry<K, V>{key});
+    }
+
+    /// Return the range of entries with the specified key, as the pair of lower_bound() and upper_bound().
+    std::pair<typename Map<K, V>::Iterator, typename Map<K, V>::Iterator> equal_range(const K& key)
+    {
+        return {lower_bound(key), upper_bound(key)};
+    }
+
+    std::pair<typename Map<K, V>::ConstIterator, typename Map<K, V>::ConstIterator> equal_range(const K& key) const
+    {
+        return {lower_bound(key), upper_bound(key)};
+    }
+
+    /// Return an iterator to the entry with the largest key not greater than the specified key, or end() if there is no such entry.
+    Map<K, V>::Iterator floor(const K& key)
+    {
+        return make_iterator(tree_.floor(detail::MapEntry<K, V>{key}));
+    }
+
+    Map<K, V>::ConstIterator floor(const K& key) const
+    {
+        return tree_.floor(detail::MapEntry<K, V>{key});
+    }
+
+    /// Return an iterator to the entry with the smallest key not less than the specified key, or end() if there is no such entry.
+    Map<K, V>::Iterator ceiling(const K& key)
+    {
+        return lower_bound(key);
+    }
+
+    Map<K, V>::ConstIterator ceiling(const K& key) const
+    {
+        return lower_bound(key);
+    }
+
+    /// Return a view of the entries with keys in the range [lo, hi), in O(log N + K) for K entries. Empty if !(lo < hi).
+    std::ranges::subrange<typename Map<K, V>::Iterator> range(const K& lo, const K& hi)
+    {
+        auto first = lower_bound(lo);
+        return {first, lo < hi ? lower_bound(hi) : first};
+    }
+
+    std::ranges::subrange<typename Map<K, V>::ConstIterator> range(const K& lo, const K& hi) const
+    {
+        return tree_.range(detail::MapEntry<K, V>{lo}, detail::MapEntry<K, V>{hi});
+    }
+
+    /// Return the number of keys less than the specified key, in O(log N). Require a tree with order statistics.
+    int rank(const K& key) const
+    {
+        return tree_.rank(detail::MapEntry<K, V>{key});
+    }
+
+    /// Return the entry with the k-th smallest key counting from 0, in O(log N). Throw if k is out of range. Require a tree with order statistics.
+    const Map<K, V>::Entry& select(int k) const
+    {
+        return tree_.select(k);
+    }
+
+    /// Return the number of keys in the range [lo, hi), in O(log N). Require a tree with order statistics.
+    int count_range(const K& lo, const K& hi) const
+    {
+        return tree_.count_range(detail::MapEntry<K, V>{lo}, detail::MapEntry<K, V>{hi});
+    }
     /// @}
 
     /// @name Manipulation
@@ -171,6 +386,22 @@ public:
         return tree_.insert(detail::MapEntry<K, V>{key, value});
     }
 
+    /// Insert a new key-value pair into the map, searching from the hint instead of the root. Return an iterator to the entry
+    /// with the key, newly inserted or already present. The hint must be an iterator of this map. Require a tree with hinted insertion.
+    Map<K, V>::Iterator insert(const typename Map<K, V>::Iterator& hint, const K& key, const V& value)
+    {
+        const Iter* it = hint.template target<Iter>();
+        auto tree_hint = it != nullptr ? static_cast<const typename Tree::Iterator&>(*it) : typename Tree::Iterator();
+        return make_iterator(tree_.insert(tree_hint, detail::MapEntry<K, V>{key, value}));
+    }
+
+    /// Set whether insert() searches from the place of the last insertion instead of the root, for nearly sorted keys.
+    /// Require a tree with finger search.
+    void set_finger_search(bool enabled)
+    {
+        tree_.set_finger_search(enabled);
+    }
+
     /// Remove the key-value pair corresponding to the key in the map. Return whether such a key was present.
     bool remove(const K& key) override
     {
@@ -14,7 +14,7 @@
 namespace hellods
 {
 
-/// Queue implemented by array.
+/// Queue implemented by array, on top of the power-of-two ring buffer of ArrayDeque.
 template <typename T>
 class ArrayQueue : public Queue<T>
 {
@@ -68,6 +68,13 @@ public:
     }
 
     using Queue<T>::front; // const
+
+    /// Return the elements as two contiguous segments in order: from the front to the end of the buffer, then the wrapped-around part.
+    /// The second segment is empty if the elements do not wrap around. The segments are invalidated by any change of the queue.
+    std::pair<std::span<const T>, std::span<const T>> segments() const
+    {
+        return deque_.segments();
+    }
     /// @}
 
     /// @name Examination
@@ -78,6 +85,12 @@ public:
     {
         return deque_.size();
     }
+
+    /// Get the number of elements that the queue can hold before growing.
+    int capacity() const
+    {
+        return deque_.capacity();
+    }
     /// @}
 
     /// @name Manipulation
@@ -95,12 +108,39 @@ public:
         return deque_.pop_front();
     }
 
+    /// Enqueue all elements in the range [first, last), growing the buffer at most once.
+    template <std::input_iterator InputIt>
+    void enqueue_range(InputIt first, InputIt last)
+    {
+        deque_.push_back_range(first, last);
+    }
+
+    /// Dequeue up to count front elements of the queue into the output iterator, return the number of dequeued elements.
+    template <std::output_iterator<T> OutputIt>
+    int dequeue_into(OutputIt out, int count)
+    {
+        return deque_.pop_front_n(out, count);
+    }
+
     /// Remove all of the elements from the queue.
     void clear() override
     {
         deque_.clear();
     }
 
+    /// Reduce the capacity to fit the elements, but not below the initial capacity.
+    void shrink_to_fit()
+    {
+        deque_.shrink_to_fit();
+    }
+
+    /// Turn automatic shrinking on or off (default off).
+    /// When on, a removal that leaves less than a quarter of the capacity in use shrinks it to about twice the number of elements.
+    void set_auto_shrink(bool enabled)
+    {
+        deque_.set_auto_shrink(enabled);
+    }
+
     /// @}
 };
 
@@ -0,0 +1,344 @@
+/**
+ * @file BlockingQueue.hpp
+ * @author Chen QingYu <chen_qingyu@qq.com>
+ * @brief Bounded blocking queue for producer/consumer pipelines.
+ * @date 2026.10.18
+ */
+
+#ifndef BLOCKINGQUEUE_HPP
+#define BLOCKINGQUEUE_HPP
+
+#include "ArrayQueue.hpp"
+#include "Queue.hpp"
+
+#include <chrono>             // std::chrono::duration
+#include <condition_variable> // std::condition_variable
+#include <mutex>              // std::mutex
+
+namespace hellods
+{
+
+/// Bounded blocking queue for producer/consumer pipelines, implemented by ArrayQueue guarded by a mutex.
+///
+/// enqueue() waits while the queue is full and dequeue() waits while it is empty, the try_*_for() variants give up after a timeout,
+/// and drain() takes a batch at once. close() shuts the queue down gracefully: producers are turned away,
+/// while consumers still receive the remaining elements and then see the end.
+///
+/// A thread signals the other side only if some thread of that side is waiting, which can only happen while the queue is empty or full,
+/// so a queue that stays in between never touches the condition variables, and each element wakes at most one waiter.
+/// Lifecycle operations, front(), comparison, iteration and printing require that no other thread is using the queue.
+template <typename T>
+class BlockingQueue : public Queue<T>
+{
+protected:
+    using Queue<T>::INIT_CAPACITY;
+    using Queue<T>::MAX_CAPACITY;
+
+    // Elements.
+    ArrayQueue<T> queue_;
+
+    // Maximum number of elements.
+    int capacity_;
+
+    // Whether the queue is closed.
+    bool closed_;
+
+    // Guards all of the above and the waiter counts.
+    mutable std::mutex mutex_;
+
+    // Signaled when an element is available or the queue is closed.
+    std::condition_variable not_empty_;
+
+    // Signaled when a slot is available or the queue is closed.
+    std::condition_variable not_full_;
+
+    // Number of consumers waiting on not_empty_.
+    int consumers_waiting_;
+
+    // Number of producers waiting on not_full_.
+    int producers_waiting_;
+
+    // A deadline that has always passed, for the variants that do not wait.
+    static constexpr std::chrono::steady_clock::time_point NO_WAIT{};
+
+    // Wait on the condition variable until the predicate holds, counted as a waiter meanwhile.
+    // Without a deadline, wait forever. Return false on timeout.
+    template <typename Predicate>
+    static bool await(std::unique_lock<std::mutex>& lock, std::condition_variable& cv, int& waiters, Predicate ready,
+                      std::optional<std::chrono::steady_clock::time_point> deadline = std::nullopt)
+    {
+        if (ready())
+        {
+            return true;
+        }
+
+        ++waiters;
+        bool satisfied = true;
+        if (deadline)
+        {
+            satisfied = cv.wait_until(lock, *deadline, ready);
+        }
+        else
+        {
+            cv.wait(lock, ready);
+        }
+        --waiters;
+        return satisfied;
+    }
+
+    // Wait for a slot and insert the element. Return false on timeout or if the queue is closed.
+    bool push(const T& element, std::optional<std::chrono::steady_clock::time_point> deadline)
+    {
+        std::unique_lock lock(mutex_);
+        auto ready = [&] { return closed_ || queue_.size() < capacity_; };
+        if (!await(lock, not_full_, producers_waiting_, ready, deadline) || closed_)
+        {
+            return false;
+        }
+
+        queue_.enqueue(element);
+        bool wake = consumers_waiting_ > 0;
+        lock.unlock();
+
+        if (wake)
+        {
+            not_empty_.notify_one();
+        }
+        return true;
+    }
+
+    // Wait for an element and pop it into the given reference. Return false on timeout or if the queue is closed and empty.
+    bool pop(T& element, std::optional<std::chrono::steady_clock::time_point> deadline)
+    {
+        std::unique_lock lock(mutex_);
+        auto ready = [&] { return closed_ || !queue_.is_empty(); };
+        if (!await(lock, not_empty_, consumers_waiting_, ready, deadline) || queue_.is_empty())
+        {
+            return false;
+        }
+
+        element = queue_.dequeue();
+        bool wake = producers_waiting_ > 0;
+        lock.unlock();
+
+        if (wake)
+        {
+            not_full_.notify_one();
+        }
+        return true;
+    }
+
+    // Swap with another queue.
+    void swap(BlockingQueue& that)
+    {
+        std::swap(queue_, that.queue_);
+        std::swap(capacity_, that.capacity_);
+        std::swap(closed_, that.closed_);
+    }
+
+public:
+    /// @name Lifecycle
+    /// @{
+
+    /// Create an empty open queue that holds at most the specified number of elements.
+    explicit BlockingQueue(int capacity = INIT_CAPACITY)
+        : capacity_(std::clamp(capacity, 1, int(MAX_CAPACITY)))
+        , closed_(false)
+        , consumers_waiting_(0)
+        , producers_waiting_(0)
+    {
+    }
+
+    /// Create a queue based on the given initializer list.
+    BlockingQueue(const std::initializer_list<T>& il)
+        : BlockingQueue(std::max(int(il.size()), int(INIT_CAPACITY)))
+    {
+        queue_.enqueue_range(il.begin(), il.end());
+    }
+
+    /// Copy constructor. The copy has the same capacity and is open or closed like the original.
+    BlockingQueue(const BlockingQueue& that)
+        : queue_(that.queue_)
+        , capacity_(that.capacity_)
+        , closed_(that.closed_)
+        , consumers_waiting_(0)
+        , producers_waiting_(0)
+    {
+    }
+
+    /// Move constructor.
+    BlockingQueue(BlockingQueue&& that)
+        : BlockingQueue()
+    {
+        swap(that);
+    }
+
+    BlockingQueue& operator=(BlockingQueue that)
+    {
+        swap(that);
+        return *this;
+    }
+    /// @}
+
+    /// @name Iterator
+    /// @{
+
+    /// Return an iterator to the first element of the queue.
+    Queue<T>::Iterator begin() const override
+    {
+        return queue_.begin();
+    }
+
+    /// Return an iterator to the element following the last element of the queue.
+    Queue<T>::Iterator end() const override
+    {
+        return queue_.end();
+    }
+    /// @}
+
+    /// @name Access
+    /// @{
+
+    /// Return the reference to the element at the front in the queue.
+    T& front() override
+    {
+        return queue_.front();
+    }
+
+    using Queue<T>::front; // const
+    /// @}
+
+    /// @name Examination
+    /// @{
+
+    /// Get the number of elements. A snapshot while other threads are operating.
+    int size() const override
+    {
+        std::lock_guard lock(mutex_);
+        return queue_.size();
+    }
+
+    /// Get the maximum number of elements.
+    int capacity() const
+    {
+        return capacity_;
+    }
+
+    /// Check if the queue is closed.
+    bool is_closed() const
+    {
+        std::lock_guard lock(mutex_);
+        return closed_;
+    }
+    /// @}
+
+    /// @name Manipulation
+    /// @{
+
+    /// Enqueue, insert an element at the rear of the queue, waiting while the queue is full.
+    /// Throw if the queue is closed.
+    void enqueue(const T& element) override
+    {
+        if (!push(element, std::nullopt))
+        {
+            throw std::runtime_error("Error: The queue is closed.");
+        }
+    }
+
+    /// Dequeue, pop the front element of the queue, waiting while the queue is empty.
+    /// Throw if the queue is closed and all elements have been taken.
+    T dequeue() override
+    {
+        T element;
+        if (!pop(element, std::nullopt))
+        {
+            throw std::runtime_error("Error: The queue is closed.");
+        }
+        return element;
+    }
+
+    /// Try to insert an element at the rear of the queue without waiting. Return false if the queue is full or closed.
+    bool try_enqueue(const T& element)
+    {
+        return push(element, NO_WAIT);
+    }
+
+    /// Try to pop the front element of the queue into the given reference without waiting.
+    /// Return false if the queue is empty.
+    bool try_dequeue(T& element)
+    {
+        return pop(element, NO_WAIT);
+    }
+
+    /// Try to insert an element at the rear of the queue, waiting at most the given time for a slot.
+    /// Return false on timeout or if the queue is closed.
+    template <typename Rep, typename Period>
+    bool try_enqueue_for(const T& element, const std::chrono::duration<Rep, Period>& timeout)
+    {
+        return push(element, std::chrono::steady_clock::now() + timeout);
+    }
+
+    /// Try to pop the front element of the queue into the given reference, waiting at most the given time for an element.
+    /// Return false on timeout or if the queue is closed and empty.
+    template <typename Rep, typename Period>
+    bool try_dequeue_for(T& element, const std::chrono::duration<Rep, Period>& timeout)
+    {
+        return pop(element, std::chrono::steady_clock::now() + timeout);
+    }
+
+    /// Wait until there is an element, then pop up to count front elements into the output iterator under one lock.
+    /// Return the number of popped elements, 0 only if the queue is closed and empty (or count <= 0).
+    template <std::output_iterator<T> OutputIt>
+    int drain(OutputIt out, int count)
+    {
+        if (count <= 0)
+        {
+            return 0;
+        }
+
+        std::unique_lock lock(mutex_);
+        await(lock, not_empty_, consumers_waiting_, [&] { return closed_ || !queue_.is_empty(); });
+
+        int n = queue_.dequeue_into(out, count);
+        bool wake = n > 0 && producers_waiting_ > 0;
+        lock.unlock();
+
+        // several slots may have been freed
+        if (wake)
+        {
+            not_full_.notify_all();
+        }
+        return n;
+    }
+
+    /// Close the queue. Waiting producers and later enqueues fail, consumers drain the remaining elements and then fail.
+    void close()
+    {
+        {
+            std::lock_guard lock(mutex_);
+            closed_ = true;
+        }
+        not_empty_.notify_all();
+        not_full_.notify_all();
+    }
+
+    /// Remove all of the elements from the queue.
+    void clear() override
+    {
+        std::unique_lock lock(mutex_);
+        queue_.clear();
+        bool wake = producers_waiting_ > 0;
+        lock.unlock();
+
+        if (wake)
+        {
+            not_full_.notify_all();
+        }
+    }
+
+    /// @}
+};
+
+} // namespace hellods
+
+#endif // BLOCKINGQUEUE_HPP
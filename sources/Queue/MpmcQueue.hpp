@@ -0,0 +1,422 @@
+/**
+ * @file MpmcQueue.hpp
+ * @author Chen QingYu <chen_qingyu@qq.com>
+ * @brief Bounded lock-free multi-producer multi-consumer queue implemented by ring buffer.
+ * @date 2026.10.18
+ */
+
+#ifndef MPMCQUEUE_HPP
+#define MPMCQUEUE_HPP
+
+#include "Queue.hpp"
+
+#include <thread> // std::this_thread::yield
+
+namespace hellods
+{
+
+/// Bounded lock-free multi-producer multi-consumer queue implemented by ring buffer.
+///
+/// Any number of threads may enqueue and dequeue concurrently. Each slot of the ring buffer carries a sequence number
+/// that tells which lap of the ring may use it next (D. Vyukov's bounded MPMC queue), so a thread claims a slot with one CAS
+/// on the shared position and then fills or drains it without touching the other side.
+/// The capacity is fixed and rounded up to a power of two.
+///
+/// try_enqueue() and try_dequeue() never block. enqueue_wait() and dequeue_wait() take a ticket and wait for their slot,
+/// spinning and yielding for a short while and then parking the thread until the slot is ready.
+/// A thread only notifies a slot while some thread is parked, so the non-blocking path never touches the shared waiter pool of the standard library.
+/// Lifecycle operations, front(), comparison, iteration and printing require that no other thread is using the queue.
+template <typename T>
+class MpmcQueue : public Queue<T>
+{
+protected:
+    // Slot of the ring buffer.
+    struct Slot
+    {
+        // Position that may use the slot next: pos for enqueue, pos + 1 for dequeue.
+        std::atomic<std::size_t> sequence_;
+
+        // Data stored in the slot.
+        T data_;
+    };
+
+    template <bool Const>
+    class Iter
+    {
+        friend class MpmcQueue;
+
+    protected:
+        using Value = std::conditional_t<Const, const T, T>;
+        using SlotPtr = std::conditional_t<Const, const Slot*, Slot*>;
+
+        // Virtual position, wrapped by the mask on dereference.
+        std::size_t current_;
+
+        // Begin of the ring buffer.
+        SlotPtr slots_;
+
+        // Capacity of the ring buffer - 1.
+        std::size_t mask_;
+
+        // Create an iterator that point to the current slot of queue.
+        Iter(std::size_t current, SlotPtr slots, std::size_t mask)
+            : current_(current)
+            , slots_(slots)
+            , mask_(mask)
+        {
+        }
+
+    public:
+        /// Dereference.
+        Value& operator*() const
+        {
+            return slots_[current_ & mask_].data_;
+        }
+
+        /// Check if two iterators are same.
+        bool operator==(const Iter& that) const
+        {
+            return current_ == that.current_;
+        }
+
+        /// Increment the iterator.
+        Iter& operator++()
+        {
+            ++current_;
+            return *this;
+        }
+
+        /// Decrement the iterator.
+        Iter& operator--()
+        {
+            --current_;
+            return *this;
+        }
+    };
+
+protected:
+    using Queue<T>::INIT_CAPACITY;
+
+    // Maximum capacity, the largest power of two within the limit of the base.
+    static constexpr int MAX_CAPACITY = int(std::bit_floor(unsigned(Queue<T>::MAX_CAPACITY)));
+
+    // Number of checks before a waiting thread parks, the second half yields between checks.
+    static constexpr int SPIN_LIMIT = 64;
+
+    // Position of the next enqueue.
+    alignas(detail::CACHE_LINE_SIZE) std::atomic<std::size_t> enqueue_pos_;
+
+    // Position of the next dequeue.
+    alignas(detail::CACHE_LINE_SIZE) std::atomic<std::size_t> dequeue_pos_;
+
+    // Number of parked threads.
+    alignas(detail::CACHE_LINE_SIZE) std::atomic<int> waiters_;
+
+    // Available capacity, always a power of two. Read-only after construction.
+    alignas(detail::CACHE_LINE_SIZE) int capacity_;
+
+    // Pointer to ring buffer.
+    Slot* slots_;
+
+    // Capacity - 1, to wrap a position into the ring buffer.
+    std::size_t mask() const
+    {
+        return std::size_t(capacity_) - 1;
+    }
+
+    // Wait until the sequence reaches the expected value, spinning and yielding briefly before parking the thread.
+    void await(const std::atomic<std::size_t>& sequence, std::size_t expected)
+    {
+        for (int i = 0; i < SPIN_LIMIT; ++i)
+        {
+            if (sequence.load(std::memory_order_acquire) == expected)
+            {
+                return;
+            }
+            if (i >= SPIN_LIMIT / 2)
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        // seq_cst pairs with publish(): either the publisher sees this waiter, or this waiter sees the new sequence
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+        for (std::size_t seq; (seq = sequence.load(std::memory_order_seq_cst)) != expected;)
+        {
+            sequence.wait(seq, std::memory_order_acquire);
+        }
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // Store the new sequence of a slot, and wake the parked threads if there are any.
+    void publish(std::atomic<std::size_t>& sequence, std::size_t value)
+    {
+        sequence.store(value, std::memory_order_seq_cst);
+        if (waiters_.load(std::memory_order_seq_cst) > 0)
+        {
+            sequence.notify_all();
+        }
+    }
+
+    // Claim the front slot for a dequeue and store its position, return nullptr if the queue is empty.
+    Slot* claim_dequeue(std::size_t& pos)
+    {
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Slot* slot = &slots_[pos & mask()];
+            std::ptrdiff_t diff = std::ptrdiff_t(slot->sequence_.load(std::memory_order_acquire) - (pos + 1));
+            if (diff == 0) // filled in this lap, try to claim it
+            {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    return slot;
+                }
+            }
+            else if (diff < 0) // not filled yet
+            {
+                return nullptr;
+            }
+            else // claimed by another consumer
+            {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Hand a drained slot over to the enqueue of the next lap.
+    void release_dequeue(Slot& slot, std::size_t pos)
+    {
+        publish(slot.sequence_, pos + capacity_);
+    }
+
+    // Swap with another queue.
+    void swap(MpmcQueue& that)
+    {
+        enqueue_pos_.store(that.enqueue_pos_.exchange(enqueue_pos_.load()));
+        dequeue_pos_.store(that.dequeue_pos_.exchange(dequeue_pos_.load()));
+        std::swap(capacity_, that.capacity_);
+        std::swap(slots_, that.slots_);
+    }
+
+public:
+    /// @name Lifecycle
+    /// @{
+
+    /// Create an empty queue with the specified capacity, rounded up to a power of two.
+    explicit MpmcQueue(int capacity = INIT_CAPACITY)
+        : enqueue_pos_(0)
+        , dequeue_pos_(0)
+        , waiters_(0)
+        , capacity_(int(std::bit_ceil(unsigned(std::clamp(capacity, 1, MAX_CAPACITY)))))
+        , slots_(new Slot[capacity_])
+    {
+        for (int i = 0; i < capacity_; ++i)
+        {
+            slots_[i].sequence_.store(std::size_t(i), std::memory_order_relaxed);
+        }
+    }
+
+    /// Create a queue based on the given initializer list.
+    MpmcQueue(const std::initializer_list<T>& il)
+        : MpmcQueue(std::max(int(il.size()), int(INIT_CAPACITY)))
+    {
+        for (auto it = il.begin(); it != il.end(); ++it)
+        {
+            try_enqueue(*it);
+        }
+    }
+
+    /// Copy constructor. The copy has the same capacity.
+    MpmcQueue(const MpmcQueue& that)
+        : MpmcQueue(that.capacity_)
+    {
+        for (auto it = that.begin(); it != that.end(); ++it)
+        {
+            try_enqueue(*it);
+        }
+    }
+
+    /// Move constructor.
+    MpmcQueue(MpmcQueue&& that)
+        : MpmcQueue()
+    {
+        swap(that);
+    }
+
+    MpmcQueue& operator=(MpmcQueue that)
+    {
+        swap(that);
+        return *this;
+    }
+
+    /// Destroy the queue object.
+    ~MpmcQueue()
+    {
+        delete[] slots_;
+    }
+    /// @}
+
+    /// @name Iterator
+    /// @{
+
+    /// Return an iterator to the first element of the queue.
+    Queue<T>::Iterator begin() const override
+    {
+        return typename Queue<T>::Iterator(Iter<true>(dequeue_pos_.load(std::memory_order_acquire), slots_, mask()));
+    }
+
+    /// Return an iterator to the element following the last element of the queue.
+    Queue<T>::Iterator end() const override
+    {
+        return typename Queue<T>::Iterator(Iter<true>(dequeue_pos_.load(std::memory_order_acquire) + size(), slots_, mask()));
+    }
+    /// @}
+
+    /// @name Access
+    /// @{
+
+    /// Return the reference to the element at the front in the queue.
+    T& front() override
+    {
+        detail::check_empty(size());
+        return slots_[dequeue_pos_.load(std::memory_order_acquire) & mask()].data_;
+    }
+
+    using Queue<T>::front; // const
+    /// @}
+
+    /// @name Examination
+    /// @{
+
+    /// Get the number of elements. A snapshot while other threads are operating.
+    int size() const override
+    {
+        std::size_t dequeue_pos = dequeue_pos_.load(std::memory_order_acquire);
+        std::size_t enqueue_pos = enqueue_pos_.load(std::memory_order_acquire);
+
+        // waiting dequeuers may hold tickets ahead of the enqueue position
+        std::ptrdiff_t size = std::ptrdiff_t(enqueue_pos - dequeue_pos);
+        return int(std::clamp(size, std::ptrdiff_t(0), std::ptrdiff_t(capacity_)));
+    }
+
+    /// Get the fixed capacity.
+    int capacity() const
+    {
+        return capacity_;
+    }
+    /// @}
+
+    /// @name Manipulation
+    /// @{
+
+    /// Try to insert an element at the rear of the queue, return false if the queue is full.
+    bool try_enqueue(const T& element)
+    {
+        std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        Slot* slot;
+        while (true)
+        {
+            slot = &slots_[pos & mask()];
+            std::ptrdiff_t diff = std::ptrdiff_t(slot->sequence_.load(std::memory_order_acquire) - pos);
+            if (diff == 0) // free in this lap, try to claim it
+            {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0) // still holds the element of the previous lap
+            {
+                return false;
+            }
+            else // claimed by another producer
+            {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->data_ = element;
+        publish(slot->sequence_, pos + 1);
+        return true;
+    }
+
+    /// Try to pop the front element of the queue into the given reference, return false if the queue is empty.
+    bool try_dequeue(T& element)
+    {
+        std::size_t pos;
+        Slot* slot = claim_dequeue(pos);
+        if (slot == nullptr)
+        {
+            return false;
+        }
+
+        element = std::move(slot->data_);
+        release_dequeue(*slot, pos);
+        return true;
+    }
+
+    /// Insert an element at the rear of the queue, waiting while the queue is full.
+    void enqueue_wait(const T& element)
+    {
+        std::size_t pos = enqueue_pos_.fetch_add(1, std::memory_order_relaxed);
+        Slot& slot = slots_[pos & mask()];
+        await(slot.sequence_, pos);
+
+        slot.data_ = element;
+        publish(slot.sequence_, pos + 1);
+    }
+
+    /// Pop the front element of the queue, waiting while the queue is empty.
+    T dequeue_wait()
+    {
+        std::size_t pos = dequeue_pos_.fetch_add(1, std::memory_order_relaxed);
+        Slot& slot = slots_[pos & mask()];
+        await(slot.sequence_, pos + 1);
+
+        T element = std::move(slot.data_);
+        release_dequeue(slot, pos);
+        return element;
+    }
+
+    /// Enqueue, insert an element at the rear of the queue.
+    void enqueue(const T& element) override
+    {
+        if (!try_enqueue(element))
+        {
+            detail::check_full(capacity_, capacity_); // throws
+        }
+    }
+
+    /// Dequeue, pop the front element of the queue.
+    T dequeue() override
+    {
+        std::size_t pos;
+        Slot* slot = claim_dequeue(pos);
+        if (slot == nullptr)
+        {
+            detail::check_empty(0); // throws
+        }
+
+        T element = std::move(slot->data_);
+        release_dequeue(*slot, pos);
+        return element;
+    }
+
+    /// Remove all of the elements from the queue. Elements enqueued concurrently may remain.
+    void clear() override
+    {
+        std::size_t pos;
+        for (Slot* slot; (slot = claim_dequeue(pos)) != nullptr;)
+        {
+            T(std::move(slot->data_)); // release the resources of the element
+            release_dequeue(*slot, pos);
+        }
+    }
+
+    /// @}
+};
+
+} // namespace hellods
+
+#endif // MPMCQUEUE_HPP
@@ -0,0 +1,319 @@
+/**
+ * @file SpscQueue.hpp
+ * @author Chen QingYu <chen_qingyu@qq.com>
+ * @brief Lock-free single-producer single-consumer queue implemented by ring buffer.
+ * @date 2026.10.18
+ */
+
+#ifndef SPSCQUEUE_HPP
+#define SPSCQUEUE_HPP
+
+#include "Queue.hpp"
+
+namespace hellods
+{
+
+/// Lock-free single-producer single-consumer queue implemented by ring buffer.
+///
+/// One thread may enqueue while another thread dequeues, without locks. The capacity is fixed and rounded up to a power of two.
+/// The head and tail indices live on separate cache lines and are published with acquire/release atomics,
+/// and each side keeps a cached copy of the opposite index, so it only touches the other side's cache line when the cached copy says full or empty.
+///
+/// The producer calls try_enqueue() and enqueue(), the consumer calls try_dequeue(), dequeue_bulk(), dequeue(), front() and clear().
+/// Lifecycle operations, comparison, iteration and printing require that no other thread is using the queue.
+template <typename T>
+class SpscQueue : public Queue<T>
+{
+protected:
+    template <bool Const>
+    class Iter
+    {
+        friend class SpscQueue;
+
+    protected:
+        using Value = std::conditional_t<Const, const T, T>;
+
+        // Virtual index, wrapped by the mask on dereference.
+        std::size_t current_;
+
+        // Begin of the ring buffer.
+        Value* buffer_;
+
+        // Capacity of the ring buffer - 1.
+        std::size_t mask_;
+
+        // Create an iterator that point to the current data of queue.
+        Iter(std::size_t current, Value* buffer, std::size_t mask)
+            : current_(current)
+            , buffer_(buffer)
+            , mask_(mask)
+        {
+        }
+
+    public:
+        /// Dereference.
+        Value& operator*() const
+        {
+            return buffer_[current_ & mask_];
+        }
+
+        /// Check if two iterators are same.
+        bool operator==(const Iter& that) const
+        {
+            return current_ == that.current_;
+        }
+
+        /// Increment the iterator.
+        Iter& operator++()
+        {
+            ++current_;
+            return *this;
+        }
+
+        /// Decrement the iterator.
+        Iter& operator--()
+        {
+            --current_;
+            return *this;
+        }
+    };
+
+protected:
+    using Queue<T>::INIT_CAPACITY;
+
+    // Maximum capacity, the largest power of two within the limit of the base.
+    static constexpr int MAX_CAPACITY = int(std::bit_floor(unsigned(Queue<T>::MAX_CAPACITY)));
+
+    // Index of the next element to dequeue. Written by the consumer only.
+    alignas(detail::CACHE_LINE_SIZE) std::atomic<std::size_t> head_;
+
+    // Consumer's copy of tail_, refreshed only when the queue looks empty.
+    std::size_t cached_tail_;
+
+    // Index of the next slot to enqueue. Written by the producer only.
+    alignas(detail::CACHE_LINE_SIZE) std::atomic<std::size_t> tail_;
+
+    // Producer's copy of head_, refreshed only when the queue looks full.
+    std::size_t cached_head_;
+
+    // Available capacity, always a power of two. Read-only after construction.
+    alignas(detail::CACHE_LINE_SIZE) int capacity_;
+
+    // Pointer to ring buffer.
+    T* data_;
+
+    // Capacity - 1, to wrap an index into the ring buffer.
+    std::size_t mask() const
+    {
+        return std::size_t(capacity_) - 1;
+    }
+
+    // Swap with another queue.
+    void swap(SpscQueue& that)
+    {
+        head_.store(that.head_.exchange(head_.load()));
+        tail_.store(that.tail_.exchange(tail_.load()));
+        std::swap(cached_tail_, that.cached_tail_);
+        std::swap(cached_head_, that.cached_head_);
+        std::swap(capacity_, that.capacity_);
+        std::swap(data_, that.data_);
+    }
+
+public:
+    /// @name Lifecycle
+    /// @{
+
+    /// Create an empty queue with the specified capacity, rounded up to a power of two.
+    explicit SpscQueue(int capacity = INIT_CAPACITY)
+        : head_(0)
+        , cached_tail_(0)
+        , tail_(0)
+        , cached_head_(0)
+        , capacity_(int(std::bit_ceil(unsigned(std::clamp(capacity, 1, MAX_CAPACITY)))))
+        , data_(new T[capacity_])
+    {
+    }
+
+    /// Create a queue based on the given initializer list.
+    SpscQueue(const std::initializer_list<T>& il)
+        : SpscQueue(std::max(int(il.size()), int(INIT_CAPACITY)))
+    {
+        for (auto it = il.begin(); it != il.end(); ++it)
+        {
+            try_enqueue(*it);
+        }
+    }
+
+    /// Copy constructor. The copy has the same capacity.
+    SpscQueue(const SpscQueue& that)
+        : SpscQueue(that.capacity_)
+    {
+        for (auto it = that.begin(); it != that.end(); ++it)
+        {
+            try_enqueue(*it);
+        }
+    }
+
+    /// Move constructor.
+    SpscQueue(SpscQueue&& that)
+        : SpscQueue()
+    {
+        swap(that);
+    }
+
+    SpscQueue& operator=(SpscQueue that)
+    {
+        swap(that);
+        return *this;
+    }
+
+    /// Destroy the queue object.
+    ~SpscQueue()
+    {
+        delete[] data_;
+    }
+    /// @}
+
+    /// @name Iterator
+    /// @{
+
+    /// Return an iterator to the first element of the queue.
+    Queue<T>::Iterator begin() const override
+    {
+        return typename Queue<T>::Iterator(Iter<true>(head_.load(std::memory_order_acquire), data_, mask()));
+    }
+
+    /// Return an iterator to the element following the last element of the queue.
+    Queue<T>::Iterator end() const override
+    {
+        return typename Queue<T>::Iterator(Iter<true>(tail_.load(std::memory_order_acquire), data_, mask()));
+    }
+    /// @}
+
+    /// @name Access
+    /// @{
+
+    /// Return the reference to the element at the front in the queue. Consumer side.
+    T& front() override
+    {
+        std::size_t head = head_.load(std::memory_order_relaxed);
+        detail::check_empty(int(tail_.load(std::memory_order_acquire) - head));
+        return data_[head & mask()];
+    }
+
+    using Queue<T>::front; // const
+    /// @}
+
+    /// @name Examination
+    /// @{
+
+    /// Get the number of elements. Exact on either side when the other side is idle, a snapshot otherwise.
+    int size() const override
+    {
+        std::size_t head = head_.load(std::memory_order_acquire);
+        return int(tail_.load(std::memory_order_acquire) - head);
+    }
+
+    /// Get the fixed capacity.
+    int capacity() const
+    {
+        return capacity_;
+    }
+    /// @}
+
+    /// @name Manipulation
+    /// @{
+
+    /// Try to insert an element at the rear of the queue, return false if the queue is full. Producer side.
+    bool try_enqueue(const T& element)
+    {
+        std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ == std::size_t(capacity_))
+        {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ == std::size_t(capacity_))
+            {
+                return false;
+            }
+        }
+
+        data_[tail & mask()] = element;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Try to pop the front element of the queue into the given reference, return false if the queue is empty. Consumer side.
+    bool try_dequeue(T& element)
+    {
+        std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cached_tail_)
+        {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_)
+            {
+                return false;
+            }
+        }
+
+        element = std::move(data_[head & mask()]);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Pop up to count front elements of the queue into the output iterator, return the number of popped elements. Consumer side.
+    /// The elements are claimed with a single update of the head index.
+    template <std::output_iterator<T> OutputIt>
+    int dequeue_bulk(OutputIt out, int count)
+    {
+        std::size_t head = head_.load(std::memory_order_relaxed);
+        if (cached_tail_ - head < std::size_t(count))
+        {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+        }
+
+        int n = int(std::min(cached_tail_ - head, std::size_t(std::max(count, 0))));
+        for (int i = 0; i < n; ++i)
+        {
+            *out++ = std::move(data_[(head + i) & mask()]);
+        }
+        head_.store(head + n, std::memory_order_release);
+        return n;
+    }
+
+    /// Enqueue, insert an element at the rear of the queue. Producer side.
+    void enqueue(const T& element) override
+    {
+        // the producer never sees more elements than there are, so passing the check leaves room
+        detail::check_full(size(), capacity_);
+        try_enqueue(element);
+    }
+
+    /// Dequeue, pop the front element of the queue. Consumer side.
+    T dequeue() override
+    {
+        // the consumer never sees fewer elements than there are, so passing the check leaves one to pop
+        std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cached_tail_)
+        {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+        }
+        detail::check_empty(int(cached_tail_ - head));
+
+        T element = std::move(data_[head & mask()]);
+        head_.store(head + 1, std::memory_order_release);
+        return element;
+    }
+
+    /// Remove all of the elements from the queue. Consumer side, elements enqueued concurrently may remain.
+    void clear() override
+    {
+        cached_tail_ = tail_.load(std::memory_order_acquire);
+        head_.store(cached_tail_, std::memory_order_release);
+    }
+
+    /// @}
+};
+
+} // namespace hellods
+
+#endif // SPSCQUEUE_HPP
@@ -0,0 +1,110 @@
+/**
+ * @file UnrolledQueue.hpp
+ * @author Chen QingYu <chen_qingyu@qq.com>
+ * @brief Queue implemented by unrolled (chunked) linked list.
+ * @date 2026.10.18
+ */
+
+#ifndef UNROLLEDQUEUE_HPP
+#define UNROLLEDQUEUE_HPP
+
+#include "../Deque/UnrolledDeque.hpp"
+#include "Queue.hpp"
+
+namespace hellods
+{
+
+/// Queue implemented by unrolled (chunked) linked list, on top of UnrolledDeque.
+/// It grows without bound like LinkedQueue, but allocates once per chunk instead of once per element.
+template <typename T>
+class UnrolledQueue : public Queue<T>
+{
+    UnrolledDeque<T> deque_;
+
+public:
+    using Iterator = typename Queue<T>::Iterator;
+
+    /// @name Lifecycle
+    /// @{
+
+    /// Create an empty queue.
+    UnrolledQueue() = default;
+
+    /// Create a queue based on the given initializer list.
+    UnrolledQueue(const std::initializer_list<T>& il)
+        : deque_(il)
+    {
+    }
+
+    UnrolledQueue(const UnrolledQueue&) = default;
+    UnrolledQueue(UnrolledQueue&&) = default;
+
+    UnrolledQueue& operator=(const UnrolledQueue&) = default;
+    UnrolledQueue& operator=(UnrolledQueue&&) = default;
+    /// @}
+
+    /// @name Iterator
+    /// @{
+
+    /// Return an iterator to the first element of the queue.
+    Iterator begin() const override
+    {
+        return deque_.begin();
+    }
+
+    /// Return an iterator to the element following the last element of the queue.
+    Iterator end() const override
+    {
+        return deque_.end();
+    }
+    /// @}
+
+    /// @name Access
+    /// @{
+
+    /// Return the reference to the element at the front in the queue.
+    T& front() override
+    {
+        return deque_.front();
+    }
+
+    using Queue<T>::front; // const
+    /// @}
+
+    /// @name Examination
+    /// @{
+
+    /// Get the number of elements.
+    int size() const override
+    {
+        return deque_.size();
+    }
+    /// @}
+
+    /// @name Manipulation
+    /// @{
+
+    /// Enqueue, insert an element at the rear of the queue.
+    void enqueue(const T& element) override
+    {
+        deque_.push_back(element);
+    }
+
+    /// Dequeue, pop the front element of the queue.
+    T dequeue() override
+    {
+        return deque_.pop_front();
+    }
+
+    /// Remove all of the elements from the queue.
+    void clear() override
+    {
+        deque_.clear();
+    }
+
+    /// @}
+};
+
+} // namespace hellods
+
+#endif // UNROLLEDQUEUE_HPP
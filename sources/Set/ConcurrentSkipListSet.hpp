@@ -0,0 +1,792 @@
+/**
+ * @file ConcurrentSkipListSet.hpp
+ * @author Chen QingYu <chen_qingyu@qq.com>
+ * @brief Lock-free ordered set implemented by skip list, with epoch-based reclamation.
+ * @date 2026.10.18
+ */
+
+#ifndef CONCURRENTSKIPLISTSET_HPP
+#define CONCURRENTSKIPLISTSET_HPP
+
+#include "Set.hpp"
+
+#include <new>    // std::align_val_t
+#include <vector> // std::vector
+
+namespace hellods::detail
+{
+
+// Epoch-based reclamation of the nodes unlinked from lock-free structures, shared by all of them.
+//
+// A thread announces the global epoch while it may hold pointers to shared nodes, between entering and leaving a critical section,
+// and a node that has been unlinked is retired with the epoch of the moment. The global epoch advances only once every thread
+// in a critical section has announced it, so when it is two epochs ahead of a retired node, no thread can still reach the node.
+class EpochDomain
+{
+public:
+    // A node waiting to be freed, with its deleter and the epoch when it was retired.
+    struct Retired
+    {
+        void* ptr_;
+        void (*deleter_)(void*);
+        std::uint64_t epoch_;
+    };
+
+    // Record of a thread, reused by later threads after the owner exits, and freed with the domain.
+    struct alignas(CACHE_LINE_SIZE) Record
+    {
+        // Announced epoch, or IDLE outside critical sections.
+        std::atomic<std::uint64_t> epoch_;
+
+        // Whether a thread owns the record.
+        std::atomic<bool> in_use_;
+
+        // Next record, fixed once the record is published.
+        Record* next_;
+
+        // Depth of nested critical sections, used only by the owner.
+        int depth_;
+
+        // Retired nodes in order of retirement, used only by the owner and inherited by the next one.
+        std::vector<Retired> retired_;
+    };
+
+private:
+    // Epoch announced outside critical sections.
+    static constexpr std::uint64_t IDLE = UINT64_MAX;
+
+    // Number of retired nodes of a thread that triggers an attempt to advance the epoch and free them.
+    static constexpr std::size_t COLLECT_THRESHOLD = 64;
+
+    // Releases the record of a thread when it exits.
+    struct Owner
+    {
+        Record* record_;
+
+        ~Owner()
+        {
+            instance().release(record_);
+        }
+    };
+
+    // Global epoch.
+    alignas(CACHE_LINE_SIZE) std::atomic<std::uint64_t> epoch_;
+
+    // Records of all threads that have ever entered, as a list that only grows.
+    alignas(CACHE_LINE_SIZE) std::atomic<Record*> records_;
+
+    EpochDomain()
+        : epoch_(0)
+        , records_(nullptr)
+    {
+    }
+
+    // Take a free record, or publish a new one.
+    Record* acquire()
+    {
+        for (Record* record = records_.load(); record != nullptr; record = record->next_)
+        {
+            bool free = false;
+            if (!record->in_use_.load(std::memory_order_relaxed) && record->in_use_.compare_exchange_strong(free, true, std::memory_order_acquire))
+            {
+                return record;
+            }
+        }
+
+        Record* record = new Record{{IDLE}, {true}, records_.load(), 0, {}};
+        while (!records_.compare_exchange_weak(record->next_, record))
+        {
+        }
+        return record;
+    }
+
+    // Give up the record of an exiting thread, leaving what cannot be freed yet to the next owner.
+    // Also free what can be freed of the records given up before, which may not be taken again soon.
+    void release(Record* record)
+    {
+        // two advances free everything, unless other threads are in critical sections meanwhile
+        for (int i = 0; i < 2; ++i)
+        {
+            try_advance();
+        }
+        collect(*record);
+        record->in_use_.store(false, std::memory_order_release);
+
+        for (Record* other = records_.load(); other != nullptr; other = other->next_)
+        {
+            bool free = false;
+            if (other->in_use_.compare_exchange_strong(free, true, std::memory_order_acquire))
+            {
+                collect(*other);
+                other->in_use_.store(false, std::memory_order_release);
+            }
+        }
+    }
+
+    // Advance the global epoch if every thread in a critical section has announced it.
+    void try_advance()
+    {
+        std::uint64_t epoch = epoch_.load();
+        for (Record* record = records_.load(); record != nullptr; record = record->next_)
+        {
+            std::uint64_t announced = record->epoch_.load();
+            if (announced != IDLE && announced != epoch)
+            {
+                return;
+            }
+        }
+        epoch_.compare_exchange_strong(epoch, epoch + 1);
+    }
+
+    // Free the retired nodes of the record that no thread can reach any more.
+    void collect(Record& record)
+    {
+        std::uint64_t epoch = epoch_.load();
+        auto safe = std::find_if(record.retired_.begin(), record.retired_.end(), [=](const Retired& node)
+                                 { return node.epoch_ + 2 > epoch; });
+        for (auto it = record.retired_.begin(); it != safe; ++it)
+        {
+            it->deleter_(it->ptr_);
+        }
+        record.retired_.erase(record.retired_.begin(), safe);
+    }
+
+public:
+    EpochDomain(const EpochDomain&) = delete;
+    EpochDomain& operator=(const EpochDomain&) = delete;
+
+    // Free all records and the nodes left in them, when no other thread is running.
+    ~EpochDomain()
+    {
+        for (Record* record = records_.load(); record != nullptr;)
+        {
+            for (const Retired& node : record->retired_)
+            {
+                node.deleter_(node.ptr_);
+            }
+            delete std::exchange(record, record->next_);
+        }
+    }
+
+    // Return the domain of the program.
+    static EpochDomain& instance()
+    {
+        static EpochDomain domain;
+        return domain;
+    }
+
+    // Return the record of the calling thread.
+    Record& record()
+    {
+        thread_local Owner owner{acquire()};
+        return *owner.record_;
+    }
+
+    // Enter a critical section of the thread of the record, which may be nested.
+    // The announcement and the loads of shared links that follow it are sequentially consistent,
+    // so a thread that unlinks a node and then reads the epoch cannot miss the announcement of a thread that still reaches the node.
+    void enter(Record& record)
+    {
+        if (record.depth_++ == 0)
+        {
+            record.epoch_.store(epoch_.load());
+        }
+    }
+
+    // Leave a critical section of the thread of the record.
+    void leave(Record& record)
+    {
+        if (--record.depth_ == 0)
+        {
+            record.epoch_.store(IDLE, std::memory_order_release);
+        }
+    }
+
+    // Retire an unlinked node inside a critical section, to be freed by the deleter once no thread can reach it.
+    void retire(Record& record, void* ptr, void (*deleter)(void*))
+    {
+        record.retired_.push_back({ptr, deleter, epoch_.load()});
+        if (record.retired_.size() >= COLLECT_THRESHOLD)
+        {
+            try_advance();
+            collect(record);
+        }
+    }
+};
+
+// Critical section of the calling thread for the lifetime of the object, within which shared nodes are not freed.
+class EpochGuard
+{
+    EpochDomain::Record& record_;
+
+public:
+    EpochGuard()
+        : record_(EpochDomain::instance().record())
+    {
+        EpochDomain::instance().enter(record_);
+    }
+
+    EpochGuard(const EpochGuard&) = delete;
+    EpochGuard& operator=(const EpochGuard&) = delete;
+
+    ~EpochGuard()
+    {
+        EpochDomain::instance().leave(record_);
+    }
+
+    // Retire an unlinked node, to be freed by the deleter once no thread can reach it.
+    void retire(void* ptr, void (*deleter)(void*)) const
+    {
+        EpochDomain::instance().retire(record_, ptr, deleter);
+    }
+};
+
+} // namespace hellods::detail
+
+namespace hellods
+{
+
+/// Lock-free ordered set implemented by skip list, with epoch-based reclamation.
+///
+/// Any number of threads may insert, remove, search and iterate concurrently. Each node is linked at level 0 and,
+/// with probability 1/2 per level, at the levels above, so a search skips down from the top level in O(log N) expected steps.
+/// A node is inserted by one CAS at level 0 and then linked at the upper levels one by one. It is removed by marking its links
+/// from the top level down, the mark at level 0 deciding which thread removes it, and later searches unlink marked nodes as they pass.
+/// Since no rebalancing ever moves other nodes, threads working on different keys do not interfere.
+///
+/// Unlinked nodes are freed by epoch-based reclamation once no thread can be reading them. Iterators are weakly consistent:
+/// they never fail and see every element present during the whole scan, and each one keeps the nodes it may reach from being freed
+/// until it is destroyed, so it must stay on the thread that created it and should not be kept for long.
+/// Lifecycle operations, comparison and printing require that no other thread is using the set.
+template <typename T>
+class ConcurrentSkipListSet : public Set<T>
+{
+protected:
+    // Link to the next node at a level, with the low bit marking the node that holds it as removed.
+    using Link = std::atomic<std::uintptr_t>;
+
+    // Node of the skip list, followed in the same allocation by its links from level 0 up.
+    struct alignas(Link) Node
+    {
+        // Data stored in the node.
+        T data_;
+
+        // Number of levels of the node.
+        int height_;
+
+        // Number of the inserting and removing threads that are not done with the node yet, the last one retires it.
+        std::atomic<int> owners_;
+
+        // Links of the node.
+        Link* next()
+        {
+            return reinterpret_cast<Link*>(this + 1);
+        }
+    };
+
+    class Iter
+    {
+        friend class ConcurrentSkipListSet;
+
+    protected:
+        // The set.
+        const ConcurrentSkipListSet* set_;
+
+        // Current node, nullptr for the end.
+        Node* node_;
+
+        // Keeps the reachable nodes from being freed, shared by the copies of the iterator.
+        std::shared_ptr<const detail::EpochGuard> guard_;
+
+        // Create an iterator that point to the node, protected by the guard.
+        Iter(const ConcurrentSkipListSet* set, Node* node, std::shared_ptr<const detail::EpochGuard> guard)
+            : set_(set)
+            , node_(node)
+            , guard_(std::move(guard))
+        {
+        }
+
+    public:
+        /// Dereference.
+        const T& operator*() const
+        {
+            return node_->data_;
+        }
+
+        /// Check if two iterators are same.
+        bool operator==(const Iter& that) const
+        {
+            return node_ == that.node_;
+        }
+
+        /// Increment the iterator.
+        Iter& operator++()
+        {
+            node_ = set_->live_after(node_->next());
+            return *this;
+        }
+
+        /// Decrement the iterator, by searching the predecessor from the top.
+        Iter& operator--()
+        {
+            if (guard_ == nullptr)
+            {
+                guard_ = std::make_shared<const detail::EpochGuard>();
+            }
+            if (node_ == nullptr)
+            {
+                node_ = set_->locate([](const T&) { return true; }).first;
+            }
+            else
+            {
+                const T& data = node_->data_;
+                node_ = set_->locate([&](const T& other) { return other < data; }).first;
+            }
+            return *this;
+        }
+    };
+
+protected:
+    // Maximum number of levels.
+    static constexpr int MAX_LEVEL = 32;
+
+    // Links of the head at all levels, to the first node of each level.
+    alignas(detail::CACHE_LINE_SIZE) Link head_[MAX_LEVEL];
+
+    // Number of elements, may lag behind briefly while other threads are operating.
+    alignas(detail::CACHE_LINE_SIZE) std::atomic<int> size_;
+
+    // Node of a link.
+    static Node* ptr(std::uintptr_t link)
+    {
+        return reinterpret_cast<Node*>(link & ~std::uintptr_t(1));
+    }
+
+    // Check if a link is marked.
+    static bool marked(std::uintptr_t link)
+    {
+        return (link & 1) != 0;
+    }
+
+    // Links of a node, or of the head for nullptr.
+    Link* links(Node* node) const
+    {
+        return node != nullptr ? node->next() : const_cast<Link*>(head_);
+    }
+
+    // Pick the number of levels of a new node, by a per-thread xorshift generator.
+    static int random_height()
+    {
+        thread_local std::uint32_t state = std::uint32_t(reinterpret_cast<std::uintptr_t>(&state) >> 4) | 1;
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return 1 + std::countr_zero(state | (1u << (MAX_LEVEL - 1)));
+    }
+
+    // Create a node with the given number of levels.
+    static Node* create_node(const T& element, int height)
+    {
+        void* memory = ::operator new(sizeof(Node) + height * sizeof(Link), std::align_val_t(alignof(Node)));
+        Node* node = new (memory) Node{element, height, {2}};
+        for (int level = 0; level < height; ++level)
+        {
+            new (&node->next()[level]) Link(0);
+        }
+        return node;
+    }
+
+    // Destroy a node.
+    static void destroy_node(void* ptr)
+    {
+        Node* node = static_cast<Node*>(ptr);
+        node->~Node();
+        ::operator delete(node, std::align_val_t(alignof(Node)));
+    }
+
+    // Let go of a node as its inserting or removing thread, retiring it if the other one is done with it too.
+    static void release_node(Node* node, const detail::EpochGuard& guard)
+    {
+        if (node->owners_.fetch_sub(1) == 1)
+        {
+            guard.retire(node, destroy_node);
+        }
+    }
+
+    // Find the place of the element at each level, unlinking the marked nodes on the way, inside a critical section.
+    // Fill the links to update and the nodes after them, and return whether the node at level 0 holds the element.
+    bool search(const T& element, Link** preds, Node** succs)
+    {
+        while (true)
+        {
+            bool contended = false;
+            Link* pred = head_;
+            Node* curr = nullptr;
+            for (int level = MAX_LEVEL - 1; level >= 0 && !contended; --level)
+            {
+                curr = ptr(pred[level].load());
+                while (curr != nullptr)
+                {
+                    std::uintptr_t succ = curr->next()[level].load();
+                    if (marked(succ))
+                    {
+                        // curr is being removed, unlink it at this level
+                        std::uintptr_t expected = std::uintptr_t(curr);
+                        if (!pred[level].compare_exchange_strong(expected, succ & ~std::uintptr_t(1)))
+                        {
+                            contended = true;
+                            break;
+                        }
+                        curr = ptr(succ);
+                    }
+                    else if (curr->data_ < element)
+                    {
+                        pred = curr->next();
+                        curr = ptr(succ);
+                    }
+                    else
+                    {
+                        break;
+                    }
+                }
+                preds[level] = pred;
+                succs[level] = curr;
+            }
+
+            if (!contended)
+            {
+                return curr != nullptr && !(element < curr->data_);
+            }
+        }
+    }
+
+    // Find the last node whose element satisfies the predicate and the first one that does not, without unlinking anything,
+    // inside a critical section. The predicate must hold for a prefix of the elements. The first node is nullptr for the head.
+    template <typename Before>
+    std::pair<Node*, Node*> locate(Before before) const
+    {
+        Node* pred = nullptr;
+        Node* curr = nullptr;
+        for (int level = MAX_LEVEL - 1; level >= 0; --level)
+        {
+            curr = ptr(links(pred)[level].load());
+            while (curr != nullptr)
+            {
+                std::uintptr_t succ = curr->next()[level].load();
+                if (!marked(succ) && !before(curr->data_))
+                {
+                    break;
+                }
+                if (!marked(succ))
+                {
+                    pred = curr;
+                }
+                curr = ptr(succ);
+            }
+        }
+        return {pred, curr};
+    }
+
+    // Return the first node that is not removed after the given links at level 0, inside a critical section.
+    static Node* live_after(Link* links)
+    {
+        Node* node = ptr(links[0].load());
+        while (node != nullptr)
+        {
+            std::uintptr_t next = node->next()[0].load();
+            if (!marked(next))
+            {
+                break;
+            }
+            node = ptr(next);
+        }
+        return node;
+    }
+
+    // Link a node inserted at level 0 at its upper levels, stopping early if it is removed meanwhile.
+    void link_upper(Node* node, Link** preds, Node** succs)
+    {
+        for (int level = 1; level < node->height_; ++level)
+        {
+            while (true)
+            {
+                std::uintptr_t next = node->next()[level].load();
+                if (marked(next))
+                {
+                    return;
+                }
+                if (ptr(next) != succs[level] && !node->next()[level].compare_exchange_strong(next, std::uintptr_t(succs[level])))
+                {
+                    continue; // marked meanwhile
+                }
+
+                std::uintptr_t expected = std::uintptr_t(succs[level]);
+                if (preds[level][level].compare_exchange_strong(expected, std::uintptr_t(node)))
+                {
+                    break;
+                }
+                if (!search(node->data_, preds, succs) || succs[0] != node)
+                {
+                    return;
+                }
+            }
+        }
+    }
+
+    // Return an iterator to the node found by the given search, which runs inside the critical section kept by the iterator.
+    template <typename Search>
+    Set<T>::Iterator pin(Search search) const
+    {
+        auto guard = std::make_shared<const detail::EpochGuard>();
+        Node* node = search();
+        return typename Set<T>::Iterator(Iter(this, node, node != nullptr ? std::move(guard) : nullptr));
+    }
+
+    // Swap with another set.
+    void swap(ConcurrentSkipListSet& that)
+    {
+        for (int level = 0; level < MAX_LEVEL; ++level)
+        {
+            head_[level].store(that.head_[level].exchange(head_[level].load()));
+        }
+        size_.store(that.size_.exchange(size_.load()));
+    }
+
+public:
+    /// @name Lifecycle
+    /// @{
+
+    /// Create an empty set.
+    ConcurrentSkipListSet()
+        : head_()
+        , size_(0)
+    {
+    }
+
+    /// Create a set based on the given initializer list.
+    ConcurrentSkipListSet(const std::initializer_list<T>& il)
+        : ConcurrentSkipListSet()
+    {
+        for (auto it = il.begin(); it != il.end(); ++it)
+        {
+            insert(*it);
+        }
+    }
+
+    /// Create a set of the items of the range [first, last).
+    template <std::input_iterator InputIt>
+    ConcurrentSkipListSet(InputIt first, InputIt last)
+        : ConcurrentSkipListSet()
+    {
+        for (auto it = first; it != last; ++it)
+        {
+            insert(*it);
+        }
+    }
+
+    /// Copy constructor.
+    ConcurrentSkipListSet(const ConcurrentSkipListSet& that)
+        : ConcurrentSkipListSet(that.begin(), that.end())
+    {
+    }
+
+    /// Move constructor.
+    ConcurrentSkipListSet(ConcurrentSkipListSet&& that)
+        : ConcurrentSkipListSet()
+    {
+        swap(that);
+    }
+
+    ConcurrentSkipListSet& operator=(ConcurrentSkipListSet that)
+    {
+        swap(that);
+        return *this;
+    }
+
+    /// Destroy the set object. The removed nodes are freed by the reclamation.
+    ~ConcurrentSkipListSet()
+    {
+        for (Node* node = ptr(head_[0].load()); node != nullptr;)
+        {
+            Node* next = ptr(node->next()[0].load());
+            destroy_node(node);
+            node = next;
+        }
+    }
+    /// @}
+
+    /// @name Iterator
+    /// @{
+
+    /// Return an iterator to the first element of the set.
+    Set<T>::Iterator begin() const override
+    {
+        return pin([&] { return live_after(links(nullptr)); });
+    }
+
+    /// Return an iterator to the element following the last element of the set.
+    Set<T>::Iterator end() const override
+    {
+        return typename Set<T>::Iterator(Iter(this, nullptr, nullptr));
+    }
+    /// @}
+
+    /// @name Examination
+    /// @{
+
+    /// Get the number of elements. A snapshot while other threads are operating.
+    int size() const override
+    {
+        return std::max(size_.load(std::memory_order_relaxed), 0);
+    }
+
+    /// Return an iterator to the specified item, or end() if the set does not contain the item.
+    Set<T>::Iterator find(const T& item) const override
+    {
+        return pin([&]
+                   {
+                       Node* node = locate([&](const T& other) { return other < item; }).second;
+                       return node != nullptr && !(item < node->data_) ? node : nullptr;
+                   });
+    }
+
+    /// Check if the set contains the specified item.
+    bool contains(const T& item) const override
+    {
+        detail::EpochGuard guard;
+        Node* node = locate([&](const T& other) { return other < item; }).second;
+        return node != nullptr && !(item < node->data_);
+    }
+
+    /// Return an iterator to the first item not less than the specified item, or end() if there is no such item.
+    Set<T>::Iterator lower_bound(const T& item) const
+    {
+        return pin([&] { return locate([&](const T& other) { return other < item; }).second; });
+    }
+
+    /// Return an iterator to the first item greater than the specified item, or end() if there is no such item.
+    Set<T>::Iterator upper_bound(const T& item) const
+    {
+        return pin([&] { return locate([&](const T& other) { return !(item < other); }).second; });
+    }
+
+    /// Return the range of items equal to the specified item, as the pair of lower_bound() and upper_bound().
+    std::pair<typename Set<T>::Iterator, typename Set<T>::Iterator> equal_range(const T& item) const
+    {
+        return {lower_bound(item), upper_bound(item)};
+    }
+
+    /// Return an iterator to the largest item not greater than the specified item, or end() if there is no such item.
+    Set<T>::Iterator floor(const T& item) const
+    {
+        return pin([&] { return locate([&](const T& other) { return !(item < other); }).first; });
+    }
+
+    /// Return an iterator to the smallest item not less than the specified item, or end() if there is no such item.
+    Set<T>::Iterator ceiling(const T& item) const
+    {
+        return lower_bound(item);
+    }
+
+    /// Return a view of the items in the range [lo, hi), in O(log N + K) expected for K items. Empty if !(lo < hi).
+    std::ranges::subrange<typename Set<T>::Iterator> range(const T& lo, const T& hi) const
+    {
+        auto first = lower_bound(lo);
+        return {first, lo < hi ? lower_bound(hi) : first};
+    }
+    /// @}
+
+    /// @name Manipulation
+    /// @{
+
+    /// Insert a new item into the set. Return whether the item was newly inserted.
+    bool insert(const T& item) override
+    {
+        detail::EpochGuard guard;
+        Link* preds[MAX_LEVEL];
+        Node* succs[MAX_LEVEL];
+        Node* node = nullptr;
+        while (true)
+        {
+            if (search(item, preds, succs))
+            {
+                if (node != nullptr)
+                {
+                    destroy_node(node); // never published
+                }
+                return false;
+            }
+
+            if (node == nullptr)
+            {
+                node = create_node(item, random_height());
+            }
+            for (int level = 0; level < node->height_; ++level)
+            {
+                node->next()[level].store(std::uintptr_t(succs[level]), std::memory_order_relaxed);
+            }
+
+            std::uintptr_t expected = std::uintptr_t(succs[0]);
+            if (preds[0][0].compare_exchange_strong(expected, std::uintptr_t(node)))
+            {
+                break;
+            }
+        }
+        size_.fetch_add(1, std::memory_order_relaxed);
+
+        link_upper(node, preds, succs);
+
+        // a remover may have searched before some levels were linked, then unlink them again
+        if (marked(node->next()[0].load()))
+        {
+            search(node->data_, preds, succs);
+        }
+        release_node(node, guard);
+        return true;
+    }
+
+    /// Remove the specified item from the set. Return whether the item was present and removed by this call.
+    bool remove(const T& item) override
+    {
+        detail::EpochGuard guard;
+        Link* preds[MAX_LEVEL];
+        Node* succs[MAX_LEVEL];
+        if (!search(item, preds, succs))
+        {
+            return false;
+        }
+
+        // mark the links from the top down, the mark at level 0 removes the node
+        Node* node = succs[0];
+        for (int level = node->height_ - 1; level > 0; --level)
+        {
+            node->next()[level].fetch_or(1);
+        }
+        if (marked(node->next()[0].fetch_or(1)))
+        {
+            return false; // removed by another thread
+        }
+        size_.fetch_sub(1, std::memory_order_relaxed);
+
+        // unlink it at all levels
+        search(item, preds, succs);
+        release_node(node, guard);
+        return true;
+    }
+
+    /// Remove all of the elements from the set. Elements inserted concurrently may remain.
+    void clear() override
+    {
+        detail::EpochGuard guard;
+        for (Node* node = live_after(head_); node != nullptr; node = live_after(head_))
+        {
+            remove(node->data_);
+        }
+    }
+
+    /// @}
+};
+
+} // namespace hellods
+
+#endif // CONCURRENTSKIPLISTSET_HPP
@@ -142,6 +142,12 @@ public:
         return map_.size();
     }
 
+    /// Get the number of slots, kept at least twice the number of elements.
+    int capacity() const
+    {
+        return map_.capacity();
+    }
+
     /// Return an iterator to the first occurrence of the specified item, or end() if the set does not contains the item.
     Set<T>::Iterator find(const T& item) const override
     {
@@ -170,6 +176,19 @@ public:
         map_.clear();
     }
 
+    /// Reduce the capacity to the smallest prime that keeps the loading factor within 1/2, dropping the deleted slots too.
+    void shrink_to_fit()
+    {
+        map_.shrink_to_fit();
+    }
+
+    /// Turn automatic shrinking on or off (default off).
+    /// When on, a removal that leaves the loading factor below 1/8 shrinks the capacity to about four times the number of elements.
+    void set_auto_shrink(bool enabled)
+    {
+        map_.set_auto_shrink(enabled);
+    }
+
     /// @}
 };
 
@@ -37,6 +37,13 @@ public:
         }
     }
 
+    /// Create a set of the items of the range [first, last), built in O(N) if they are in ascending order.
+    template <std::input_iterator InputIt>
+    TreeSet(InputIt first, InputIt last)
+        : tree_(first, last)
+    {
+    }
+
     TreeSet(const TreeSet&) = default;
     TreeSet(TreeSet&&) = default;
 
@@ -74,6 +81,60 @@ public:
     {
         return tree_.find(item);
     }
+
+    /// Return an iterator to the first item not less than the specified item, or end() if there is no such item.
+    Set<T>::Iterator lower_bound(const T& item) const
+    {
+        return tree_.lower_bound(item);
+    }
+
+    /// Return an iterator to the first item greater than the specified item, or end() if there is no such item.
+    Set<T>::Iterator upper_bound(const T& item) const
+    {
+        return tree_.upper_bound(item);
+    }
+
+    /// Return the range of items equal to the specified item, as the pair of lower_bound() and upper_bound().
+    std::pair<typename Set<T>::Iterator, typename Set<T>::Iterator> equal_range(const T& item) const
+    {
+        return tree_.equal_range(item);
+    }
+
+    /// Return an iterator to the largest item not greater than the specified item, or end() if there is no such item.
+    Set<T>::Iterator floor(const T& item) const
+    {
+        return tree_.floor(item);
+    }
+
+    /// Return an iterator to the smallest item not less than the specified item, or end() if there is no such item.
+    Set<T>::Iterator ceiling(const T& item) const
+    {
+        return tree_.ceiling(item);
+    }
+
+    /// Return a view of the items in the range [lo, hi), in O(log N + K) for K items. Empty if !(lo < hi).
+    std::ranges::subrange<typename Set<T>::Iterator> range(const T& lo, const T& hi) const
+    {
+        return tree_.range(lo, hi);
+    }
+
+    /// Return the number of items less than the specified item, in O(log N). Require a tree with order statistics.
+    int rank(const T& item) const
+    {
+        return tree_.rank(item);
+    }
+
+    /// Return the k-th smallest item counting from 0, in O(log N). Throw if k is out of range. Require a tree with order statistics.
+    const T& select(int k) const
+    {
+        return tree_.select(k);
+    }
+
+    /// Return the number of items in the range [lo, hi), in O(log N). Require a tree with order statistics.
+    int count_range(const T& lo, const T& hi) const
+    {
+        return tree_.count_range(lo, hi);
+    }
     /// @}
 
     /// @name Manipulation
@@ -85,12 +146,51 @@ public:
         return tree_.insert(item);
     }
 
+    /// Insert a new item into the set, searching from the hint instead of the root. Return an iterator to the item,
+    /// newly inserted or already present. The hint must be an iterator of this set. Require a tree with hinted insertion.
+    Set<T>::Iterator insert(const typename Set<T>::Iterator& hint, const T& item)
+    {
+        return tree_.insert(hint, item);
+    }
+
+    /// Set whether insert() searches from the place of the last insertion instead of the root, for nearly sorted items.
+    /// Require a tree with finger search.
+    void set_finger_search(bool enabled)
+    {
+        tree_.set_finger_search(enabled);
+    }
+
     /// Remove the item corresponding to the item in the set. Return whether such a item was present.
     bool remove(const T& item) override
     {
         return tree_.remove(item);
     }
 
+    /// Add the items of the given set, in parallel for large sets. Require a tree with set operations.
+    /// Pass the given set with std::move to reuse its nodes instead of copying them.
+    void union_with(TreeSet that)
+    {
+        tree_.union_with(std::move(that.tree_));
+    }
+
+    /// Remove the items not in the given set, in parallel for large sets. Require a tree with set operations.
+    void intersect_with(TreeSet that)
+    {
+        tree_.intersect_with(std::move(that.tree_));
+    }
+
+    /// Remove the items in the given set, in parallel for large sets. Require a tree with set operations.
+    void difference_with(TreeSet that)
+    {
+        tree_.difference_with(std::move(that.tree_));
+    }
+
+    /// Remove the items not satisfying the predicate, which may be called from several threads at once. Require a tree with set operations.
+    void filter(const std::function<bool(const T&)>& predicate)
+    {
+        tree_.filter(predicate);
+    }
+
     /// Remove all of the elements from the set.
     void clear() override
     {
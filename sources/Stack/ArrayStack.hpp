@@ -79,6 +79,12 @@ public:
     {
         return list_.size();
     }
+
+    /// Get the number of elements that the stack can hold before growing.
+    int capacity() const
+    {
+        return list_.capacity();
+    }
     /// @}
 
     /// @name Manipulation
@@ -96,12 +102,32 @@ public:
         return list_.pop();
     }
 
+    /// Push all elements in the range [first, last), the last one ends up at the top. The buffer grows at most once.
+    template <std::input_iterator InputIt>
+    void push_range(InputIt first, InputIt last)
+    {
+        list_.append_range(first, last);
+    }
+
     /// Remove all of the elements from the stack.
     void clear() override
     {
         list_.clear();
     }
 
+    /// Reduce the capacity to fit the elements, but not below the initial capacity.
+    void shrink_to_fit()
+    {
+        list_.shrink_to_fit();
+    }
+
+    /// Turn automatic shrinking on or off (default off).
+    /// When on, a removal that leaves less than a quarter of the capacity in use shrinks it to about twice the number of elements.
+    void set_auto_shrink(bool enabled)
+    {
+        list_.set_auto_shrink(enabled);
+    }
+
     /// @}
 };
 
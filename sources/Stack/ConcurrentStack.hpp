@@ -0,0 +1,479 @@
+/**
+ * @file ConcurrentStack.hpp
+ * @author Chen QingYu <chen_qingyu@qq.com>
+ * @brief Lock-free stack implemented by tagged linked list with elimination backoff (Treiber stack).
+ * @date 2026.10.18
+ */
+
+#ifndef CONCURRENTSTACK_HPP
+#define CONCURRENTSTACK_HPP
+
+#include "Stack.hpp"
+
+#include <vector> // std::vector
+
+namespace hellods
+{
+
+/// Lock-free stack implemented by tagged linked list with elimination backoff (Treiber stack).
+///
+/// Any number of threads may push and pop concurrently. The nodes are linked like LinkedStack, and the top of the list is swung with one CAS.
+/// Nodes live in a pool of segments that are freed only with the stack, and are referred to by 32-bit indices,
+/// so the top fits in a 64-bit word together with a tag that changes on every update: a thread holding a stale top never wins the CAS (no ABA),
+/// and reading the successor of a node that another thread has just popped is always safe. Popped nodes are recycled through a free list built the same way.
+///
+/// When the CAS on the top fails under contention, a pusher offers its node in a random slot of the elimination array for a moment,
+/// and a popper looks for such an offer, so a push and a pop can cancel each other out without touching the top at all.
+/// Lifecycle operations, top(), comparison, iteration and printing require that no other thread is using the stack.
+template <typename T>
+class ConcurrentStack : public Stack<T>
+{
+protected:
+    // Node of the linked list.
+    struct Node
+    {
+        // Index of the node below, written before the node is linked.
+        std::atomic<std::uint32_t> next_;
+
+        // Data stored in the node.
+        T data_;
+    };
+
+    // Slot of the elimination array, holding a node offered by a pusher, on a cache line of its own.
+    struct alignas(detail::CACHE_LINE_SIZE) Exchanger
+    {
+        // EMPTY, or the node index shifted left by 2 with OFFERED or TAKEN.
+        std::atomic<std::uint64_t> offer_;
+    };
+
+    template <bool Const>
+    class Iter
+    {
+        friend class ConcurrentStack;
+
+    protected:
+        using Value = std::conditional_t<Const, const T, T>;
+
+        // The stack.
+        const ConcurrentStack* stack_;
+
+        // Position counted from the bottom.
+        int current_;
+
+        // Node indices from the bottom to the top, collected on the first dereference.
+        mutable std::shared_ptr<std::vector<std::uint32_t>> order_;
+
+        // Create an iterator that point to the current position of the stack.
+        Iter(const ConcurrentStack* stack, int current)
+            : stack_(stack)
+            , current_(current)
+        {
+        }
+
+    public:
+        /// Dereference.
+        Value& operator*() const
+        {
+            if (order_ == nullptr)
+            {
+                order_ = std::make_shared<std::vector<std::uint32_t>>();
+                for (std::uint32_t i = index_of(stack_->top_.load()); i != NIL; i = stack_->node(i).next_.load())
+                {
+                    order_->push_back(i);
+                }
+                std::reverse(order_->begin(), order_->end());
+            }
+            return stack_->node((*order_)[current_]).data_;
+        }
+
+        /// Check if two iterators are same.
+        bool operator==(const Iter& that) const
+        {
+            return current_ == that.current_;
+        }
+
+        /// Increment the iterator.
+        Iter& operator++()
+        {
+            ++current_;
+            return *this;
+        }
+
+        /// Decrement the iterator.
+        Iter& operator--()
+        {
+            --current_;
+            return *this;
+        }
+    };
+
+protected:
+    using Stack<T>::MAX_CAPACITY;
+
+    // Index of no node.
+    static constexpr std::uint32_t NIL = UINT32_MAX;
+
+    // The first segment of the pool has 2^SEGMENT_BITS nodes, and each following one is twice as large.
+    static constexpr int SEGMENT_BITS = 6;
+
+    // Number of segments, enough for any 32-bit index.
+    static constexpr int SEGMENTS = 32 - SEGMENT_BITS;
+
+    // Number of slots of the elimination array.
+    static constexpr int EXCHANGERS = 8;
+
+    // Number of checks a pusher makes while its node is offered.
+    static constexpr int OFFER_SPINS = 64;
+
+    // States of an exchanger.
+    static constexpr std::uint64_t EMPTY = 0;
+    static constexpr std::uint64_t OFFERED = 1;
+    static constexpr std::uint64_t TAKEN = 2;
+
+    // Top of the stack: tag in the high half, node index in the low half.
+    alignas(detail::CACHE_LINE_SIZE) std::atomic<std::uint64_t> top_;
+
+    // Top of the free list, tagged the same way.
+    alignas(detail::CACHE_LINE_SIZE) std::atomic<std::uint64_t> free_;
+
+    // Number of nodes ever taken from the segments.
+    alignas(detail::CACHE_LINE_SIZE) std::atomic<int> allocated_;
+
+    // Number of elements, may lag behind briefly while other threads are operating.
+    alignas(detail::CACHE_LINE_SIZE) std::atomic<int> size_;
+
+    // Segments of the node pool, allocated on demand and freed with the stack.
+    std::atomic<Node*> segments_[SEGMENTS];
+
+    // Elimination array.
+    Exchanger exchangers_[EXCHANGERS];
+
+    // Pack a node index and a tag.
+    static std::uint64_t pack(std::uint32_t index, std::uint32_t tag)
+    {
+        return std::uint64_t(tag) << 32 | index;
+    }
+
+    // Node index of a packed top.
+    static std::uint32_t index_of(std::uint64_t top)
+    {
+        return std::uint32_t(top);
+    }
+
+    // Tag of a packed top.
+    static std::uint32_t tag_of(std::uint64_t top)
+    {
+        return std::uint32_t(top >> 32);
+    }
+
+    // Segment that holds the node of the given index, and the index of its first node.
+    static std::pair<int, std::uint32_t> locate(std::uint32_t index)
+    {
+        std::uint32_t pos = index + (1u << SEGMENT_BITS);
+        int segment = std::bit_width(pos) - 1 - SEGMENT_BITS;
+        return {segment, (1u << (segment + SEGMENT_BITS)) - (1u << SEGMENT_BITS)};
+    }
+
+    // Return the node of the given index.
+    Node& node(std::uint32_t index) const
+    {
+        auto [segment, first] = locate(index);
+        return segments_[segment].load(std::memory_order_acquire)[index - first];
+    }
+
+    // Pick a slot of the elimination array, by a per-thread xorshift generator.
+    Exchanger& pick_exchanger()
+    {
+        thread_local std::uint32_t state = std::uint32_t(reinterpret_cast<std::uintptr_t>(&state) >> 4) | 1;
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return exchangers_[state % EXCHANGERS];
+    }
+
+    // Try once to link the node on top of the list, return false on contention.
+    bool try_link(std::atomic<std::uint64_t>& head, std::uint32_t index)
+    {
+        std::uint64_t old = head.load(std::memory_order_relaxed);
+        node(index).next_.store(index_of(old), std::memory_order_relaxed);
+        return head.compare_exchange_strong(old, pack(index, tag_of(old) + 1), std::memory_order_release, std::memory_order_relaxed);
+    }
+
+    // Try once to unlink the top node of the list into the given index, NIL if the list is empty. Return false on contention.
+    bool try_unlink(std::atomic<std::uint64_t>& head, std::uint32_t& index)
+    {
+        std::uint64_t old = head.load(std::memory_order_acquire);
+        index = index_of(old);
+        if (index == NIL)
+        {
+            return true;
+        }
+
+        // the node may be popped and reused meanwhile, then the tag has changed and the CAS fails
+        std::uint32_t next = node(index).next_.load(std::memory_order_relaxed);
+        return head.compare_exchange_strong(old, pack(next, tag_of(old) + 1), std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    // Take a node from the free list, or a new one from the segments.
+    std::uint32_t take_node()
+    {
+        std::uint32_t index;
+        while (!try_unlink(free_, index))
+        {
+        }
+        if (index != NIL)
+        {
+            return index;
+        }
+
+        detail::check_full(allocated_.load(std::memory_order_relaxed), MAX_CAPACITY);
+        index = std::uint32_t(allocated_.fetch_add(1, std::memory_order_relaxed));
+
+        // the first thread to reach a segment allocates it
+        auto [segment, first] = locate(index);
+        if (segments_[segment].load(std::memory_order_acquire) == nullptr)
+        {
+            Node* fresh = new Node[std::size_t(1) << (segment + SEGMENT_BITS)]();
+            Node* expected = nullptr;
+            if (!segments_[segment].compare_exchange_strong(expected, fresh, std::memory_order_acq_rel))
+            {
+                delete[] fresh;
+            }
+        }
+        return index;
+    }
+
+    // Put the node on the free list.
+    void release_node(std::uint32_t index)
+    {
+        while (!try_link(free_, index))
+        {
+        }
+    }
+
+    // Offer the node to poppers in a random exchanger for a moment. Return true if a popper has taken it.
+    bool try_hand_over(std::uint32_t index)
+    {
+        Exchanger& exchanger = pick_exchanger();
+        std::uint64_t offer = std::uint64_t(index) << 2 | OFFERED;
+        std::uint64_t empty = EMPTY;
+        if (!exchanger.offer_.compare_exchange_strong(empty, offer, std::memory_order_release, std::memory_order_relaxed))
+        {
+            return false;
+        }
+
+        for (int i = 0; i < OFFER_SPINS && exchanger.offer_.load(std::memory_order_relaxed) == offer; ++i)
+        {
+        }
+
+        // withdraw the offer, unless a popper has taken it meanwhile
+        if (exchanger.offer_.compare_exchange_strong(offer, EMPTY, std::memory_order_relaxed))
+        {
+            return false;
+        }
+        exchanger.offer_.store(EMPTY, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Take a node offered in a random exchanger. Return NIL if there is none.
+    std::uint32_t try_take_over()
+    {
+        Exchanger& exchanger = pick_exchanger();
+        std::uint64_t offer = exchanger.offer_.load(std::memory_order_relaxed);
+        if ((offer & 3) != OFFERED)
+        {
+            return NIL;
+        }
+
+        std::uint64_t taken = (offer & ~std::uint64_t(3)) | TAKEN;
+        if (!exchanger.offer_.compare_exchange_strong(offer, taken, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            return NIL;
+        }
+        return std::uint32_t(offer >> 2);
+    }
+
+    // Swap with another stack.
+    void swap(ConcurrentStack& that)
+    {
+        top_.store(that.top_.exchange(top_.load()));
+        free_.store(that.free_.exchange(free_.load()));
+        allocated_.store(that.allocated_.exchange(allocated_.load()));
+        size_.store(that.size_.exchange(size_.load()));
+        for (int i = 0; i < SEGMENTS; ++i)
+        {
+            segments_[i].store(that.segments_[i].exchange(segments_[i].load()));
+        }
+    }
+
+public:
+    /// @name Lifecycle
+    /// @{
+
+    /// Create an empty stack.
+    ConcurrentStack()
+        : top_(pack(NIL, 0))
+        , free_(pack(NIL, 0))
+        , allocated_(0)
+        , size_(0)
+        , segments_()
+        , exchangers_()
+    {
+    }
+
+    /// Create a stack based on the given initializer list.
+    ConcurrentStack(const std::initializer_list<T>& il)
+        : ConcurrentStack()
+    {
+        for (auto it = il.begin(); it != il.end(); ++it)
+        {
+            push(*it);
+        }
+    }
+
+    /// Copy constructor.
+    ConcurrentStack(const ConcurrentStack& that)
+        : ConcurrentStack()
+    {
+        for (auto it = that.begin(); it != that.end(); ++it)
+        {
+            push(*it);
+        }
+    }
+
+    /// Move constructor.
+    ConcurrentStack(ConcurrentStack&& that)
+        : ConcurrentStack()
+    {
+        swap(that);
+    }
+
+    ConcurrentStack& operator=(ConcurrentStack that)
+    {
+        swap(that);
+        return *this;
+    }
+
+    /// Destroy the stack object, together with the node pool.
+    ~ConcurrentStack()
+    {
+        for (int i = 0; i < SEGMENTS; ++i)
+        {
+            delete[] segments_[i].load();
+        }
+    }
+    /// @}
+
+    /// @name Iterator
+    /// @{
+
+    /// Return an iterator to the bottom element of the stack.
+    Stack<T>::Iterator begin() const override
+    {
+        return typename Stack<T>::Iterator(Iter<true>(this, 0));
+    }
+
+    /// Return an iterator to the element following the top element of the stack.
+    Stack<T>::Iterator end() const override
+    {
+        return typename Stack<T>::Iterator(Iter<true>(this, size()));
+    }
+    /// @}
+
+    /// @name Access
+    /// @{
+
+    /// Return the reference to the element at the top in the stack.
+    T& top() override
+    {
+        detail::check_empty(size());
+        return node(index_of(top_.load(std::memory_order_acquire))).data_;
+    }
+
+    using Stack<T>::top; // const
+    /// @}
+
+    /// @name Examination
+    /// @{
+
+    /// Get the number of elements. A snapshot while other threads are operating.
+    int size() const override
+    {
+        return std::max(size_.load(std::memory_order_relaxed), 0);
+    }
+    /// @}
+
+    /// @name Manipulation
+    /// @{
+
+    /// Push an element at the top of the stack.
+    void push(const T& element) override
+    {
+        std::uint32_t index = take_node();
+        node(index).data_ = element;
+
+        while (!try_link(top_, index))
+        {
+            // contended, a popper may take the node directly
+            if (try_hand_over(index))
+            {
+                return;
+            }
+        }
+        size_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /// Try to pop the top element of the stack into the given reference, return false if the stack is empty.
+    bool try_pop(T& element)
+    {
+        std::uint32_t index;
+        bool eliminated = false;
+        while (!try_unlink(top_, index))
+        {
+            // contended, a pusher may hand over its node directly
+            if ((index = try_take_over()) != NIL)
+            {
+                eliminated = true;
+                break;
+            }
+        }
+        if (index == NIL)
+        {
+            return false;
+        }
+
+        element = std::move(node(index).data_);
+        release_node(index);
+        if (!eliminated)
+        {
+            size_.fetch_sub(1, std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    /// Pop the top element of the stack.
+    T pop() override
+    {
+        T element;
+        if (!try_pop(element))
+        {
+            detail::check_empty(0); // throws
+        }
+        return element;
+    }
+
+    /// Remove all of the elements from the stack. Elements pushed concurrently may remain.
+    void clear() override
+    {
+        T element;
+        while (try_pop(element))
+        {
+        }
+    }
+
+    /// @}
+};
+
+} // namespace hellods
+
+#endif // CONCURRENTSTACK_HPP
@@ -0,0 +1,110 @@
+/**
+ * @file UnrolledStack.hpp
+ * @author Chen QingYu <chen_qingyu@qq.com>
+ * @brief Stack implemented by unrolled (chunked) linked list.
+ * @date 2026.10.18
+ */
+
+#ifndef UNROLLEDSTACK_HPP
+#define UNROLLEDSTACK_HPP
+
+#include "../Deque/UnrolledDeque.hpp"
+#include "Stack.hpp"
+
+namespace hellods
+{
+
+/// Stack implemented by unrolled (chunked) linked list, on top of UnrolledDeque.
+/// It grows without bound like LinkedStack, but allocates once per chunk instead of once per element.
+template <typename T>
+class UnrolledStack : public Stack<T>
+{
+    UnrolledDeque<T> deque_;
+
+public:
+    using Iterator = typename Stack<T>::Iterator;
+
+    /// @name Lifecycle
+    /// @{
+
+    /// Create an empty stack.
+    UnrolledStack() = default;
+
+    /// Create a stack based on the given initializer list.
+    UnrolledStack(const std::initializer_list<T>& il)
+        : deque_(il)
+    {
+    }
+
+    UnrolledStack(const UnrolledStack&) = default;
+    UnrolledStack(UnrolledStack&&) = default;
+
+    UnrolledStack& operator=(const UnrolledStack&) = default;
+    UnrolledStack& operator=(UnrolledStack&&) = default;
+    /// @}
+
+    /// @name Iterator
+    /// @{
+
+    /// Return an iterator to the first element of the stack.
+    Iterator begin() const override
+    {
+        return deque_.begin();
+    }
+
+    /// Return an iterator to the element following the last element of the stack.
+    Iterator end() const override
+    {
+        return deque_.end();
+    }
+    /// @}
+
+    /// @name Access
+    /// @{
+
+    /// Return the reference to the element at the top in the stack.
+    T& top() override
+    {
+        return deque_.back();
+    }
+
+    using Stack<T>::top; // const
+    /// @}
+
+    /// @name Examination
+    /// @{
+
+    /// Get the number of elements.
+    int size() const override
+    {
+        return deque_.size();
+    }
+    /// @}
+
+    /// @name Manipulation
+    /// @{
+
+    /// Push an element at the top of the stack.
+    void push(const T& element) override
+    {
+        deque_.push_back(element);
+    }
+
+    /// Pop the top element of the stack.
+    T pop() override
+    {
+        return deque_.pop_back();
+    }
+
+    /// Remove all of the elements from the stack.
+    void clear() override
+    {
+        deque_.clear();
+    }
+
+    /// @}
+};
+
+} // namespace hellods
+
+#endif // UNROLLEDSTACK_HPP
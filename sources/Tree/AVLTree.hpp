@@ -10,24 +10,97 @@
 
 #include "BinarySearchTree.hpp"
 
+#include <cstdint> // std::int8_t
+
 namespace hellods
 {
 
+namespace detail
+{
+
+// Node of AVL tree, with the height and the subtree count.
+template <typename T>
+struct AVLNode : BinaryNodeBase<T, AVLNode<T>>
+{
+    // Pointer to the parent.
+    AVLNode* parent_;
+
+    // Pointer to the left child.
+    AVLNode* left_;
+
+    // Pointer to the right child.
+    AVLNode* right_;
+
+    // Number of nodes in the subtree rooted at the node, for order statistics.
+    int count_;
+
+    // Height of the node (leaf height = 1). A byte is plenty, an AVL tree of INT_MAX nodes is less than 45 levels high.
+    std::int8_t height_;
+
+    // Data stored in the node, left unconstructed in the sentinel.
+    union
+    {
+        T data_;
+    };
+
+    // Create a sentinel node without stored data.
+    AVLNode()
+        : parent_(nullptr)
+        , left_(nullptr)
+        , right_(nullptr)
+        , count_(0)
+        , height_(0)
+    {
+    }
+
+    // Create a node with given element.
+    explicit AVLNode(const T& data)
+        : parent_(nullptr)
+        , left_(nullptr)
+        , right_(nullptr)
+        , count_(1)
+        , height_(1)
+        , data_(data)
+    {
+    }
+
+    // The data is destroyed by the tree, which knows the sentinel.
+    ~AVLNode()
+    {
+    }
+
+    AVLNode* parent() const
+    {
+        return parent_;
+    }
+
+    void set_parent(AVLNode* parent)
+    {
+        parent_ = parent;
+    }
+};
+
+} // namespace detail
+
 /// AVL tree (self-balancing binary search tree).
 ///
 /// In AVL trees, the heights of the two child subtrees of any node
 /// differ by at most one; if at any time they differ by more than one,
 /// rebalancing is performed to restore this property.
 template <typename T>
-class AVLTree : public BinarySearchTree<T>
+class AVLTree : public BinarySearchTree<T, detail::AVLNode<T>>
 {
 protected:
-    using Node = typename BinarySearchTree<T>::Node;
-    using BinarySearchTree<T>::size_;
-    using BinarySearchTree<T>::end_;
-    using BinarySearchTree<T>::root_;
-    using BinarySearchTree<T>::set_root;
-    using BinarySearchTree<T>::find_min;
+    using Node = detail::AVLNode<T>;
+    using Subtree = typename BinarySearchTree<T, Node>::Subtree;
+    using BinarySearchTree<T, Node>::end_;
+    using BinarySearchTree<T, Node>::root_;
+    using BinarySearchTree<T, Node>::set_root;
+    using BinarySearchTree<T, Node>::slot;
+    using BinarySearchTree<T, Node>::find_node;
+    using BinarySearchTree<T, Node>::erase_node;
+    using BinarySearchTree<T, Node>::update_count;
+    using BinarySearchTree<T, Node>::link;
 
     // Return the height of the node (nullptr has height 0).
     int height(const Node* node) const
@@ -58,7 +131,7 @@ protected:
     Node* rotate_right(Node* y)
     {
         Node* old_root = y;
-        this->BinarySearchTree<T>::rotate_right(y);
+        this->BinarySearchTree<T, Node>::rotate_right(y);
 
         update_height(old_root);
         update_height(y);
@@ -77,7 +150,7 @@ protected:
     Node* rotate_left(Node* x)
     {
         Node* old_root = x;
-        this->BinarySearchTree<T>::rotate_left(x);
+        this->BinarySearchTree<T, Node>::rotate_left(x);
 
         update_height(old_root);
         update_height(x);
@@ -90,6 +163,7 @@ protected:
     Node* rebalance(Node* node)
     {
         update_height(node);
+        update_count(node);
 
         int bf = balance_factor(node);
 
@@ -119,84 +193,48 @@ protected:
         return node;
     }
 
-    // Insert node recursively, maintaining AVL balance.
-    Node* insert_avlnode(Node* node, const T& element)
+    // Join the subtrees and the middle node, where left < middle < right, into one subtree. Return its root.
+    // Descend the side of the taller subtree until the heights are close, link there, and rebalance on the way back up.
+    Node* join(Node* left, Node* middle, Node* right)
     {
-        if (node == nullptr)
-        {
-            node = new Node(element);
-            size_++;
-        }
-        else if (element < node->data())
+        if (height(left) > height(right) + 1)
         {
-            node->link_left(insert_avlnode(node->left_, element));
+            left->link_right(join(left->right_, middle, right));
+            return rebalance(left);
         }
-        else if (node->data() < element)
+        if (height(right) > height(left) + 1)
         {
-            node->link_right(insert_avlnode(node->right_, element));
+            right->link_left(join(left, middle, right->left_));
+            return rebalance(right);
         }
-        // else duplicate, do nothing
-
-        return rebalance(node);
+        Node* node = link(left, middle, right);
+        update_height(node);
+        return node;
     }
 
-    // Remove the minimum node from the subtree rooted at node.
-    // Return the new root of the subtree.
-    Node* remove_min(Node* node)
+    // The heights are kept in the nodes, so the subtrees need not carry them.
+    Subtree join(Subtree left, Node* middle, Subtree right) override
     {
-        if (node->left_ == nullptr)
-        {
-            Node* right = node->right_;
-            delete node;
-            size_--;
-            return right;
-        }
-
-        node->link_left(remove_min(node->left_));
-        return rebalance(node);
+        return {join(left.root, middle, right.root), 0};
     }
 
-    // Remove node recursively, maintaining AVL balance.
-    Node* remove_avlnode(Node* node, const T& element)
+    // Rebalance the nodes from the given one up to the root, updating their heights and subtree counts on the way.
+    void retrace(Node* node)
     {
-        if (node == nullptr)
+        while (node != end_)
         {
-            return nullptr;
-        }
-
-        if (element < node->data())
-        {
-            node->link_left(remove_avlnode(node->left_, element));
-        }
-        else if (node->data() < element)
-        {
-            node->link_right(remove_avlnode(node->right_, element));
-        }
-        else // element == node->data(), found the node to remove
-        {
-            if (node->left_ == nullptr)
-            {
-                Node* right = node->right_;
-                delete node;
-                size_--;
-                return right;
-            }
-
-            if (node->right_ == nullptr)
-            {
-                Node* left = node->left_;
-                delete node;
-                size_--;
-                return left;
-            }
-
-            // Two children: replace with successor (minimum of right subtree)
-            Node* min = find_min(node->right_);
-            node->data() = min->data();
-            node->link_right(remove_avlnode(node->right_, min->data()));
+            Node* parent = node->parent();
+            Node*& link = slot(node); // before the rotations move the node down
+            link = rebalance(node);
+            node = parent;
         }
+        set_root(root_);
+    }
 
-        return rebalance(node);
+    // Rebalance after linking the new leaf, from its parent up to the root.
+    void after_insert(Node* node) override
+    {
+        retrace(node->parent());
     }
 
 public:
@@ -208,22 +246,25 @@ public:
 
     /// Create a tree based on the given initializer list.
     AVLTree(const std::initializer_list<T>& il)
-        : BinarySearchTree<T>()
+        : BinarySearchTree<T, Node>()
     {
         for (auto it = il.begin(); it != il.end(); ++it)
         {
-            insert(*it);
+            this->insert(*it);
         }
     }
 
-    /// Copy constructor.
+    /// Create a perfectly balanced tree of the elements of the range [first, last), in O(N) if they are in ascending order.
+    template <std::input_iterator InputIt>
+    AVLTree(InputIt first, InputIt last)
+        : BinarySearchTree<T, Node>(first, last)
+    {
+    }
+
+    /// Copy constructor, rebuilding the elements in O(N) as a perfectly balanced tree.
     AVLTree(const AVLTree& that)
-        : BinarySearchTree<T>()
+        : BinarySearchTree<T, Node>(that)
     {
-        for (const auto& element : that)
-        {
-            insert(element);
-        }
     }
 
     /// Move constructor.
@@ -231,30 +272,70 @@ public:
 
     AVLTree& operator=(AVLTree that)
     {
-        this->BinarySearchTree<T>::swap(that);
+        this->BinarySearchTree<T, Node>::swap(that);
         return *this;
     }
     /// @}
 
-    /// @name Manipulation
+    /// @name Examination
     /// @{
 
-    /// Insert the specified element in the tree. Return whether the element was newly inserted.
-    bool insert(const T& element) override
+    /// Return the maximum depth of the tree, which is the height of the root. Empty tree depth is 0.
+    int depth() const override
     {
-        int old_size = size_;
-        set_root(insert_avlnode(root_, element));
-        return old_size != size_;
+        return height(root_);
     }
 
+    /// Return the number of elements less than the specified element, in O(log N).
+    using BinarySearchTree<T, Node>::rank;
+
+    /// Return the k-th smallest element counting from 0, in O(log N). Throw if k is out of range.
+    using BinarySearchTree<T, Node>::select;
+
+    /// Return the number of elements in the range [lo, hi), in O(log N).
+    using BinarySearchTree<T, Node>::count_range;
+    /// @}
+
+    /// @name Manipulation
+    /// @{
+
     /// Remove the specified element from the tree. Return whether such an element was present.
     bool remove(const T& element) override
     {
-        int old_size = size_;
-        set_root(remove_avlnode(root_, element));
-        return old_size != size_;
+        Node* node = find_node(element);
+        if (node == nullptr)
+        {
+            return false;
+        }
+        retrace(erase_node(node));
+        return true;
     }
 
+    /// Add the elements of the given tree, keeping the equal elements of this tree.
+    ///
+    /// The set operations are built on join and split, taking O(m log(n / m + 1)) work for trees of sizes m <= n,
+    /// and large subtrees are processed in parallel. Joining two AVL trees walks down the taller one until the heights are close.
+    /// The given tree is taken by value: pass it with std::move to reuse its nodes instead of copying them.
+    void union_with(AVLTree that)
+    {
+        BinarySearchTree<T, Node>::union_with(that);
+    }
+
+    /// Remove the elements not in the given tree.
+    void intersect_with(AVLTree that)
+    {
+        BinarySearchTree<T, Node>::intersect_with(that);
+    }
+
+    /// Remove the elements in the given tree.
+    void difference_with(AVLTree that)
+    {
+        BinarySearchTree<T, Node>::difference_with(that);
+    }
+
+    /// Remove the elements not satisfying the predicate, which may be called from several threads at once.
+    using BinarySearchTree<T, Node>::filter;
+
     /// @}
 };
 
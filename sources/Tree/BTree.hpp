@@ -0,0 +1,860 @@
+/**
+ * @file BTree.hpp
+ * @author Chen QingYu <chen_qingyu@qq.com>
+ * @brief B-tree with linked leaves (B+ tree).
+ * @date 2026.10.18
+ */
+
+#ifndef BTREE_HPP
+#define BTREE_HPP
+
+#include "Tree.hpp"
+
+namespace hellods
+{
+
+/// B-tree with linked leaves (B+ tree).
+///
+/// A node holds up to NODE_CAPACITY sorted elements in an array of a few cache lines, so a lookup takes one cache miss per level
+/// instead of one per binary level, and the tree is only log_(NODE_CAPACITY/2) N levels deep. All elements live in the leaves,
+/// which are all on the same level and doubly linked in order, so iteration and ordered scans walk the leaf arrays without climbing the tree.
+/// Inner nodes hold copies of separating elements: child i holds the elements from keys[i - 1] (inclusive) to keys[i] (exclusive).
+/// Within a node, the position is found by a branchless binary search.
+///
+/// Elements move between nodes on insertion and removal, so references to the elements are invalidated by them.
+/// Like the array-based containers, the nodes hold arrays of elements, so the elements must be default constructible.
+template <typename T>
+class BTree : public Tree<T>
+{
+public:
+    /// Maximum number of elements in a node, so that the elements of a node span about four cache lines.
+    static constexpr int NODE_CAPACITY = std::clamp(int(4 * detail::CACHE_LINE_SIZE / sizeof(T)), 4, 64);
+
+protected:
+    // Minimum number of elements in a leaf other than the root.
+    static constexpr int MIN_LEAF = NODE_CAPACITY / 2;
+
+    // Minimum number of keys in an inner node other than the root.
+    static constexpr int MIN_INNER = (NODE_CAPACITY - 1) / 2;
+
+    // Common header of the nodes.
+    struct Node
+    {
+        // Number of elements of a leaf, or number of keys of an inner node.
+        int count_;
+
+        // Whether the node is a leaf.
+        bool leaf_;
+    };
+
+    // Leaf node, with room for one element more than the capacity before it splits.
+    struct Leaf : Node
+    {
+        // Previous leaf in order, the sentinel before the first leaf.
+        Leaf* prev_;
+
+        // Next leaf in order, the sentinel after the last leaf.
+        Leaf* next_;
+
+        // Elements stored in the leaf.
+        T data_[NODE_CAPACITY + 1];
+
+        // Create an empty leaf linked to itself.
+        Leaf()
+            : Node{0, true}
+            , prev_(this)
+            , next_(this)
+            , data_()
+        {
+        }
+    };
+
+    // Inner node, with room for one key more than the capacity before it splits.
+    struct Inner : Node
+    {
+        // Separating elements.
+        T keys_[NODE_CAPACITY + 1];
+
+        // Children, one more than the keys.
+        Node* children_[NODE_CAPACITY + 2];
+
+        // Create an empty inner node.
+        Inner()
+            : Node{0, false}
+            , keys_()
+            , children_()
+        {
+        }
+    };
+
+public:
+    /// B-tree iterator class.
+    ///
+    /// Walk the leaves in ascending order. This means that begin() is the smallest element.
+    ///
+    /// Because the internal elements of the tree have a fixed order,
+    /// thus the iterator of the tree only supports access and does not support modification.
+    class Iter
+    {
+        friend class BTree;
+
+    protected:
+        // Current leaf, the sentinel for end.
+        const Leaf* leaf_;
+
+        // Index in the current leaf.
+        int index_;
+
+        // Constructor.
+        Iter(const Leaf* leaf, int index)
+            : leaf_(leaf)
+            , index_(index)
+        {
+        }
+
+    public:
+        /// Dereference.
+        const T& operator*() const
+        {
+            return leaf_->data_[index_];
+        }
+
+        /// Check if two iterators are same.
+        bool operator==(const Iter& that) const
+        {
+            return leaf_ == that.leaf_ && index_ == that.index_;
+        }
+
+        /// Increment the iterator.
+        Iter& operator++()
+        {
+            if (++index_ == leaf_->count_)
+            {
+                leaf_ = leaf_->next_;
+                index_ = 0;
+            }
+            return *this;
+        }
+
+        /// Decrement the iterator.
+        Iter& operator--()
+        {
+            if (index_ == 0)
+            {
+                leaf_ = leaf_->prev_;
+                index_ = leaf_->count_;
+            }
+            --index_;
+            return *this;
+        }
+    };
+
+protected:
+    // Number of elements.
+    int size_;
+
+    // Number of levels.
+    int depth_;
+
+    // Sentinel of the circular list of leaves, acts as the end.
+    Leaf* head_;
+
+    // Pointer to the root, nullptr if the tree is empty.
+    Node* root_;
+
+    // Return the number of keys less than the element, or if Upper, not greater than the element.
+    // Branchless binary search: the loop runs log2(count) times whatever the keys are, and the compiler emits a conditional move.
+    template <bool Upper>
+    static int rank(const T* keys, int count, const T& element)
+    {
+        if (count == 0)
+        {
+            return 0;
+        }
+
+        auto before = [&](const T& key)
+        { return Upper ? !(element < key) : key < element; };
+
+        int base = 0;
+        for (int len = count; len > 1;)
+        {
+            int half = len / 2;
+            base = before(keys[base + half]) ? base + half : base;
+            len -= half;
+        }
+        return base + before(keys[base]);
+    }
+
+    // Return the leaf whose range covers the element.
+    Leaf* find_leaf(const T& element) const
+    {
+        Node* node = root_;
+        while (!node->leaf_)
+        {
+            Inner* inner = static_cast<Inner*>(node);
+            node = inner->children_[rank<true>(inner->keys_, inner->count_, element)];
+        }
+        return static_cast<Leaf*>(node);
+    }
+
+    // Return an iterator to the first element not less than the element, or if Upper, greater than the element.
+    template <bool Upper>
+    typename Tree<T>::Iterator bound(const T& element) const
+    {
+        if (root_ == nullptr)
+        {
+            return end();
+        }
+
+        Leaf* leaf = find_leaf(element);
+        int i = rank<Upper>(leaf->data_, leaf->count_, element);
+        // all elements of the leaf are before it, so it is the first element of the next leaf (or the end)
+        if (i == leaf->count_)
+        {
+            return typename Tree<T>::Iterator(Iter(leaf->next_, 0));
+        }
+        return typename Tree<T>::Iterator(Iter(leaf, i));
+    }
+
+    // Link the leaf after the given one.
+    static void link_after(Leaf* pos, Leaf* leaf)
+    {
+        leaf->prev_ = pos;
+        leaf->next_ = pos->next_;
+        pos->next_->prev_ = leaf;
+        pos->next_ = leaf;
+    }
+
+    // Unlink the leaf from the list.
+    static void unlink(Leaf* leaf)
+    {
+        leaf->prev_->next_ = leaf->next_;
+        leaf->next_->prev_ = leaf->prev_;
+    }
+
+    // Check if the node has fewer elements than a non-root node must have.
+    static bool underfull(const Node* node)
+    {
+        return node->count_ < (node->leaf_ ? MIN_LEAF : MIN_INNER);
+    }
+
+    // Move the upper half of an overflowed leaf to a new leaf after it. Return the new leaf and its first element as the separator.
+    Leaf* split_leaf(Leaf* leaf, T& separator)
+    {
+        Leaf* right = new Leaf();
+        int half = leaf->count_ / 2;
+        std::move(leaf->data_ + half, leaf->data_ + leaf->count_, right->data_);
+        right->count_ = leaf->count_ - half;
+        leaf->count_ = half;
+        link_after(leaf, right);
+
+        separator = right->data_[0];
+        return right;
+    }
+
+    // Move the upper half of an overflowed inner node to a new node, the middle key goes up as the separator. Return the new node.
+    Inner* split_inner(Inner* inner, T& separator)
+    {
+        Inner* right = new Inner();
+        int mid = inner->count_ / 2;
+        separator = std::move(inner->keys_[mid]);
+        std::move(inner->keys_ + mid + 1, inner->keys_ + inner->count_, right->keys_);
+        std::copy(inner->children_ + mid + 1, inner->children_ + inner->count_ + 1, right->children_);
+        right->count_ = inner->count_ - mid - 1;
+        inner->count_ = mid;
+        return right;
+    }
+
+    // Insert the element into the subtree. Set inserted to whether the element was newly inserted.
+    // If the node overflows, split it and return the new right sibling with its separator, otherwise return nullptr.
+    Node* insert_node(Node* node, const T& element, bool& inserted, T& separator)
+    {
+        if (node->leaf_)
+        {
+            Leaf* leaf = static_cast<Leaf*>(node);
+            int i = rank<false>(leaf->data_, leaf->count_, element);
+            if (i < leaf->count_ && !(element < leaf->data_[i]))
+            {
+                inserted = false;
+                return nullptr;
+            }
+
+            std::move_backward(leaf->data_ + i, leaf->data_ + leaf->count_, leaf->data_ + leaf->count_ + 1);
+            leaf->data_[i] = element;
+            leaf->count_++;
+            inserted = true;
+            return leaf->count_ > NODE_CAPACITY ? split_leaf(leaf, separator) : nullptr;
+        }
+
+        Inner* inner = static_cast<Inner*>(node);
+        int i = rank<true>(inner->keys_, inner->count_, element);
+        T child_separator;
+        Node* sibling = insert_node(inner->children_[i], element, inserted, child_separator);
+        if (sibling == nullptr)
+        {
+            return nullptr;
+        }
+
+        // the child has split, take its new sibling on its right
+        std::move_backward(inner->keys_ + i, inner->keys_ + inner->count_, inner->keys_ + inner->count_ + 1);
+        std::copy_backward(inner->children_ + i + 1, inner->children_ + inner->count_ + 1, inner->children_ + inner->count_ + 2);
+        inner->keys_[i] = std::move(child_separator);
+        inner->children_[i + 1] = sibling;
+        inner->count_++;
+        return inner->count_ > NODE_CAPACITY ? split_inner(inner, separator) : nullptr;
+    }
+
+    // Refill the underfull child i of the parent, by borrowing from a sibling or merging with one.
+    void rebalance(Inner* parent, int i)
+    {
+        Node* left = i > 0 ? parent->children_[i - 1] : nullptr;
+        Node* right = i < parent->count_ ? parent->children_[i + 1] : nullptr;
+
+        if (left && left->count_ - 1 >= (left->leaf_ ? MIN_LEAF : MIN_INNER))
+        {
+            borrow_from_left(parent, i);
+        }
+        else if (right && right->count_ - 1 >= (right->leaf_ ? MIN_LEAF : MIN_INNER))
+        {
+            borrow_from_right(parent, i);
+        }
+        else
+        {
+            merge(parent, left ? i - 1 : i);
+        }
+    }
+
+    // Move the last element of child i - 1 to the front of child i.
+    void borrow_from_left(Inner* parent, int i)
+    {
+        Node* child = parent->children_[i];
+        Node* left = parent->children_[i - 1];
+
+        if (child->leaf_)
+        {
+            Leaf* to = static_cast<Leaf*>(child);
+            Leaf* from = static_cast<Leaf*>(left);
+            std::move_backward(to->data_, to->data_ + to->count_, to->data_ + to->count_ + 1);
+            to->data_[0] = std::move(from->data_[from->count_ - 1]);
+            parent->keys_[i - 1] = to->data_[0];
+        }
+        else
+        {
+            Inner* to = static_cast<Inner*>(child);
+            Inner* from = static_cast<Inner*>(left);
+            std::move_backward(to->keys_, to->keys_ + to->count_, to->keys_ + to->count_ + 1);
+            std::copy_backward(to->children_, to->children_ + to->count_ + 1, to->children_ + to->count_ + 2);
+            to->keys_[0] = std::move(parent->keys_[i - 1]);
+            to->children_[0] = from->children_[from->count_];
+            parent->keys_[i - 1] = std::move(from->keys_[from->count_ - 1]);
+        }
+        child->count_++;
+        left->count_--;
+    }
+
+    // Move the first element of child i + 1 to the back of child i.
+    void borrow_from_right(Inner* parent, int i)
+    {
+        Node* child = parent->children_[i];
+        Node* right = parent->children_[i + 1];
+
+        if (child->leaf_)
+        {
+            Leaf* to = static_cast<Leaf*>(child);
+            Leaf* from = static_cast<Leaf*>(right);
+            to->data_[to->count_] = std::move(from->data_[0]);
+            std::move(from->data_ + 1, from->data_ + from->count_, from->data_);
+            parent->keys_[i] = from->data_[0];
+        }
+        else
+        {
+            Inner* to = static_cast<Inner*>(child);
+            Inner* from = static_cast<Inner*>(right);
+            to->keys_[to->count_] = std::move(parent->keys_[i]);
+            to->children_[to->count_ + 1] = from->children_[0];
+            parent->keys_[i] = std::move(from->keys_[0]);
+            std::move(from->keys_ + 1, from->keys_ + from->count_, from->keys_);
+            std::copy(from->children_ + 1, from->children_ + from->count_ + 1, from->children_);
+        }
+        child->count_++;
+        right->count_--;
+    }
+
+    // Merge child i + 1 into child i, and remove their separator from the parent.
+    void merge(Inner* parent, int i)
+    {
+        Node* left = parent->children_[i];
+        Node* right = parent->children_[i + 1];
+
+        if (left->leaf_)
+        {
+            Leaf* to = static_cast<Leaf*>(left);
+            Leaf* from = static_cast<Leaf*>(right);
+            std::move(from->data_, from->data_ + from->count_, to->data_ + to->count_);
+            to->count_ += from->count_;
+            unlink(from);
+            delete from;
+        }
+        else
+        {
+            Inner* to = static_cast<Inner*>(left);
+            Inner* from = static_cast<Inner*>(right);
+            to->keys_[to->count_] = std::move(parent->keys_[i]);
+            std::move(from->keys_, from->keys_ + from->count_, to->keys_ + to->count_ + 1);
+            std::copy(from->children_, from->children_ + from->count_ + 1, to->children_ + to->count_ + 1);
+            to->count_ += from->count_ + 1;
+            delete from;
+        }
+
+        std::move(parent->keys_ + i + 1, parent->keys_ + parent->count_, parent->keys_ + i);
+        std::copy(parent->children_ + i + 2, parent->children_ + parent->count_ + 1, parent->children_ + i + 1);
+        parent->count_--;
+    }
+
+    // Remove the element from the subtree. Return whether such an element was present.
+    // The node may be left underfull, for the parent to fix.
+    bool remove_node(Node* node, const T& element)
+    {
+        if (node->leaf_)
+        {
+            Leaf* leaf = static_cast<Leaf*>(node);
+            int i = rank<false>(leaf->data_, leaf->count_, element);
+            if (i == leaf->count_ || element < leaf->data_[i])
+            {
+                return false;
+            }
+
+            std::move(leaf->data_ + i + 1, leaf->data_ + leaf->count_, leaf->data_ + i);
+            leaf->count_--;
+            return true;
+        }
+
+        // the element may be stored in the tree itself, so it is not used after the recursion
+        Inner* inner = static_cast<Inner*>(node);
+        int i = rank<true>(inner->keys_, inner->count_, element);
+        if (!remove_node(inner->children_[i], element))
+        {
+            return false;
+        }
+
+        if (underfull(inner->children_[i]))
+        {
+            rebalance(inner, i);
+        }
+        return true;
+    }
+
+    // Build the tree of the next n elements of the ascending sequence, bottom up in O(N). Require that the tree is empty.
+    // Each level is divided into as few nodes as possible with their sizes differing by at most one, which keeps every node at least half full.
+    template <typename It>
+    void build(It it, int n)
+    {
+        if (n == 0)
+        {
+            return;
+        }
+
+        // the leaves, allocated in ascending order, with the smallest element of each as the separator before it
+        ArrayList<Node*> level;
+        ArrayList<T> firsts;
+        int leaves = (n + NODE_CAPACITY - 1) / NODE_CAPACITY;
+        for (int i = 0; i < leaves; ++i)
+        {
+            Leaf* leaf = new Leaf();
+            leaf->count_ = n / leaves + (i < n % leaves);
+            for (int j = 0; j < leaf->count_; ++j, ++it)
+            {
+                leaf->data_[j] = *it;
+            }
+            link_after(head_->prev_, leaf);
+            level.append(leaf);
+            firsts.append(leaf->data_[0]);
+        }
+        depth_ = 1;
+
+        // the inner levels, up to NODE_CAPACITY + 1 children per node
+        while (level.size() > 1)
+        {
+            ArrayList<Node*> parents;
+            ArrayList<T> parent_firsts;
+            int count = (level.size() + NODE_CAPACITY) / (NODE_CAPACITY + 1);
+            for (int i = 0, k = 0; i < count; ++i)
+            {
+                Inner* inner = new Inner();
+                int children = level.size() / count + (i < level.size() % count);
+                inner->children_[0] = level[k];
+                for (int c = 1; c < children; ++c)
+                {
+                    inner->keys_[c - 1] = std::move(firsts[k + c]);
+                    inner->children_[c] = level[k + c];
+                }
+                inner->count_ = children - 1;
+                parents.append(inner);
+                parent_firsts.append(std::move(firsts[k]));
+                k += children;
+            }
+            level = std::move(parents);
+            firsts = std::move(parent_firsts);
+            depth_++;
+        }
+
+        root_ = level[0];
+        size_ = n;
+    }
+
+    // Destroy the subtree rooted at that node recursively.
+    void destroy(Node* node)
+    {
+        if (node->leaf_)
+        {
+            delete static_cast<Leaf*>(node);
+        }
+        else
+        {
+            Inner* inner = static_cast<Inner*>(node);
+            for (int i = 0; i <= inner->count_; ++i)
+            {
+                destroy(inner->children_[i]);
+            }
+            delete inner;
+        }
+    }
+
+    // Print the elements of the node separated by spaces.
+    void print_node(std::ostream& os, const Node* node) const
+    {
+        const T* data = node->leaf_ ? static_cast<const Leaf*>(node)->data_ : static_cast<const Inner*>(node)->keys_;
+        for (int i = 0; i < node->count_; ++i)
+        {
+            os << (i == 0 ? "" : " ") << data[i];
+        }
+    }
+
+    // Swap with another tree.
+    void swap(BTree& that)
+    {
+        std::swap(size_, that.size_);
+        std::swap(depth_, that.depth_);
+        std::swap(head_, that.head_);
+        std::swap(root_, that.root_);
+    }
+
+public:
+    /// @name Lifecycle
+    /// @{
+
+    /// Create an empty tree.
+    BTree()
+        : size_(0)
+        , depth_(0)
+        , head_(new Leaf())
+        , root_(nullptr)
+    {
+    }
+
+    /// Create a tree based on the given initializer list.
+    BTree(const std::initializer_list<T>& il)
+        : BTree()
+    {
+        for (auto it = il.begin(); it != il.end(); ++it)
+        {
+            insert(*it);
+        }
+    }
+
+    /// Create a tree of the elements of the range [first, last), in O(N) if they are in ascending order.
+    template <std::input_iterator InputIt>
+    BTree(InputIt first, InputIt last)
+        : BTree()
+    {
+        build_from_sorted(first, last);
+    }
+
+    /// Copy constructor, rebuilding the elements in O(N) as a B+ tree with evenly filled leaves.
+    BTree(const BTree& that)
+        : BTree(that.begin(), that.end())
+    {
+    }
+
+    /// Move constructor.
+    BTree(BTree&& that)
+        : BTree()
+    {
+        swap(that);
+    }
+
+    BTree& operator=(BTree that)
+    {
+        swap(that);
+        return *this;
+    }
+
+    /// Destroy the tree object.
+    ~BTree()
+    {
+        clear();
+        delete head_;
+    }
+    /// @}
+
+    /// @name Iterator
+    /// @{
+
+    /// Return an iterator to the first element of the tree.
+    ///
+    /// If the tree is empty, the returned iterator will be equal to end().
+    typename Tree<T>::Iterator begin() const override
+    {
+        return typename Tree<T>::Iterator(Iter(head_->next_, 0));
+    }
+
+    /// Return an iterator to the element following the last element of the tree.
+    ///
+    /// This element acts as a placeholder, attempting to access it results in undefined behavior.
+    typename Tree<T>::Iterator end() const override
+    {
+        return typename Tree<T>::Iterator(Iter(head_, 0));
+    }
+    /// @}
+
+    /// @name Examination
+    /// @{
+
+    /// Get the number of elements.
+    int size() const override
+    {
+        return size_;
+    }
+
+    /// Return the smallest element of the tree.
+    T min() const override
+    {
+        detail::check_empty(size_);
+        return head_->next_->data_[0];
+    }
+
+    /// Return the largest element of the tree.
+    T max() const override
+    {
+        detail::check_empty(size_);
+        return head_->prev_->data_[head_->prev_->count_ - 1];
+    }
+
+    /// Traverse the tree.
+    ///
+    /// The elements are all stored in the leaves, which are on the same level, so every order visits them in ascending order.
+    void traverse(typename Tree<T>::TraverseOption order, const std::function<void(const T&)>& action) const override
+    {
+        if (order < Tree<T>::PreOrder || order > Tree<T>::LevelOrder)
+        {
+            throw std::runtime_error("Error: Invalid order for traverse.");
+        }
+
+        for (const Leaf* leaf = head_->next_; leaf != head_; leaf = leaf->next_)
+        {
+            for (int i = 0; i < leaf->count_; ++i)
+            {
+                action(leaf->data_[i]);
+            }
+        }
+    }
+
+    /// Return an iterator to the specified element, or end() if the tree does not contain the element.
+    typename Tree<T>::Iterator find(const T& element) const override
+    {
+        if (root_ == nullptr)
+        {
+            return end();
+        }
+
+        Leaf* leaf = find_leaf(element);
+        int i = rank<false>(leaf->data_, leaf->count_, element);
+        if (i == leaf->count_ || element < leaf->data_[i])
+        {
+            return end();
+        }
+        return typename Tree<T>::Iterator(Iter(leaf, i));
+    }
+
+    /// Return an iterator to the first element not less than the specified element, or end() if there is no such element.
+    typename Tree<T>::Iterator lower_bound(const T& element) const override
+    {
+        return bound<false>(element);
+    }
+
+    /// Return an iterator to the first element greater than the specified element, or end() if there is no such element.
+    typename Tree<T>::Iterator upper_bound(const T& element) const override
+    {
+        return bound<true>(element);
+    }
+
+    /// Return the number of levels of the tree. Empty tree depth is 0.
+    int depth() const override
+    {
+        return depth_;
+    }
+
+    /// Export the tree as ASCII art, one node per line with its elements separated by spaces.
+    std::string to_ascii() const override
+    {
+        if (root_ == nullptr)
+        {
+            return "";
+        }
+        if constexpr (detail::Printable<T>)
+        {
+            std::ostringstream oss;
+            print_node(oss, root_);
+
+            std::function<void(const std::string&, const Node*)> print_children = [&](const std::string& prefix, const Node* node)
+            {
+                if (node->leaf_)
+                {
+                    return;
+                }
+
+                const Inner* inner = static_cast<const Inner*>(node);
+                for (int i = 0; i <= inner->count_; ++i)
+                {
+                    bool is_last = i == inner->count_;
+                    oss << "\n"
+                        << prefix << (is_last ? "└── " : "├── ");
+                    print_node(oss, inner->children_[i]);
+                    print_children(prefix + (is_last ? "    " : "│   "), inner->children_[i]);
+                }
+            };
+
+            print_children("", root_);
+            return oss.str();
+        }
+
+        throw std::runtime_error("Error: Tree export requires Printable elements.");
+    }
+
+    /// Export the tree as Graphviz DOT, the nodes are named by their preorder index.
+    std::string to_dot() const override
+    {
+        if constexpr (detail::Printable<T>)
+        {
+            std::ostringstream oss;
+            oss << "digraph BTree {\n";
+
+            int count = 0;
+            std::function<void(const Node*)> print_subtree = [&](const Node* node)
+            {
+                int id = count++;
+                oss << "  n" << id << " [label=\"";
+                print_node(oss, node);
+                oss << "\"];\n";
+
+                if (!node->leaf_)
+                {
+                    const Inner* inner = static_cast<const Inner*>(node);
+                    for (int i = 0; i <= inner->count_; ++i)
+                    {
+                        oss << "  n" << id << " -> n" << count << ";\n";
+                        print_subtree(inner->children_[i]);
+                    }
+                }
+            };
+
+            if (root_ != nullptr)
+            {
+                print_subtree(root_);
+            }
+            oss << "}";
+            return oss.str();
+        }
+
+        throw std::runtime_error("Error: Tree export requires Printable elements.");
+    }
+    /// @}
+
+    /// @name Manipulation
+    /// @{
+
+    /// Insert the specified element in the tree. Return whether the element was newly inserted.
+    bool insert(const T& element) override
+    {
+        if (root_ == nullptr)
+        {
+            Leaf* leaf = new Leaf();
+            link_after(head_, leaf);
+            root_ = leaf;
+            depth_ = 1;
+        }
+
+        bool inserted = false;
+        T separator;
+        Node* sibling = insert_node(root_, element, inserted, separator);
+
+        // the root has split, grow a new root above
+        if (sibling != nullptr)
+        {
+            Inner* root = new Inner();
+            root->keys_[0] = std::move(separator);
+            root->children_[0] = root_;
+            root->children_[1] = sibling;
+            root->count_ = 1;
+            root_ = root;
+            depth_++;
+        }
+
+        size_ += inserted;
+        return inserted;
+    }
+
+    /// Remove the specified element from the tree. Return whether such an element was present.
+    bool remove(const T& element) override
+    {
+        if (root_ == nullptr || !remove_node(root_, element))
+        {
+            return false;
+        }
+        size_--;
+
+        // the root has lost its last separator, its only child becomes the root
+        if (!root_->leaf_ && root_->count_ == 0)
+        {
+            Inner* root = static_cast<Inner*>(root_);
+            root_ = root->children_[0];
+            delete root;
+            depth_--;
+        }
+        else if (root_->leaf_ && root_->count_ == 0)
+        {
+            clear();
+        }
+        return true;
+    }
+
+    /// Replace the elements with those of the range [first, last), with the leaves filled evenly and allocated in ascending order.
+    ///
+    /// If the elements are in strictly ascending order, the tree is built bottom up in O(N) without any split,
+    /// otherwise they are sorted first and duplicates are dropped. The range must not refer to the elements of this tree.
+    template <std::input_iterator InputIt>
+    void build_from_sorted(InputIt first, InputIt last)
+    {
+        clear();
+        this->with_ascending(first, last, [&](auto it, int n) { build(it, n); });
+    }
+
+    /// Remove all of the elements from the tree.
+    void clear() override
+    {
+        if (root_ != nullptr)
+        {
+            destroy(root_);
+            root_ = nullptr;
+            head_->prev_ = head_->next_ = head_;
+            size_ = 0;
+            depth_ = 0;
+        }
+    }
+
+    /// @}
+};
+
+} // namespace hellods
+
+#endif // BTREE_HPP
@@ -12,95 +12,132 @@
 
 #include "../Queue/ArrayQueue.hpp" // for traverse()
 
+#include <future> // std::async
+#include <thread> // std::thread::hardware_concurrency
+
 namespace hellods
 {
 
-/// Binary search tree.
-template <typename T>
-class BinarySearchTree : public Tree<T>
+namespace detail
 {
-protected:
-    // Tree node.
-    struct Node
-    {
-        // Data stored in the node.
-        std::optional<T> data_;
-
-        // Pointer to the parent.
-        Node* parent_;
 
-        // Pointer to the left child.
-        Node* left_;
-
-        // Pointer to the right child.
-        Node* right_;
-
-        // Color of node, for red-black tree.
-        bool red_;
+// Operations shared by the nodes of the binary search trees.
+//
+// Each tree has its own node type with only the metadata it needs. A node type derives from this,
+// and has the children left_ and right_, the parent accessed by parent() and set_parent(), and the data_.
+template <typename T, typename Node>
+struct BinaryNodeBase
+{
+    T& data()
+    {
+        return self()->data_;
+    }
 
-        // Height of node, for AVL tree (leaf height = 1).
-        int height_;
+    const T& data() const
+    {
+        return self()->data_;
+    }
 
-        // Create a sentinel node without stored data.
-        Node()
-            : data_(std::nullopt)
-            , parent_(nullptr)
-            , left_(nullptr)
-            , right_(nullptr)
-            , red_(false)
-            , height_(0)
+    // Link left child.
+    void link_left(Node* child)
+    {
+        self()->left_ = child;
+        if (child != nullptr)
         {
+            child->set_parent(self());
         }
+    }
 
-        // Create a node with given element.
-        Node(const T& data, Node* parent = nullptr, Node* left = nullptr, Node* right = nullptr, bool red = true, int height = 1)
-            : data_(data)
-            , parent_(parent)
-            , left_(left)
-            , right_(right)
-            , red_(red)
-            , height_(height)
+    // Link right child.
+    void link_right(Node* child)
+    {
+        self()->right_ = child;
+        if (child != nullptr)
         {
+            child->set_parent(self());
         }
+    }
 
-        T& data()
-        {
-            return *data_;
-        }
+    // Get the sibling node.
+    Node* sibling() const
+    {
+        Node* parent = self()->parent();
+        assert(parent != nullptr);
+        return parent->left_ == self() ? parent->right_ : parent->left_;
+    }
 
-        const T& data() const
-        {
-            return *data_;
-        }
+private:
+    Node* self()
+    {
+        return static_cast<Node*>(this);
+    }
 
-        // Link left child.
-        void link_left(Node* child)
-        {
-            left_ = child;
-            if (child != nullptr)
-            {
-                child->parent_ = this;
-            }
-        }
+    const Node* self() const
+    {
+        return static_cast<const Node*>(this);
+    }
+};
 
-        // Link right child.
-        void link_right(Node* child)
-        {
-            right_ = child;
-            if (child != nullptr)
-            {
-                child->parent_ = this;
-            }
-        }
+// Node of binary search tree and splay tree, with no metadata at all.
+template <typename T>
+struct BinaryNode : BinaryNodeBase<T, BinaryNode<T>>
+{
+    // Pointer to the parent.
+    BinaryNode* parent_;
 
-        // Get the sibling node.
-        Node* sibling() const
-        {
-            assert(parent_ != nullptr);
-            return parent_->left_ == this ? parent_->right_ : parent_->left_;
-        }
+    // Pointer to the left child.
+    BinaryNode* left_;
+
+    // Pointer to the right child.
+    BinaryNode* right_;
+
+    // Data stored in the node, left unconstructed in the sentinel.
+    union
+    {
+        T data_;
     };
 
+    // Create a sentinel node without stored data.
+    BinaryNode()
+        : parent_(nullptr)
+        , left_(nullptr)
+        , right_(nullptr)
+    {
+    }
+
+    // Create a node with given element.
+    explicit BinaryNode(const T& data)
+        : parent_(nullptr)
+        , left_(nullptr)
+        , right_(nullptr)
+        , data_(data)
+    {
+    }
+
+    // The data is destroyed by the tree, which knows the sentinel.
+    ~BinaryNode()
+    {
+    }
+
+    BinaryNode* parent() const
+    {
+        return parent_;
+    }
+
+    void set_parent(BinaryNode* parent)
+    {
+        parent_ = parent;
+    }
+};
+
+} // namespace detail
+
+/// Binary search tree.
+///
+/// The node type is a parameter, so that the balanced trees derived from it store only the metadata they need in their nodes.
+template <typename T, typename Node = detail::BinaryNode<T>>
+class BinarySearchTree : public Tree<T>
+{
 public:
     /// Tree iterator class.
     ///
@@ -135,12 +172,12 @@ public:
             }
             else // back to the next ascending node
             {
-                // due to the presence of virtual maximum node, ensured current_->parent_ is not nullptr
-                while (current_->parent_->right_ == current_)
+                // due to the presence of virtual maximum node, ensured current_->parent() is not nullptr
+                while (current_->parent()->right_ == current_)
                 {
-                    current_ = current_->parent_;
+                    current_ = current_->parent();
                 }
-                current_ = current_->parent_;
+                current_ = current_->parent();
             }
         }
 
@@ -157,12 +194,12 @@ public:
             }
             else // back to the previous ascending node
             {
-                // due to the presence of virtual maximum node, ensured current_->parent_ is not nullptr
-                while (current_->parent_->left_ == current_)
+                // due to the presence of virtual maximum node, ensured current_->parent() is not nullptr
+                while (current_->parent()->left_ == current_)
                 {
-                    current_ = current_->parent_;
+                    current_ = current_->parent();
                 }
-                current_ = current_->parent_;
+                current_ = current_->parent();
             }
         }
 
@@ -206,6 +243,12 @@ protected:
     // Pointer to the root.
     Node* root_;
 
+    // Node of the last insertion, where the next search may start, or nullptr. Reset whenever nodes may be freed.
+    Node* finger_;
+
+    // Whether insert() starts searching from the finger instead of the root.
+    bool finger_search_;
+
     // Replace the root node.
     void set_root(Node* node)
     {
@@ -213,18 +256,44 @@ protected:
         end_->left_ = node;
         if (node != nullptr)
         {
-            node->parent_ = end_;
+            node->set_parent(end_);
         }
     }
 
     // Return the reference slot that points to the subtree root.
     Node*& slot(Node* node)
     {
-        if (node->parent_ == end_)
+        Node* parent = node->parent();
+        if (parent == end_)
         {
             return root_;
         }
-        return node->parent_->left_ == node ? node->parent_->left_ : node->parent_->right_;
+        return parent->left_ == node ? parent->left_ : parent->right_;
+    }
+
+    // Return the number of nodes in the subtree (nullptr has count 0). Require a node type with subtree counts.
+    static int count(const Node* node)
+    {
+        return node == nullptr ? 0 : node->count_;
+    }
+
+    // Update the subtree count of the node based on its children, if the node type keeps subtree counts.
+    static void update_count(Node* node)
+    {
+        if constexpr (requires { node->count_; })
+        {
+            node->count_ = 1 + count(node->left_) + count(node->right_);
+        }
+    }
+
+    // Destroy the data of the node and free it, if not nullptr. The sentinel, which has no data, is freed only with the tree.
+    static void free_node(Node* node)
+    {
+        if (node != nullptr)
+        {
+            std::destroy_at(&node->data_);
+            delete node;
+        }
     }
 
     // Rotate right.
@@ -238,11 +307,14 @@ protected:
            3   5                 5   7
         */
 
-        Node* tmproot = current;             // -> 6
-        current = tmproot->left_;            // -> 4
-        current->parent_ = tmproot->parent_; // 4'p = 6'p
-        tmproot->link_left(current->right_); // 6'l = 5
-        current->link_right(tmproot);        // 4'r = 6
+        Node* tmproot = current;                // -> 6
+        current = tmproot->left_;               // -> 4
+        current->set_parent(tmproot->parent()); // 4'p = 6'p
+        tmproot->link_left(current->right_);    // 6'l = 5
+        current->link_right(tmproot);           // 4'r = 6
+
+        update_count(tmproot);
+        update_count(current);
     }
 
     // Rotate left.
@@ -256,11 +328,14 @@ protected:
              5   7         3   5
         */
 
-        Node* tmproot = current;             // -> 4
-        current = tmproot->right_;           // -> 6
-        current->parent_ = tmproot->parent_; // 6'p = 4'p
-        tmproot->link_right(current->left_); // 4'r = 5
-        current->link_left(tmproot);         // 6'l = 4
+        Node* tmproot = current;                // -> 4
+        current = tmproot->right_;              // -> 6
+        current->set_parent(tmproot->parent()); // 6'p = 4'p
+        tmproot->link_right(current->left_);    // 4'r = 5
+        current->link_left(tmproot);            // 6'l = 4
+
+        update_count(tmproot);
+        update_count(current);
     }
 
     // Rotate the subtree rooted at current in the given direction.
@@ -278,93 +353,275 @@ protected:
         set_root(root_);
     }
 
-    // Destroy the subtree rooted at that node recursively.
-    void destroy(Node* node)
+    // Destroy the subtree rooted at that node in O(1) space, rotating each left child up until the node has none and can be freed.
+    static void destroy(Node* node)
     {
-        if (node)
+        while (node)
         {
-            destroy(node->left_);
-            destroy(node->right_);
-            delete node;
+            if (Node* left = node->left_)
+            {
+                node->left_ = left->right_;
+                left->right_ = node;
+                node = left;
+            }
+            else
+            {
+                free_node(std::exchange(node, node->right_));
+            }
         }
     }
 
-    // Traverse the tree in specified order.
-    void traverse_node(Node* node, typename Tree<T>::TraverseOption order, const std::function<void(const T&)>& action) const
+    // Return the node following the given one in pre-order, or nullptr at the end, adding the change of depth to depth.
+    // Walk by the parent pointers, with no stack.
+    Node* preorder_next(Node* node, int& depth) const
     {
-        if (node)
+        if (node->left_ || node->right_)
+        {
+            depth++;
+            return node->left_ ? node->left_ : node->right_;
+        }
+
+        // climb until coming up from a left child with a right sibling
+        Node* parent = node->parent();
+        while (parent != end_ && (parent->right_ == node || parent->right_ == nullptr))
+        {
+            node = parent;
+            parent = parent->parent();
+            depth--;
+        }
+        return parent == end_ ? nullptr : parent->right_;
+    }
+
+    // Return the first node in post-order of the subtree rooted at the node, the first leaf reached preferring left children.
+    static Node* postorder_first(Node* node)
+    {
+        while (node->left_ || node->right_)
+        {
+            node = node->left_ ? node->left_ : node->right_;
+        }
+        return node;
+    }
+
+    // Return the node following the given one in post-order, or end_ at the end.
+    Node* postorder_next(Node* node) const
+    {
+        Node* parent = node->parent();
+        if (parent != end_ && parent->left_ == node && parent->right_)
         {
-            switch (order)
+            return postorder_first(parent->right_);
+        }
+        return parent;
+    }
+
+    // Traverse the tree in specified order. The depth-first orders walk by the parent pointers in O(1) space.
+    void traverse_node(typename Tree<T>::TraverseOption order, const std::function<void(const T&)>& action) const
+    {
+        if (root_ == nullptr)
+        {
+            return;
+        }
+
+        switch (order)
+        {
+            case Tree<T>::PreOrder:
             {
-                case Tree<T>::PreOrder:
+                int depth = 0;
+                for (Node* node = root_; node != nullptr; node = preorder_next(node, depth))
                 {
                     action(node->data());
-                    traverse_node(node->left_, Tree<T>::PreOrder, action);
-                    traverse_node(node->right_, Tree<T>::PreOrder, action);
-                    break;
                 }
+                break;
+            }
 
-                case Tree<T>::InOrder:
+            case Tree<T>::InOrder:
+            {
+                for (Iter it(find_min(root_)); it.current_ != end_; it.next())
                 {
-                    traverse_node(node->left_, Tree<T>::InOrder, action);
-                    action(node->data());
-                    traverse_node(node->right_, Tree<T>::InOrder, action);
-                    break;
+                    action(*it);
                 }
+                break;
+            }
 
-                case Tree<T>::PostOrder:
+            case Tree<T>::PostOrder:
+            {
+                for (Node* node = postorder_first(root_); node != end_; node = postorder_next(node))
                 {
-                    traverse_node(node->left_, Tree<T>::PostOrder, action);
-                    traverse_node(node->right_, Tree<T>::PostOrder, action);
                     action(node->data());
-                    break;
                 }
+                break;
+            }
 
-                case Tree<T>::LevelOrder:
+            case Tree<T>::LevelOrder:
+            {
+                ArrayQueue<Node*> queue;
+                queue.enqueue(root_);
+                while (!queue.is_empty())
                 {
-                    ArrayQueue<Node*> queue;
-                    queue.enqueue(node);
-                    while (!queue.is_empty())
+                    Node* node = queue.dequeue();
+                    action(node->data());
+                    if (node->left_)
                     {
-                        node = queue.dequeue();
-                        action(node->data());
-                        if (node->left_)
-                        {
-                            queue.enqueue(node->left_);
-                        }
-                        if (node->right_)
-                        {
-                            queue.enqueue(node->right_);
-                        }
+                        queue.enqueue(node->left_);
+                    }
+                    if (node->right_)
+                    {
+                        queue.enqueue(node->right_);
                     }
-                    break;
                 }
+                break;
+            }
 
-                default:
-                {
-                    throw std::runtime_error("Error: Invalid order for traverse.");
-                }
+            default:
+            {
+                throw std::runtime_error("Error: Invalid order for traverse.");
             }
         }
     }
 
-    // Insert node recursively.
-    Node* insert_node(Node* node, const T& element)
+    // Find the node containing the specified element, or nullptr if there is none.
+    Node* find_node(const T& element) const
     {
-        if (node == nullptr)
+        Node* current = root_;
+        while (current)
         {
-            node = new Node(element);
-            size_++;
+            if (current->data() < element)
+            {
+                current = current->right_;
+            }
+            else if (element < current->data())
+            {
+                current = current->left_;
+            }
+            else
+            {
+                return current;
+            }
         }
-        else
+        return nullptr;
+    }
+
+    // Insert a leaf of the element at the position found top-down in the subtree rooted at from (the whole tree if nullptr),
+    // which must be the place of the element. Return the node of the element and whether it is new.
+    // Subtree counts are not touched, the balanced trees fix them in after_insert().
+    std::pair<Node*, bool> insert_node(const T& element, Node* from)
+    {
+        Node* parent = end_;
+        Node** link = &root_;
+        if (from != nullptr)
+        {
+            parent = from->parent();
+            link = &slot(from);
+        }
+
+        while (*link)
+        {
+            parent = *link;
+            if (element < parent->data())
+            {
+                link = &parent->left_;
+            }
+            else if (parent->data() < element)
+            {
+                link = &parent->right_;
+            }
+            else
+            {
+                return {parent, false};
+            }
+        }
+
+        Node* node = new Node(element);
+        *link = node;
+        node->set_parent(parent);
+        set_root(root_);
+        size_++;
+        return {node, true};
+    }
+
+    // Return the lowest ancestor of the finger (or the finger itself) whose subtree is the place of the element,
+    // climbing by the parent pointers only as far as needed.
+    //
+    // An ancestor reached from its right child is a lower bound of the subtree below, and from its left child an upper bound.
+    // Going up, the bounds of a kind only get looser, so once the element is within one of them, it is within all the others
+    // of that kind, and the climb goes on just for the other kind.
+    Node* climb(Node* finger, const T& element) const
+    {
+        Node* node = finger;
+        bool above_lower = false;
+        bool below_upper = false;
+        for (Node *child = finger, *up = finger->parent(); up != end_ && !(above_lower && below_upper); child = up, up = up->parent())
         {
-            if (element < node->data())
+            bool lower = up->right_ == child;
+            bool& within = lower ? above_lower : below_upper;
+            if (!within)
             {
-                node->link_left(insert_node(node->left_, element));
+                within = lower ? up->data() < element : element < up->data();
+                if (!within)
+                {
+                    node = up;
+                }
             }
-            else if (node->data() < element)
+        }
+        return node;
+    }
+
+    // Restore the balance after the node has been linked as a new leaf. A plain binary search tree has nothing to do.
+    virtual void after_insert(Node* node)
+    {
+        (void)node;
+    }
+
+    // Insert the element, searching from the finger (the root if nullptr), and restore the balance.
+    // Return the node of the element, which becomes the finger, and whether it is new.
+    std::pair<Node*, bool> insert_from(Node* finger, const T& element)
+    {
+        auto [node, inserted] = insert_node(element, finger != nullptr ? climb(finger, element) : nullptr);
+        if (inserted)
+        {
+            after_insert(node);
+        }
+        finger_ = node;
+        return {node, inserted};
+    }
+
+    // Build a perfectly balanced subtree of the next n elements of the ascending sequence, allocating the nodes in ascending order.
+    // For a red-black tree, the nodes on red_depth, the last level, are red and the others black, so every path has the same number of black nodes.
+    template <typename It>
+    Node* build(It& it, int n, int depth, int red_depth)
+    {
+        if (n == 0)
+        {
+            return nullptr;
+        }
+
+        int left_count = (n - 1) / 2;
+        Node* left = build(it, left_count, depth + 1, red_depth);
+        Node* node = new Node(*it);
+        ++it;
+        Node* right = build(it, n - 1 - left_count, depth + 1, red_depth);
+
+        node->link_left(left);
+        node->link_right(right);
+        update_count(node);
+        if constexpr (requires { node->height_; })
+        {
+            node->height_ = 1 + std::max(left ? left->height_ : 0, right ? right->height_ : 0);
+        }
+        if constexpr (requires { node->set_red(true); })
+        {
+            node->set_red(depth > 0 && depth == red_depth);
+        }
+        return node;
+    }
+
+    // Find subtree maximum node, or nullptr if the subtree is empty.
+    static Node* find_max(Node* node)
+    {
+        if (node)
+        {
+            while (node->right_)
             {
-                node->link_right(insert_node(node->right_, element));
+                node = node->right_;
             }
         }
 
@@ -385,44 +642,385 @@ protected:
         return node == nullptr ? end_ : node;
     }
 
-    // Remove node recursively.
-    Node* remove_node(Node* node, const T& element)
+    // Unlink the node from the tree and free it. A node with two children is replaced by relinking its successor into its place,
+    // so the elements never move. Return the lowest node whose subtree has changed, or end_, for the balanced trees to retrace from.
+    // Subtree counts are not touched.
+    Node* erase_node(Node* node)
     {
-        if (node)
+        finger_ = nullptr;
+        Node* parent = node->parent();
+        Node*& link = slot(node);
+        Node* lowest = parent;
+        Node* replacement = node->left_ ? node->left_ : node->right_;
+
+        if (node->left_ && node->right_)
+        {
+            replacement = find_min(node->right_);
+            lowest = replacement;
+            if (replacement != node->right_)
+            {
+                lowest = replacement->parent();
+                lowest->link_left(replacement->right_);
+                replacement->link_right(node->right_);
+            }
+            replacement->link_left(node->left_);
+        }
+
+        link = replacement;
+        if (replacement != nullptr)
+        {
+            replacement->set_parent(parent);
+        }
+        set_root(root_);
+        free_node(node);
+        size_--;
+        return lowest;
+    }
+
+    // Return the maximum depth of the tree, walking it in pre-order by the parent pointers in O(1) space.
+    int depth_node() const
+    {
+        int max_depth = 0;
+        int depth = 1;
+        for (Node* node = root_; node != nullptr; node = preorder_next(node, depth))
         {
-            if (element < node->data())
+            max_depth = std::max(max_depth, depth);
+        }
+        return max_depth;
+    }
+
+    // Return the first node not less than the element, or if Upper, greater than the element. Return end_ if there is none.
+    template <bool Upper>
+    Node* bound(const T& element) const
+    {
+        Node* result = end_;
+        for (Node* current = root_; current != nullptr;)
+        {
+            if (Upper ? element < current->data() : !(current->data() < element))
             {
-                node->link_left(remove_node(node->left_, element));
+                result = current;
+                current = current->left_;
             }
-            else if (node->data() < element)
+            else
+            {
+                current = current->right_;
+            }
+        }
+        return result;
+    }
+
+    // Return the number of elements less than the specified element. Require maintained subtree counts.
+    int rank(const T& element) const
+    {
+        int rank = 0;
+        for (Node* current = root_; current != nullptr;)
+        {
+            if (current->data() < element)
             {
-                node->link_right(remove_node(node->right_, element));
+                rank += count(current->left_) + 1;
+                current = current->right_;
             }
-            else // element == node->data()
+            else
             {
-                if (node->left_ && node->right_)
-                {
-                    Node* min = find_min(node->right_);
-                    node->data() = min->data();
-                    node->link_right(remove_node(node->right_, min->data()));
-                }
-                else
-                {
-                    Node* tmp = node;
-                    node = node->left_ ? node->left_ : node->right_;
-                    delete tmp;
-                    size_--;
-                }
+                current = current->left_;
             }
         }
+        return rank;
+    }
+
+    // Return the element with the specified rank, that is the k-th smallest element counting from 0. Require maintained subtree counts.
+    const T& select(int k) const
+    {
+        detail::check_bounds(k, 0, size_);
+
+        Node* current = root_;
+        while (k != count(current->left_))
+        {
+            if (k < count(current->left_))
+            {
+                current = current->left_;
+            }
+            else
+            {
+                k -= count(current->left_) + 1;
+                current = current->right_;
+            }
+        }
+        return current->data();
+    }
+
+    // Return the number of elements in the range [lo, hi). Require maintained subtree counts.
+    int count_range(const T& lo, const T& hi) const
+    {
+        return lo < hi ? rank(hi) - rank(lo) : 0;
+    }
+
+    // Minimum number of elements of the two trees of a set operation to hand one half of the work to another thread.
+    static constexpr int PARALLEL_GRAIN = 1 << 14;
+
+    // Return how many levels of a set operation fork threads, enough for a few tasks per hardware thread.
+    static int fork_depth()
+    {
+        unsigned threads = std::thread::hardware_concurrency();
+        return threads > 1 ? int(std::bit_width(threads)) + 1 : 0;
+    }
+
+    // Run the two tasks, the first one in another thread if the work is large and there are forks left.
+    template <typename First, typename Second>
+    static void fork_join(bool large, int forks, First first, Second second)
+    {
+        if (large && forks > 0)
+        {
+            auto future = std::async(std::launch::async, first);
+            second();
+            future.get();
+        }
+        else
+        {
+            first();
+            second();
+        }
+    }
+
+    // A detached subtree with the height that join() balances by, which only a red-black tree keeps (its black height).
+    // The set operations pass the heights down and back up with the subtrees, so that no join has to measure them.
+    struct Subtree
+    {
+        Node* root;
+        int height;
+    };
+
+    // Return the subtree rooted at the node with its height, measured once per set operation.
+    virtual Subtree measure(Node* root) const
+    {
+        return {root, 0};
+    }
+
+    // Return the height of a child subtree of the node, given the height of the node's subtree.
+    virtual int child_height(const Node* node, int height) const
+    {
+        return 0;
+    }
 
+    // Return the left subtree of the subtree's root.
+    Subtree left_of(Subtree tree) const
+    {
+        return {tree.root->left_, child_height(tree.root, tree.height)};
+    }
+
+    // Return the right subtree of the subtree's root.
+    Subtree right_of(Subtree tree) const
+    {
+        return {tree.root->right_, child_height(tree.root, tree.height)};
+    }
+
+    // Link the subtrees below the middle node, where left < middle < right. Return the middle node.
+    // The middle node is taken as a single node, its old links are ignored.
+    Node* link(Node* left, Node* middle, Node* right)
+    {
+        middle->link_left(left);
+        middle->link_right(right);
+        update_count(middle);
+        return middle;
+    }
+
+    // Join the subtrees and the middle node, where left < middle < right, into one subtree. Return it.
+    // Only links here, the balanced trees rebalance.
+    virtual Subtree join(Subtree left, Node* middle, Subtree right)
+    {
+        return {link(left.root, middle, right.root), 0};
+    }
+
+    // Detach the maximum node of the subtree into last. Return the rest.
+    Subtree split_last(Subtree tree, Node*& last)
+    {
+        if (tree.root->right_ == nullptr)
+        {
+            last = tree.root;
+            return left_of(tree);
+        }
+        Subtree left = left_of(tree);
+        return join(left, tree.root, split_last(right_of(tree), last));
+    }
+
+    // Join the subtrees, where left < right, into one subtree. Return it.
+    Subtree join2(Subtree left, Subtree right)
+    {
+        if (left.root == nullptr)
+        {
+            return right;
+        }
+        Node* last = nullptr;
+        Subtree rest = split_last(left, last);
+        return join(rest, last, right);
+    }
+
+    // Split the subtree into the subtrees of the elements less than and greater than the element.
+    // Return the detached node equal to the element, or nullptr if there is none.
+    Node* split(Subtree tree, const T& element, Subtree& less, Subtree& greater)
+    {
+        Node* node = tree.root;
+        if (node == nullptr)
+        {
+            less = greater = tree;
+            return nullptr;
+        }
+
+        Subtree left = left_of(tree);
+        Subtree right = right_of(tree);
+        if (element < node->data())
+        {
+            Node* equal = split(left, element, less, greater);
+            greater = join(greater, node, right);
+            return equal;
+        }
+        if (node->data() < element)
+        {
+            Node* equal = split(right, element, less, greater);
+            less = join(left, node, less);
+            return equal;
+        }
+        less = left;
+        greater = right;
         return node;
     }
 
-    // Return the maximum depth of the subtree rooted at the node.
-    int depth_node(Node* node) const
+    // Return the union of the subtrees, reusing or freeing all of their nodes. Of equal elements, the one of a is kept.
+    Subtree unite(Subtree a, Subtree b, int forks)
+    {
+        if (a.root == nullptr || b.root == nullptr)
+        {
+            return a.root == nullptr ? b : a;
+        }
+
+        bool large = count(a.root) + count(b.root) >= PARALLEL_GRAIN;
+        Subtree less = {nullptr, 0};
+        Subtree greater = {nullptr, 0};
+        free_node(split(b, a.root->data(), less, greater));
+
+        Subtree left = left_of(a);
+        Subtree right = right_of(a);
+        fork_join(large, forks, [&] { left = unite(left, less, forks - 1); }, [&] { right = unite(right, greater, forks - 1); });
+        return join(left, a.root, right);
+    }
+
+    // Return the intersection of the subtrees, reusing or freeing all of their nodes. Of equal elements, the one of a is kept.
+    Subtree intersect(Subtree a, Subtree b, int forks)
     {
-        return node == nullptr ? 0 : 1 + std::max(depth_node(node->left_), depth_node(node->right_));
+        if (a.root == nullptr || b.root == nullptr)
+        {
+            destroy(a.root);
+            destroy(b.root);
+            return {nullptr, 0};
+        }
+
+        bool large = count(a.root) + count(b.root) >= PARALLEL_GRAIN;
+        Subtree less = {nullptr, 0};
+        Subtree greater = {nullptr, 0};
+        Node* equal = split(b, a.root->data(), less, greater);
+
+        Subtree left = left_of(a);
+        Subtree right = right_of(a);
+        fork_join(large, forks, [&] { left = intersect(left, less, forks - 1); }, [&] { right = intersect(right, greater, forks - 1); });
+        if (equal != nullptr)
+        {
+            free_node(equal);
+            return join(left, a.root, right);
+        }
+        free_node(a.root);
+        return join2(left, right);
+    }
+
+    // Return the elements of subtree a that are not in subtree b, reusing or freeing all of their nodes.
+    Subtree subtract(Subtree a, Subtree b, int forks)
+    {
+        if (a.root == nullptr || b.root == nullptr)
+        {
+            destroy(b.root);
+            return a;
+        }
+
+        bool large = count(a.root) + count(b.root) >= PARALLEL_GRAIN;
+        Subtree less = {nullptr, 0};
+        Subtree greater = {nullptr, 0};
+        free_node(split(a, b.root->data(), less, greater));
+
+        Subtree left = left_of(b);
+        Subtree right = right_of(b);
+        free_node(b.root);
+        fork_join(large, forks, [&] { left = subtract(less, left, forks - 1); }, [&] { right = subtract(greater, right, forks - 1); });
+        return join2(left, right);
+    }
+
+    // Return the elements of the subtree satisfying the predicate, reusing or freeing all of its nodes.
+    Subtree filter_node(Subtree tree, const std::function<bool(const T&)>& predicate, int forks)
+    {
+        Node* node = tree.root;
+        if (node == nullptr)
+        {
+            return tree;
+        }
+
+        Subtree left = left_of(tree);
+        Subtree right = right_of(tree);
+        fork_join(count(node) >= PARALLEL_GRAIN, forks,
+                  [&] { left = filter_node(left, predicate, forks - 1); },
+                  [&] { right = filter_node(right, predicate, forks - 1); });
+        if (predicate(node->data()))
+        {
+            return join(left, node, right);
+        }
+        free_node(node);
+        return join2(left, right);
+    }
+
+    // Take all nodes out of the tree, leaving it empty. Return them as a measured subtree.
+    Subtree release()
+    {
+        Subtree tree = measure(root_);
+        size_ = 0;
+        finger_ = nullptr;
+        set_root(nullptr);
+        return tree;
+    }
+
+    // Make the subtree the whole tree, which must be empty.
+    void adopt(Subtree tree)
+    {
+        Node* root = tree.root;
+        set_root(root);
+        size_ = count(root);
+        if constexpr (requires { root->set_red(false); })
+        {
+            if (root != nullptr)
+            {
+                root->set_red(false); // the root of a red-black tree is black
+            }
+        }
+    }
+
+    // Add the elements of that tree, taking its nodes. Require maintained subtree counts.
+    void union_with(BinarySearchTree& that)
+    {
+        adopt(unite(release(), that.release(), fork_depth()));
+    }
+
+    // Keep only the elements also in that tree, taking its nodes. Require maintained subtree counts.
+    void intersect_with(BinarySearchTree& that)
+    {
+        adopt(intersect(release(), that.release(), fork_depth()));
+    }
+
+    // Remove the elements in that tree, taking its nodes. Require maintained subtree counts.
+    void difference_with(BinarySearchTree& that)
+    {
+        adopt(subtract(release(), that.release(), fork_depth()));
+    }
+
+    // Keep only the elements satisfying the predicate. Require maintained subtree counts.
+    void filter(const std::function<bool(const T&)>& predicate)
+    {
+        adopt(filter_node(release(), predicate, fork_depth()));
     }
 
     // Construct an iterator pointing to the given node.
@@ -436,6 +1034,8 @@ protected:
     {
         std::swap(size_, that.size_);
         std::swap(root_, that.root_);
+        std::swap(finger_, that.finger_);
+        std::swap(finger_search_, that.finger_search_);
         set_root(root_);
         that.set_root(that.root_);
     }
@@ -449,6 +1049,8 @@ public:
         : size_(0)
         , end_(new Node())
         , root_(nullptr)
+        , finger_(nullptr)
+        , finger_search_(false)
     {
     }
 
@@ -462,14 +1064,19 @@ public:
         }
     }
 
-    /// Copy constructor.
-    BinarySearchTree(const BinarySearchTree& that)
+    /// Create a perfectly balanced tree of the elements of the range [first, last), in O(N) if they are in ascending order.
+    template <std::input_iterator InputIt>
+    BinarySearchTree(InputIt first, InputIt last)
         : BinarySearchTree()
     {
-        for (const auto& element : that)
-        {
-            insert(element);
-        }
+        build_from_sorted(first, last);
+    }
+
+    /// Copy constructor, rebuilding the elements in O(N) as a perfectly balanced tree.
+    BinarySearchTree(const BinarySearchTree& that)
+        : BinarySearchTree(that.begin(), that.end())
+    {
+        finger_search_ = that.finger_search_;
     }
 
     /// Move constructor.
@@ -533,46 +1140,38 @@ public:
     T max() const override
     {
         detail::check_empty(size_);
-        Node* current = root_;
-        while (current->right_)
-        {
-            current = current->right_;
-        }
-        return current->data();
+        return find_max(root_)->data();
     }
 
     /// Traverse the tree.
     void traverse(typename Tree<T>::TraverseOption order, const std::function<void(const T&)>& action) const override
     {
-        traverse_node(root_, order, action);
+        traverse_node(order, action);
     }
 
     /// Return an iterator to the specified element, or end() if the tree does not contain the element.
     typename Tree<T>::Iterator find(const T& element) const override
     {
-        Node* current = root_;
-        while (current)
-        {
-            if (current->data() < element)
-            {
-                current = current->right_;
-            }
-            else if (element < current->data())
-            {
-                current = current->left_;
-            }
-            else
-            {
-                return make_iterator(current);
-            }
-        }
-        return end();
+        Node* node = find_node(element);
+        return node ? make_iterator(node) : end();
+    }
+
+    /// Return an iterator to the first element not less than the specified element, or end() if there is no such element.
+    typename Tree<T>::Iterator lower_bound(const T& element) const override
+    {
+        return make_iterator(bound<false>(element));
+    }
+
+    /// Return an iterator to the first element greater than the specified element, or end() if there is no such element.
+    typename Tree<T>::Iterator upper_bound(const T& element) const override
+    {
+        return make_iterator(bound<true>(element));
     }
 
     /// Return the maximum depth of the tree. Empty tree depth is 0.
     int depth() const override
     {
-        return depth_node(root_);
+        return depth_node();
     }
 
     /// Export the tree as ASCII art.
@@ -587,23 +1186,27 @@ public:
             std::ostringstream oss;
             oss << root_->data();
 
-            std::function<void(const std::string&, Node*, bool)> print_node = [&](const std::string& prefix, Node* node, bool is_last)
+            // the prefix of the line, and its length after the part of each ancestor below the root
+            std::string prefix;
+            ArrayList<std::size_t> ends;
+
+            int depth = 0;
+            for (Node* node = preorder_next(root_, depth); node != nullptr; node = preorder_next(node, depth))
             {
-                if (node == nullptr)
+                while (ends.size() > depth - 1)
                 {
-                    return;
+                    ends.remove(ends.size() - 1);
                 }
+                prefix.resize(ends.size() == 0 ? 0 : ends[ends.size() - 1]);
 
+                Node* parent = node->parent();
+                bool is_last = node == parent->right_ || parent->right_ == nullptr;
                 oss << "\n"
                     << prefix << (is_last ? "└── " : "├── ") << node->data();
 
-                std::string child_prefix = prefix + (is_last ? "    " : "│   ");
-                print_node(child_prefix, node->left_, node->right_ == nullptr);
-                print_node(child_prefix, node->right_, true);
-            };
-
-            print_node("", root_->left_, root_->right_ == nullptr);
-            print_node("", root_->right_, true);
+                prefix += is_last ? "    " : "│   ";
+                ends.append(prefix.size());
+            }
             return oss.str();
         }
 
@@ -618,25 +1221,15 @@ public:
             std::ostringstream oss;
             oss << "digraph BST {\n";
 
-            std::function<void(Node*)> print_node = [&](Node* node)
+            // each edge in pre-order of its child
+            int depth = 0;
+            for (Node* node = root_; node != nullptr; node = preorder_next(node, depth))
             {
-                if (node == nullptr)
-                {
-                    return;
-                }
-                if (node->left_)
+                if (node != root_)
                 {
-                    oss << "  \"" << node->data() << "\" -> \"" << node->left_->data() << "\";\n";
-                    print_node(node->left_);
+                    oss << "  \"" << node->parent()->data() << "\" -> \"" << node->data() << "\";\n";
                 }
-                if (node->right_)
-                {
-                    oss << "  \"" << node->data() << "\" -> \"" << node->right_->data() << "\";\n";
-                    print_node(node->right_);
-                }
-            };
-
-            print_node(root_);
+            }
             oss << "}";
             return oss.str();
         }
@@ -651,22 +1244,66 @@ public:
     /// Insert the specified element in the tree. Return whether the element was newly inserted.
     bool insert(const T& element) override
     {
-        int old_size = size_;
-        set_root(insert_node(root_, element));
-        return old_size != size_;
+        return insert_from(finger_search_ ? finger_ : nullptr, element).second;
+    }
+
+    /// Insert the specified element in the tree, searching from the hint instead of the root.
+    /// Return an iterator to the element, newly inserted or already present.
+    ///
+    /// The search climbs from the hint only as far as the element requires, so a hint near the place of the element,
+    /// like the iterator returned for the previous key of a sorted stream, saves most of the descent. end() stands for the maximum.
+    /// The hint must be an iterator of this tree.
+    typename Tree<T>::Iterator insert(const typename Tree<T>::Iterator& hint, const T& element)
+    {
+        const Iter* it = hint.template target<Iter>();
+        Node* finger = it != nullptr ? it->current_ : nullptr;
+        if (finger == end_)
+        {
+            finger = find_max(root_);
+        }
+        return make_iterator(insert_from(finger, element).first);
+    }
+
+    /// Set whether insert() searches from the place of the last insertion instead of the root.
+    ///
+    /// Made for nearly sorted streams of elements: the search climbs from the last inserted element only as far as needed,
+    /// while for random elements it costs up to a climb to the root in addition to the descent.
+    void set_finger_search(bool enabled)
+    {
+        finger_search_ = enabled;
     }
 
     /// Remove the specified element from the tree. Return whether such an element was present.
     bool remove(const T& element) override
     {
-        int old_size = size_;
-        set_root(remove_node(root_, element));
-        return old_size != size_;
+        Node* node = find_node(element);
+        if (node == nullptr)
+        {
+            return false;
+        }
+        erase_node(node);
+        return true;
+    }
+
+    /// Replace the elements with those of the range [first, last), as a perfectly balanced tree with the nodes allocated in ascending order.
+    ///
+    /// If the elements are in strictly ascending order, the tree is built in O(N) without any rebalancing,
+    /// otherwise they are sorted first and duplicates are dropped. The range must not refer to the elements of this tree.
+    template <std::input_iterator InputIt>
+    void build_from_sorted(InputIt first, InputIt last)
+    {
+        clear();
+        this->with_ascending(first, last, [&](auto it, int n)
+                             {
+                                 set_root(build(it, n, 0, int(std::bit_width(unsigned(n))) - 1));
+                                 size_ = n;
+                             });
     }
 
     /// Remove all of the elements from the tree.
     void clear() override
     {
+        finger_ = nullptr;
         if (size_ != 0)
         {
             size_ = 0;
@@ -0,0 +1,936 @@
+/**
+ * @file PersistentAVLTree.hpp
+ * @author Chen QingYu <chen_qingyu@qq.com>
+ * @brief Persistent AVL tree with path copying.
+ * @date 2026.10.18
+ */
+
+#ifndef PERSISTENTAVLTREE_HPP
+#define PERSISTENTAVLTREE_HPP
+
+#include "Tree.hpp"
+
+#include "../Queue/ArrayQueue.hpp" // for traverse()
+
+#include <cstdint> // std::int8_t
+
+namespace hellods
+{
+
+/// Persistent AVL tree with path copying.
+///
+/// Nodes have no parent pointers and are shared between copies through atomic reference counts,
+/// so copying a tree is O(1). Insertion and removal copy only the shared nodes on the root-to-leaf path
+/// and the few nodes touched by the rotations, so they stay O(log N) and never disturb other copies.
+/// The nodes keep their subtree counts, for order statistics in O(log N).
+///
+/// A copy is a consistent snapshot: different threads may freely read their own copies while
+/// another thread keeps updating the original. A single object itself is not thread-safe.
+template <typename T>
+class PersistentAVLTree : public Tree<T>
+{
+protected:
+    // Maximum height of the tree, an AVL tree of INT_MAX nodes is less than 45 levels high.
+    static constexpr int MAX_HEIGHT = 48;
+
+    // Node of the tree, immutable while it is shared.
+    struct Node
+    {
+        // Number of trees and nodes that refer to this node.
+        std::atomic<int> refs_;
+
+        // Height of the node (leaf height = 1).
+        std::int8_t height_;
+
+        // Number of nodes in the subtree rooted at the node, for order statistics.
+        int count_;
+
+        // Pointer to the left child.
+        Node* left_;
+
+        // Pointer to the right child.
+        Node* right_;
+
+        // Data stored in the node.
+        T data_;
+
+        // Create a leaf with given element.
+        explicit Node(const T& data)
+            : refs_(1)
+            , height_(1)
+            , count_(1)
+            , left_(nullptr)
+            , right_(nullptr)
+            , data_(data)
+        {
+        }
+
+        // Create a copy of that node sharing its children.
+        Node(const Node& that)
+            : refs_(1)
+            , height_(that.height_)
+            , count_(that.count_)
+            , left_(share(that.left_))
+            , right_(share(that.right_))
+            , data_(that.data_)
+        {
+        }
+    };
+
+public:
+    /// Persistent AVL tree iterator class.
+    ///
+    /// Walk the elements in ascending order. This means that begin() is the smallest element.
+    /// Without parent pointers, the iterator keeps the path from the root to the current node.
+    ///
+    /// Because the internal elements of the tree have a fixed order,
+    /// thus the iterator of the tree only supports access and does not support modification.
+    class Iter
+    {
+        friend class PersistentAVLTree;
+
+    protected:
+        // Root of the tree, to step back from the end.
+        const Node* root_;
+
+        // Nodes from the root to the current node.
+        const Node* path_[MAX_HEIGHT];
+
+        // Length of the path, 0 for the end.
+        int depth_;
+
+        // Create an iterator at the end.
+        explicit Iter(const Node* root)
+            : root_(root)
+            , depth_(0)
+        {
+        }
+
+        // Push the node and its chain of left children onto the path.
+        void push_leftmost(const Node* node)
+        {
+            for (; node != nullptr; node = node->left_)
+            {
+                path_[depth_++] = node;
+            }
+        }
+
+        // Push the node and its chain of right children onto the path.
+        void push_rightmost(const Node* node)
+        {
+            for (; node != nullptr; node = node->right_)
+            {
+                path_[depth_++] = node;
+            }
+        }
+
+        // Return the current node, nullptr for the end.
+        const Node* current() const
+        {
+            return depth_ == 0 ? nullptr : path_[depth_ - 1];
+        }
+
+    public:
+        /// Dereference.
+        const T& operator*() const
+        {
+            return current()->data_;
+        }
+
+        /// Get pointer.
+        const T* operator->() const
+        {
+            return &current()->data_;
+        }
+
+        /// Check if two iterators are same.
+        bool operator==(const Iter& that) const
+        {
+            return current() == that.current();
+        }
+
+        /// Increment the iterator.
+        Iter& operator++()
+        {
+            const Node* node = path_[depth_ - 1];
+            if (node->right_ != nullptr)
+            {
+                push_leftmost(node->right_);
+                return *this;
+            }
+
+            // climb while coming from a right subtree
+            --depth_;
+            while (depth_ > 0 && path_[depth_ - 1]->right_ == node)
+            {
+                node = path_[--depth_];
+            }
+            return *this;
+        }
+
+        /// Decrement the iterator.
+        Iter& operator--()
+        {
+            if (depth_ == 0)
+            {
+                push_rightmost(root_);
+                return *this;
+            }
+
+            const Node* node = path_[depth_ - 1];
+            if (node->left_ != nullptr)
+            {
+                push_rightmost(node->left_);
+                return *this;
+            }
+
+            // climb while coming from a left subtree
+            --depth_;
+            while (depth_ > 0 && path_[depth_ - 1]->left_ == node)
+            {
+                node = path_[--depth_];
+            }
+            return *this;
+        }
+    };
+
+protected:
+    // Number of elements.
+    int size_;
+
+    // Pointer to the root, nullptr if the tree is empty.
+    Node* root_;
+
+    // Whether the nodes may be shared with another tree since the last unshare().
+    // Atomic, since several threads may copy the same const tree at once.
+    mutable std::atomic<bool> shared_;
+
+    // Number of copies made of the tree, which share its nodes again.
+    mutable std::atomic<unsigned> generation_;
+
+    // Add a reference to the node. Return the node.
+    static Node* share(Node* node)
+    {
+        if (node != nullptr)
+        {
+            node->refs_.fetch_add(1, std::memory_order_relaxed);
+        }
+        return node;
+    }
+
+    // Drop a reference to the node, destroy it and release its children if it was the last one.
+    static void release(Node* node)
+    {
+        if (node == nullptr || node->refs_.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        {
+            return;
+        }
+
+        release(node->left_);
+        release(node->right_);
+        delete node;
+    }
+
+    // Return a node that is owned only by the caller: itself if not shared, otherwise a copy of it.
+    // The caller's reference to the original node is consumed.
+    static Node* unique(Node* node)
+    {
+        if (node->refs_.load(std::memory_order_acquire) == 1)
+        {
+            return node;
+        }
+
+        Node* copy = new Node(*node);
+        release(node);
+        return copy;
+    }
+
+    // Return the height of the node (nullptr has height 0).
+    static int height(const Node* node)
+    {
+        return node == nullptr ? 0 : node->height_;
+    }
+
+    // Return the number of nodes in the subtree (nullptr has count 0).
+    static int count(const Node* node)
+    {
+        return node == nullptr ? 0 : node->count_;
+    }
+
+    // Return the balance factor of the node.
+    static int balance_factor(const Node* node)
+    {
+        return height(node->left_) - height(node->right_);
+    }
+
+    // Update the height and the subtree count of the node based on its children.
+    static void update(Node* node)
+    {
+        node->height_ = 1 + std::max(height(node->left_), height(node->right_));
+        node->count_ = 1 + count(node->left_) + count(node->right_);
+    }
+
+    // Rotate right the node owned by the caller, copying its left child if shared.
+    /*
+            y          x
+           / \        / \
+          x   C  =>  A   y
+         / \            / \
+        A   B          B   C
+    */
+    static Node* rotate_right(Node* y)
+    {
+        Node* x = unique(y->left_);
+        y->left_ = x->right_;
+        x->right_ = y;
+
+        update(y);
+        update(x);
+
+        return x;
+    }
+
+    // Rotate left the node owned by the caller, copying its right child if shared.
+    /*
+        x                y
+       / \              / \
+      A   y     =>     x   C
+         / \          / \
+        B   C        A   B
+    */
+    static Node* rotate_left(Node* x)
+    {
+        Node* y = unique(x->right_);
+        x->right_ = y->left_;
+        y->left_ = x;
+
+        update(x);
+        update(y);
+
+        return y;
+    }
+
+    // Rebalance the subtree rooted at the node owned by the caller.
+    // Return the new root of the subtree after rebalancing.
+    static Node* rebalance(Node* node)
+    {
+        update(node);
+
+        int bf = balance_factor(node);
+
+        // Left heavy
+        if (bf > 1)
+        {
+            if (balance_factor(node->left_) < 0) // LR case
+            {
+                node->left_ = rotate_left(unique(node->left_));
+            }
+            // LL case (including after LR adjustment)
+            return rotate_right(node);
+        }
+
+        // Right heavy
+        if (bf < -1)
+        {
+            if (balance_factor(node->right_) > 0) // RL case
+            {
+                node->right_ = rotate_right(unique(node->right_));
+            }
+            // RR case (including after RL adjustment)
+            return rotate_left(node);
+        }
+
+        // Already balanced
+        return node;
+    }
+
+    // Insert the element, which is not in the tree, into the subtree. Return the new root of the subtree.
+    static Node* insert_node(Node* node, const T& element)
+    {
+        if (node == nullptr)
+        {
+            return new Node(element);
+        }
+
+        node = unique(node);
+        if (element < node->data_)
+        {
+            node->left_ = insert_node(node->left_, element);
+        }
+        else
+        {
+            node->right_ = insert_node(node->right_, element);
+        }
+        return rebalance(node);
+    }
+
+    // Detach the minimum node of the non-empty subtree as a node owned by the caller. Return the new root of the subtree.
+    static Node* remove_min(Node* node, Node*& min)
+    {
+        node = unique(node);
+        if (node->left_ == nullptr)
+        {
+            Node* right = node->right_;
+            node->right_ = nullptr;
+            min = node;
+            return right;
+        }
+
+        node->left_ = remove_min(node->left_, min);
+        return rebalance(node);
+    }
+
+    // Remove the element, which is in the tree, from the subtree. Return the new root of the subtree.
+    // The element may live in the removed node, so it is not compared after the node is released.
+    static Node* remove_node(Node* node, const T& element)
+    {
+        node = unique(node);
+        if (element < node->data_)
+        {
+            node->left_ = remove_node(node->left_, element);
+            return rebalance(node);
+        }
+        if (node->data_ < element)
+        {
+            node->right_ = remove_node(node->right_, element);
+            return rebalance(node);
+        }
+
+        Node* left = node->left_;
+        Node* right = node->right_;
+        node->left_ = nullptr;
+        node->right_ = nullptr;
+        release(node);
+
+        if (left == nullptr || right == nullptr)
+        {
+            return left != nullptr ? left : right;
+        }
+
+        // relink the successor in place of the node, no element is copied
+        Node* successor = nullptr;
+        right = remove_min(right, successor);
+        successor->left_ = left;
+        successor->right_ = right;
+        return rebalance(successor);
+    }
+
+    // Copy the shared nodes of the subtree. Return the new root of the subtree.
+    static Node* unshare_node(Node* node)
+    {
+        if (node == nullptr)
+        {
+            return nullptr;
+        }
+
+        node = unique(node);
+        node->left_ = unshare_node(node->left_);
+        node->right_ = unshare_node(node->right_);
+        return node;
+    }
+
+    // Build a perfectly balanced subtree of the next n elements of the strictly ascending sequence.
+    template <typename It>
+    static Node* build(It& it, int n)
+    {
+        if (n == 0)
+        {
+            return nullptr;
+        }
+
+        int left_count = (n - 1) / 2;
+        Node* left = build(it, left_count);
+        Node* node = new Node(*it);
+        ++it;
+        node->left_ = left;
+        node->right_ = build(it, n - 1 - left_count);
+        update(node);
+        return node;
+    }
+
+    // Return the node of the element, or nullptr if the tree does not contain the element.
+    Node* find_node(const T& element) const
+    {
+        Node* current = root_;
+        while (current != nullptr)
+        {
+            if (element < current->data_)
+            {
+                current = current->left_;
+            }
+            else if (current->data_ < element)
+            {
+                current = current->right_;
+            }
+            else
+            {
+                break;
+            }
+        }
+        return current;
+    }
+
+    // Return an iterator to the first element not less than the element, or if Upper, greater than the element.
+    // The path is recorded on the way down and cut back to the last node that went left.
+    template <bool Upper>
+    Iter bound(const T& element) const
+    {
+        Iter it(root_);
+        int depth = 0;
+        for (const Node* node = root_; node != nullptr;)
+        {
+            it.path_[it.depth_++] = node;
+            if (Upper ? element < node->data_ : !(node->data_ < element))
+            {
+                depth = it.depth_;
+                node = node->left_;
+            }
+            else
+            {
+                node = node->right_;
+            }
+        }
+        it.depth_ = depth;
+        return it;
+    }
+
+    // Traverse the subtree in the specified depth-first order.
+    static void traverse_node(const Node* node, typename Tree<T>::TraverseOption order, const std::function<void(const T&)>& action)
+    {
+        if (node == nullptr)
+        {
+            return;
+        }
+
+        if (order == Tree<T>::PreOrder)
+        {
+            action(node->data_);
+        }
+        traverse_node(node->left_, order, action);
+        if (order == Tree<T>::InOrder)
+        {
+            action(node->data_);
+        }
+        traverse_node(node->right_, order, action);
+        if (order == Tree<T>::PostOrder)
+        {
+            action(node->data_);
+        }
+    }
+
+    // Print the children of the node below it, each line after the given prefix.
+    static void to_ascii_node(std::ostringstream& oss, const Node* node, std::string& prefix)
+    {
+        for (const Node* child : {node->left_, node->right_})
+        {
+            if (child == nullptr)
+            {
+                continue;
+            }
+
+            bool is_last = child == node->right_ || node->right_ == nullptr;
+            oss << "\n"
+                << prefix << (is_last ? "└── " : "├── ") << child->data_;
+
+            std::size_t length = prefix.size();
+            prefix += is_last ? "    " : "│   ";
+            to_ascii_node(oss, child, prefix);
+            prefix.resize(length);
+        }
+    }
+
+    // Print the edges of the subtree, each in pre-order of its child.
+    static void to_dot_node(std::ostringstream& oss, const Node* node)
+    {
+        for (const Node* child : {node->left_, node->right_})
+        {
+            if (child != nullptr)
+            {
+                oss << "  \"" << node->data_ << "\" -> \"" << child->data_ << "\";\n";
+                to_dot_node(oss, child);
+            }
+        }
+    }
+
+    // Swap with another tree.
+    void swap(PersistentAVLTree& that)
+    {
+        std::swap(size_, that.size_);
+        std::swap(root_, that.root_);
+        shared_.store(that.shared_.exchange(shared_.load()));
+    }
+
+public:
+    /// @name Lifecycle
+    /// @{
+
+    /// Create an empty tree.
+    PersistentAVLTree()
+        : size_(0)
+        , root_(nullptr)
+        , shared_(false)
+        , generation_(0)
+    {
+    }
+
+    /// Create a tree based on the given initializer list.
+    PersistentAVLTree(const std::initializer_list<T>& il)
+        : PersistentAVLTree()
+    {
+        for (auto it = il.begin(); it != il.end(); ++it)
+        {
+            insert(*it);
+        }
+    }
+
+    /// Create a perfectly balanced tree of the elements of the range [first, last), in O(N) if they are in ascending order.
+    template <std::input_iterator InputIt>
+    PersistentAVLTree(InputIt first, InputIt last)
+        : PersistentAVLTree()
+    {
+        build_from_sorted(first, last);
+    }
+
+    /// Copy constructor. O(1), the copy shares all nodes with that tree.
+    PersistentAVLTree(const PersistentAVLTree& that)
+        : size_(that.size_)
+        , root_(share(that.root_))
+        , shared_(root_ != nullptr)
+        , generation_(0)
+    {
+        if (root_ != nullptr)
+        {
+            that.shared_.store(true, std::memory_order_relaxed);
+            that.generation_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /// Move constructor.
+    PersistentAVLTree(PersistentAVLTree&& that)
+        : PersistentAVLTree()
+    {
+        swap(that);
+    }
+
+    PersistentAVLTree& operator=(PersistentAVLTree that)
+    {
+        swap(that);
+        return *this;
+    }
+
+    /// Destroy the tree object.
+    ~PersistentAVLTree()
+    {
+        release(root_);
+    }
+    /// @}
+
+    /// @name Iterator
+    /// @{
+
+    /// Return an iterator to the first element of the tree.
+    ///
+    /// If the tree is empty, the returned iterator will be equal to end().
+    typename Tree<T>::Iterator begin() const override
+    {
+        Iter it(root_);
+        it.push_leftmost(root_);
+        return typename Tree<T>::Iterator(it);
+    }
+
+    /// Return an iterator to the element following the last element of the tree.
+    ///
+    /// This element acts as a placeholder, attempting to access it results in undefined behavior.
+    typename Tree<T>::Iterator end() const override
+    {
+        return typename Tree<T>::Iterator(Iter(root_));
+    }
+    /// @}
+
+    /// @name Examination
+    /// @{
+
+    /// Get the number of elements.
+    int size() const override
+    {
+        return size_;
+    }
+
+    /// Return the smallest element of the tree.
+    T min() const override
+    {
+        detail::check_empty(size_);
+        return *begin();
+    }
+
+    /// Return the largest element of the tree.
+    T max() const override
+    {
+        detail::check_empty(size_);
+        return *--end();
+    }
+
+    /// Traverse the tree.
+    void traverse(typename Tree<T>::TraverseOption order, const std::function<void(const T&)>& action) const override
+    {
+        switch (order)
+        {
+            case Tree<T>::PreOrder:
+            case Tree<T>::InOrder:
+            case Tree<T>::PostOrder:
+            {
+                traverse_node(root_, order, action);
+                break;
+            }
+
+            case Tree<T>::LevelOrder:
+            {
+                if (root_ == nullptr)
+                {
+                    break;
+                }
+
+                ArrayQueue<const Node*> queue;
+                queue.enqueue(root_);
+                while (!queue.is_empty())
+                {
+                    const Node* node = queue.dequeue();
+                    action(node->data_);
+                    if (node->left_)
+                    {
+                        queue.enqueue(node->left_);
+                    }
+                    if (node->right_)
+                    {
+                        queue.enqueue(node->right_);
+                    }
+                }
+                break;
+            }
+
+            default:
+            {
+                throw std::runtime_error("Error: Invalid order for traverse.");
+            }
+        }
+    }
+
+    /// Return an iterator to the specified element, or end() if the tree does not contain the element.
+    typename Tree<T>::Iterator find(const T& element) const override
+    {
+        Iter it = bound<false>(element);
+        return it.depth_ != 0 && !(element < *it) ? typename Tree<T>::Iterator(it) : end();
+    }
+
+    /// Check if the tree contains the specified element.
+    bool contains(const T& element) const override
+    {
+        return find_node(element) != nullptr;
+    }
+
+    /// Return an iterator to the first element not less than the specified element, or end() if there is no such element.
+    typename Tree<T>::Iterator lower_bound(const T& element) const override
+    {
+        return typename Tree<T>::Iterator(bound<false>(element));
+    }
+
+    /// Return an iterator to the first element greater than the specified element, or end() if there is no such element.
+    typename Tree<T>::Iterator upper_bound(const T& element) const override
+    {
+        return typename Tree<T>::Iterator(bound<true>(element));
+    }
+
+    /// Return the number of elements less than the specified element, in O(log N).
+    int rank(const T& element) const
+    {
+        int rank = 0;
+        for (const Node* current = root_; current != nullptr;)
+        {
+            if (current->data_ < element)
+            {
+                rank += count(current->left_) + 1;
+                current = current->right_;
+            }
+            else
+            {
+                current = current->left_;
+            }
+        }
+        return rank;
+    }
+
+    /// Return the element with the specified rank, that is the k-th smallest element counting from 0, in O(log N).
+    const T& select(int k) const
+    {
+        detail::check_bounds(k, 0, size_);
+
+        const Node* current = root_;
+        while (k != count(current->left_))
+        {
+            if (k < count(current->left_))
+            {
+                current = current->left_;
+            }
+            else
+            {
+                k -= count(current->left_) + 1;
+                current = current->right_;
+            }
+        }
+        return current->data_;
+    }
+
+    /// Return the number of elements in the range [lo, hi), in O(log N).
+    int count_range(const T& lo, const T& hi) const
+    {
+        return lo < hi ? rank(hi) - rank(lo) : 0;
+    }
+
+    /// Return the maximum depth of the tree. Empty tree depth is 0.
+    int depth() const override
+    {
+        return height(root_);
+    }
+
+    /// Export the tree as ASCII art.
+    std::string to_ascii() const override
+    {
+        if (root_ == nullptr)
+        {
+            return "";
+        }
+        if constexpr (detail::Printable<T>)
+        {
+            std::ostringstream oss;
+            oss << root_->data_;
+            std::string prefix;
+            to_ascii_node(oss, root_, prefix);
+            return oss.str();
+        }
+
+        throw std::runtime_error("Error: Tree export requires Printable elements.");
+    }
+
+    /// Export the tree as Graphviz DOT.
+    std::string to_dot() const override
+    {
+        if constexpr (detail::Printable<T>)
+        {
+            std::ostringstream oss;
+            oss << "digraph BST {\n";
+            if (root_ != nullptr)
+            {
+                to_dot_node(oss, root_);
+            }
+            oss << "}";
+            return oss.str();
+        }
+
+        throw std::runtime_error("Error: Tree export requires Printable elements.");
+    }
+    /// @}
+
+    /// @name Manipulation
+    /// @{
+
+    /// Insert the specified element in the tree. Return whether the element was newly inserted.
+    bool insert(const T& element) override
+    {
+        if (contains(element))
+        {
+            return false;
+        }
+
+        root_ = insert_node(root_, element);
+        ++size_;
+        return true;
+    }
+
+    /// Remove the specified element from the tree. Return whether such an element was present.
+    bool remove(const T& element) override
+    {
+        if (!contains(element))
+        {
+            return false;
+        }
+
+        root_ = remove_node(root_, element);
+        --size_;
+        return true;
+    }
+
+    /// Return an iterator to the element equal to the specified element, or end() if there is no such element.
+    ///
+    /// The shared nodes on the path to it are copied first, so the element may be modified in place without disturbing the snapshots,
+    /// as long as its order among the elements does not change. This holds until the tree is copied again, see generation().
+    typename Tree<T>::Iterator find_unshared(const T& element)
+    {
+        Iter it = bound<false>(element);
+        if (it.depth_ == 0 || element < *it)
+        {
+            return end();
+        }
+
+        if (shared_.load(std::memory_order_relaxed))
+        {
+            // copy the recorded path from the root down, relinking each copy in its parent and in the iterator
+            Node** link = &root_;
+            for (int i = 0; i < it.depth_; ++i)
+            {
+                Node* node = *link = unique(*link);
+                link = i + 1 < it.depth_ && it.path_[i + 1] == node->left_ ? &node->left_ : &node->right_;
+                it.path_[i] = node;
+            }
+            it.root_ = root_;
+        }
+        return typename Tree<T>::Iterator(it);
+    }
+
+    /// Return the number of copies made of the tree so far. When it changes, the nodes made unshared before may be shared again.
+    unsigned generation() const
+    {
+        return generation_.load(std::memory_order_relaxed);
+    }
+
+    /// Copy all the nodes still shared with other trees, in O(N) after a copy of the tree and O(1) otherwise,
+    /// so that the elements may be modified in place through the iterators without disturbing the snapshots.
+    void unshare()
+    {
+        if (shared_.load(std::memory_order_relaxed))
+        {
+            root_ = unshare_node(root_);
+            shared_.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    /// Replace the elements with those of the range [first, last), as a perfectly balanced tree.
+    ///
+    /// If the elements are in strictly ascending order, the tree is built in O(N) without any rebalancing,
+    /// otherwise they are sorted first and duplicates are dropped.
+    template <std::input_iterator InputIt>
+    void build_from_sorted(InputIt first, InputIt last)
+    {
+        PersistentAVLTree tree;
+        this->with_ascending(first, last, [&](auto it, int n)
+                             {
+                                 tree.root_ = build(it, n);
+                                 tree.size_ = n;
+                             });
+        swap(tree);
+    }
+
+    /// Remove all of the elements from the tree. Other copies keep their elements.
+    void clear() override
+    {
+        release(root_);
+        root_ = nullptr;
+        size_ = 0;
+        shared_.store(false, std::memory_order_relaxed);
+    }
+
+    /// @}
+};
+
+} // namespace hellods
+
+#endif // PERSISTENTAVLTREE_HPP
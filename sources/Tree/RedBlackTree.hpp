@@ -10,29 +10,112 @@
 
 #include "BinarySearchTree.hpp"
 
+#include <cstdint> // std::uintptr_t
+
 namespace hellods
 {
 
+namespace detail
+{
+
+// Node of red-black tree, with the color packed into the lowest bit of the parent pointer and the subtree count.
+template <typename T>
+struct RedBlackNode : BinaryNodeBase<T, RedBlackNode<T>>
+{
+    // Pointer to the parent, whose lowest bit (always 0 by alignment) is set if the node is red.
+    std::uintptr_t parent_color_;
+
+    // Pointer to the left child.
+    RedBlackNode* left_;
+
+    // Pointer to the right child.
+    RedBlackNode* right_;
+
+    // Number of nodes in the subtree rooted at the node, for order statistics.
+    int count_;
+
+    // Data stored in the node, left unconstructed in the sentinel.
+    union
+    {
+        T data_;
+    };
+
+    // Create a black sentinel node without stored data.
+    RedBlackNode()
+        : parent_color_(0)
+        , left_(nullptr)
+        , right_(nullptr)
+        , count_(0)
+    {
+    }
+
+    // Create a red node with given element.
+    explicit RedBlackNode(const T& data)
+        : parent_color_(1)
+        , left_(nullptr)
+        , right_(nullptr)
+        , count_(1)
+        , data_(data)
+    {
+    }
+
+    // The data is destroyed by the tree, which knows the sentinel.
+    ~RedBlackNode()
+    {
+    }
+
+    RedBlackNode* parent() const
+    {
+        return reinterpret_cast<RedBlackNode*>(parent_color_ & ~std::uintptr_t(1));
+    }
+
+    void set_parent(RedBlackNode* parent)
+    {
+        parent_color_ = reinterpret_cast<std::uintptr_t>(parent) | (parent_color_ & 1);
+    }
+
+    bool red() const
+    {
+        return parent_color_ & 1;
+    }
+
+    void set_red(bool red)
+    {
+        parent_color_ = (parent_color_ & ~std::uintptr_t(1)) | red;
+    }
+};
+
+static_assert(alignof(RedBlackNode<char>) >= 2, "the lowest bit of a node address must be free for the color");
+
+} // namespace detail
+
 /// Red-black tree.
 template <typename T>
-class RedBlackTree : public BinarySearchTree<T>
+class RedBlackTree : public BinarySearchTree<T, detail::RedBlackNode<T>>
 {
 protected:
-    using typename BinarySearchTree<T>::Node;
-    using BinarySearchTree<T>::size_;
-    using BinarySearchTree<T>::end_;
-    using BinarySearchTree<T>::root_;
-    using BinarySearchTree<T>::set_root;
-    using BinarySearchTree<T>::find_min;
-    using BinarySearchTree<T>::slot;
-    using BinarySearchTree<T>::rotate_at;
-    using BinarySearchTree<T>::rotate_left;
-    using BinarySearchTree<T>::rotate_right;
+    using Node = detail::RedBlackNode<T>;
+    using Subtree = typename BinarySearchTree<T, Node>::Subtree;
+
+    using BinarySearchTree<T, Node>::size_;
+    using BinarySearchTree<T, Node>::end_;
+    using BinarySearchTree<T, Node>::root_;
+    using BinarySearchTree<T, Node>::finger_;
+    using BinarySearchTree<T, Node>::set_root;
+    using BinarySearchTree<T, Node>::find_min;
+    using BinarySearchTree<T, Node>::find_node;
+    using BinarySearchTree<T, Node>::slot;
+    using BinarySearchTree<T, Node>::rotate_at;
+    using BinarySearchTree<T, Node>::rotate_left;
+    using BinarySearchTree<T, Node>::rotate_right;
+    using BinarySearchTree<T, Node>::update_count;
+    using BinarySearchTree<T, Node>::free_node;
+    using BinarySearchTree<T, Node>::link;
 
     // Check whether the node is red.
     bool is_red(Node* node) const
     {
-        return node != nullptr && node->red_;
+        return node != nullptr && node->red();
     }
 
     // Check whether the node is black.
@@ -56,7 +139,7 @@ protected:
     {
         if (node != nullptr)
         {
-            node->red_ = false;
+            node->set_red(false);
         }
     }
 
@@ -66,7 +149,7 @@ protected:
         slot(old_node) = new_node;
         if (new_node != nullptr)
         {
-            new_node->parent_ = old_node->parent_;
+            new_node->set_parent(old_node->parent());
         }
         set_root(root_);
     }
@@ -76,7 +159,7 @@ protected:
     {
         while (true)
         {
-            Node* grandpa = current->parent_->parent_;
+            Node* grandpa = current->parent()->parent();
 
             // if grandpa is end_, break
             if (grandpa == end_)
@@ -87,12 +170,12 @@ protected:
             Node* uncle = parent->sibling();
 
             // state 1: if uncle is red
-            if (uncle != nullptr && uncle->red_)
+            if (uncle != nullptr && uncle->red())
             {
                 // 1. change color
-                parent->red_ = false;
-                uncle->red_ = false;
-                grandpa->red_ = true;
+                parent->set_red(false);
+                uncle->set_red(false);
+                grandpa->set_red(true);
 
                 // 2. if grandpa is the root, break
                 if (grandpa == root_)
@@ -102,8 +185,8 @@ protected:
 
                 // 3. up up, until there is no double red
                 current = grandpa;
-                parent = current->parent_;
-                if (parent->red_ == false)
+                parent = current->parent();
+                if (!parent->red())
                 {
                     break;
                 }
@@ -123,96 +206,131 @@ protected:
             if (parent_on_left)
             {
                 rotate_right(grandpa);
-                grandpa->right_->red_ = true;
+                grandpa->right_->set_red(true);
             }
             else
             {
                 rotate_left(grandpa);
-                grandpa->left_->red_ = true;
+                grandpa->left_->set_red(true);
             }
 
-            grandpa->red_ = false;
+            grandpa->set_red(false);
             grandpa_slot = grandpa;
             set_root(root_);
             break;
         } // end while(true)
     }
 
-    // Find the node containing the specified element.
-    Node* find_node(const T& element) const
+    // Return the subtree rooted at the node with its black height, the number of black nodes on every path down from it.
+    Subtree measure(Node* root) const override
     {
-        Node* node = root_;
-        while (node != nullptr)
+        int height = 0;
+        for (const Node* node = root; node != nullptr; node = node->left_)
         {
-            if (element < node->data())
-            {
-                node = node->left_;
-            }
-            else if (node->data() < element)
-            {
-                node = node->right_;
-            }
-            else
-            {
-                return node;
-            }
+            height += !node->red();
         }
-        return nullptr;
+        return {root, height};
     }
 
-    // Insert node for red-black tree.
-    bool insert_rbnode(Node*& node, const T& element)
+    // The paths down from a child pass one black node less if the node is black.
+    int child_height(const Node* node, int height) const override
     {
-        Node* current = node; // from root_
-        Node* parent = end_;  // root_'s parent is end_
+        return height - !node->red();
+    }
 
-        // find the position for insert
-        while (current != nullptr)
+    // Hang the middle node with the right subtree below the right spine of the left subtree, at the black node with the same black height.
+    // The middle node is red, and a double red on the way back up is fixed by a rotation. Return the new root of the left subtree.
+    Node* join_right(Node* left, int left_height, Node* middle, Node* right, int right_height)
+    {
+        if (is_black(left) && left_height == right_height)
         {
-            // if already has the element, do nothing
-            if (element == current->data())
-            {
-                return false;
-            }
+            Node* node = link(left, middle, right);
+            node->set_red(true);
+            return node;
+        }
 
-            parent = current;
-            current = current->data() < element ? current->right_ : current->left_;
+        Node* child = join_right(left->right_, left_height - is_black(left), middle, right, right_height);
+        left->link_right(child);
+        update_count(left);
+        if (is_black(left) && is_red(child) && is_red(child->right_))
+        {
+            child->right_->set_red(false);
+            rotate_left(left);
         }
+        return left;
+    }
 
-        // current is nullptr now, here is the position to insert
-        current = new Node(element);
-        size_++;
+    // Mirror of join_right().
+    Node* join_left(Node* left, int left_height, Node* middle, Node* right, int right_height)
+    {
+        if (is_black(right) && left_height == right_height)
+        {
+            Node* node = link(left, middle, right);
+            node->set_red(true);
+            return node;
+        }
 
-        // if current is root, ok
-        if (parent == end_)
+        Node* child = join_left(left, left_height, middle, right->left_, right_height - is_black(right));
+        right->link_left(child);
+        update_count(right);
+        if (is_black(right) && is_red(child) && is_red(child->left_))
         {
-            current->red_ = false;
-            set_root(current);
-            return true;
+            child->left_->set_red(false);
+            rotate_right(right);
         }
+        return right;
+    }
 
-        // current is not root
-        if (parent->data() < element)
+    // Join the subtrees and the middle node, where left < middle < right, into one subtree, whose root may be red.
+    // The black heights come with the subtrees, so this takes time proportional to their difference only.
+    Subtree join(Subtree left, Node* middle, Subtree right) override
+    {
+        // a black root keeps a subtree valid, and leaves no double red when the middle node is linked right below
+        left.height += is_red(left.root);
+        right.height += is_red(right.root);
+        set_black(left.root);
+        set_black(right.root);
+
+        // rotations and recolorings below the root keep the black height of the taller subtree
+        int height = left.height >= right.height ? left.height : right.height;
+        Node* root = left.height >= right.height ? join_right(left.root, left.height, middle, right.root, right.height)
+                                                 : join_left(left.root, left.height, middle, right.root, right.height);
+        if (is_red(root) && (is_red(root->left_) || is_red(root->right_)))
         {
-            parent->link_right(current);
+            root->set_red(false);
+            height++;
         }
-        else
+        return {root, height};
+    }
+
+    // Recount and recolor after linking the new leaf, which is red.
+    void after_insert(Node* current) override
+    {
+        // if current is root, ok
+        Node* parent = current->parent();
+        if (parent == end_)
+        {
+            current->set_red(false);
+            return;
+        }
+
+        // one more node in each subtree on the path
+        for (Node* ancestor = parent; ancestor != end_; ancestor = ancestor->parent())
         {
-            parent->link_left(current);
+            ancestor->count_++;
         }
 
         // if parent is black, ok (current is red)
-        if (parent->red_ == false)
+        if (!parent->red())
         {
-            return true;
+            return;
         }
 
         // now, the level >= 3 (root is level 1), and parent is red, double red
         solve_double_red(current, parent);
 
         // root is black
-        root_->red_ = false;
-        return true;
+        root_->set_red(false);
     }
 
     // Solve double black node caused by deletion.
@@ -232,8 +350,8 @@ protected:
 
             if (is_red(sibling))
             {
-                sibling->red_ = false;
-                parent->red_ = true;
+                sibling->set_red(false);
+                parent->set_red(true);
                 rotate_at(parent, current_on_left);
                 sibling = child(parent, !current_on_left);
                 near_nephew = child(sibling, current_on_left);
@@ -244,10 +362,10 @@ protected:
             {
                 if (sibling != nullptr)
                 {
-                    sibling->red_ = true;
+                    sibling->set_red(true);
                 }
                 current = parent;
-                parent = current->parent_;
+                parent = current->parent();
                 continue;
             }
 
@@ -256,15 +374,15 @@ protected:
                 if (sibling != nullptr)
                 {
                     set_black(near_nephew);
-                    sibling->red_ = true;
+                    sibling->set_red(true);
                     rotate_at(sibling, !current_on_left);
                 }
                 sibling = child(parent, !current_on_left);
                 far_nephew = child(sibling, !current_on_left);
             }
 
-            sibling->red_ = parent->red_;
-            parent->red_ = false;
+            sibling->set_red(parent->red());
+            parent->set_red(false);
             set_black(far_nephew);
             rotate_at(parent, current_on_left);
             current = root_;
@@ -284,45 +402,46 @@ protected:
         }
 
         Node* removed = node;
-        bool removed_red = removed->red_;
+        bool removed_red = removed->red();
         Node* current = nullptr;
         Node* parent = end_;
 
         if (node->left_ == nullptr)
         {
             current = node->right_;
-            parent = node->parent_;
+            parent = node->parent();
             replace_node(node, node->right_);
         }
         else if (node->right_ == nullptr)
         {
             current = node->left_;
-            parent = node->parent_;
+            parent = node->parent();
             replace_node(node, node->left_);
         }
         else
         {
             removed = find_min(node->right_);
-            removed_red = removed->red_;
+            removed_red = removed->red();
             current = removed->right_;
 
-            if (removed->parent_ == node)
+            if (removed->parent() == node)
             {
                 parent = removed;
             }
             else
             {
-                parent = removed->parent_;
+                parent = removed->parent();
                 replace_node(removed, removed->right_);
                 removed->link_right(node->right_);
             }
 
             replace_node(node, removed);
             removed->link_left(node->left_);
-            removed->red_ = node->red_;
+            removed->set_red(node->red());
         }
 
-        delete node;
+        finger_ = nullptr;
+        free_node(node);
         size_--;
 
         if (size_ == 0)
@@ -331,12 +450,18 @@ protected:
             return true;
         }
 
+        // recount the subtrees from where the node was spliced out up to the root
+        for (Node* ancestor = parent; ancestor != end_; ancestor = ancestor->parent())
+        {
+            update_count(ancestor);
+        }
+
         if (removed_red == false)
         {
             solve_double_black(current, parent);
         }
 
-        root_->red_ = false;
+        root_->set_red(false);
         return true;
     }
 
@@ -353,37 +478,47 @@ public:
     {
         for (auto it = il.begin(); it != il.end(); ++it)
         {
-            insert(*it);
+            this->insert(*it);
         }
     }
 
-    /// Copy constructor.
+    /// Create a perfectly balanced tree of the elements of the range [first, last), in O(N) if they are in ascending order.
+    template <std::input_iterator InputIt>
+    RedBlackTree(InputIt first, InputIt last)
+        : BinarySearchTree<T, Node>(first, last)
+    {
+    }
+
+    /// Copy constructor, rebuilding the elements in O(N) as a perfectly balanced tree.
     RedBlackTree(const RedBlackTree& that)
-        : RedBlackTree()
+        : BinarySearchTree<T, Node>(that)
     {
-        for (const auto& element : that)
-        {
-            insert(element);
-        }
     }
 
     RedBlackTree(RedBlackTree&&) = default;
 
     RedBlackTree& operator=(RedBlackTree that)
     {
-        this->BinarySearchTree<T>::swap(that);
+        this->BinarySearchTree<T, Node>::swap(that);
         return *this;
     }
     /// @}
 
-    /// @name Manipulation
+    /// @name Examination
     /// @{
 
-    /// Insert the specified element in the tree. Return whether the element was newly inserted.
-    bool insert(const T& element) override
-    {
-        return insert_rbnode(root_, element);
-    }
+    /// Return the number of elements less than the specified element, in O(log N).
+    using BinarySearchTree<T, Node>::rank;
+
+    /// Return the k-th smallest element counting from 0, in O(log N). Throw if k is out of range.
+    using BinarySearchTree<T, Node>::select;
+
+    /// Return the number of elements in the range [lo, hi), in O(log N).
+    using BinarySearchTree<T, Node>::count_range;
+    /// @}
+
+    /// @name Manipulation
+    /// @{
 
     /// Remove the specified element from the tree. Return whether such an element was present.
     bool remove(const T& element) override
@@ -391,6 +526,31 @@ public:
         return remove_rbnode(element);
     }
 
+    /// Add the elements of the given tree, keeping the equal elements of this tree.
+    ///
+    /// The set operations are built on join and split, taking O(m log(n / m + 1)) work for trees of sizes m <= n,
+    /// and large subtrees are processed in parallel. Joining two red-black trees walks down the one with the larger black height.
+    /// The given tree is taken by value: pass it with std::move to reuse its nodes instead of copying them.
+    void union_with(RedBlackTree that)
+    {
+        BinarySearchTree<T, Node>::union_with(that);
+    }
+
+    /// Remove the elements not in the given tree.
+    void intersect_with(RedBlackTree that)
+    {
+        BinarySearchTree<T, Node>::intersect_with(that);
+    }
+
+    /// Remove the elements in the given tree.
+    void difference_with(RedBlackTree that)
+    {
+        BinarySearchTree<T, Node>::difference_with(that);
+    }
+
+    /// Remove the elements not satisfying the predicate, which may be called from several threads at once.
+    using BinarySearchTree<T, Node>::filter;
+
     /// @}
 };
 
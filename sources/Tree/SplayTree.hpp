@@ -26,21 +26,23 @@ template <typename T>
 class SplayTree : public BinarySearchTree<T>
 {
 protected:
-    using Node = typename BinarySearchTree<T>::Node;
+    using Node = detail::BinaryNode<T>;
     using BinarySearchTree<T>::size_;
     using BinarySearchTree<T>::end_;
     using BinarySearchTree<T>::root_;
+    using BinarySearchTree<T>::finger_;
+    using BinarySearchTree<T>::finger_search_;
     using BinarySearchTree<T>::set_root;
     using BinarySearchTree<T>::rotate_at;
-    using typename BinarySearchTree<T>::Iterator;
+    using BinarySearchTree<T>::free_node;
 
     // Splay the given node to the root of the tree.
     void splay(Node* node)
     {
-        while (node->parent_ != end_)
+        while (node->parent() != end_)
         {
-            Node* p = node->parent_;
-            Node* g = p->parent_;
+            Node* p = node->parent();
+            Node* g = p->parent();
 
             bool node_on_right = node == p->right_;
 
@@ -102,6 +104,8 @@ protected:
     }
 
 public:
+    using typename BinarySearchTree<T>::Iterator;
+
     /// @name Lifecycle
     /// @{
 
@@ -118,14 +122,18 @@ public:
         }
     }
 
-    /// Copy constructor.
+    /// Create a perfectly balanced tree of the elements of the range [first, last), in O(N) if they are in ascending order.
+    template <std::input_iterator InputIt>
+    SplayTree(InputIt first, InputIt last)
+        : BinarySearchTree<T>(first, last)
+    {
+    }
+
+    /// Copy constructor, rebuilding the elements in O(N) as a perfectly balanced tree.
     SplayTree(const SplayTree& that)
-        : BinarySearchTree<T>()
+        : BinarySearchTree<T>(that.begin(), that.end())
     {
-        for (const auto& element : that)
-        {
-            insert(element);
-        }
+        finger_search_ = that.finger_search_;
     }
 
     /// Move constructor.
@@ -192,12 +200,21 @@ public:
     /// @{
 
     /// Insert the specified element in the tree. Return whether the element was newly inserted.
+    /// With finger search enabled, the search climbs from the last inserted element, then the element is splayed to the root.
     bool insert(const T& element) override
     {
+        if (finger_search_ && finger_ != nullptr)
+        {
+            bool inserted = this->insert_from(finger_, element).second;
+            splay(finger_);
+            return inserted;
+        }
+
         if (root_ == nullptr)
         {
             set_root(new Node(element));
             size_++;
+            finger_ = root_;
             return true;
         }
 
@@ -208,6 +225,7 @@ public:
         // Duplicate check.
         if (root_->data() == element)
         {
+            finger_ = root_;
             return false;
         }
 
@@ -231,9 +249,19 @@ public:
             set_root(new_node);
         }
 
+        finger_ = root_;
         return true;
     }
 
+    /// Insert the specified element in the tree, searching from the hint instead of the root, then splay it to the root.
+    /// Return an iterator to the element, newly inserted or already present.
+    typename Tree<T>::Iterator insert(const typename Tree<T>::Iterator& hint, const T& element)
+    {
+        BinarySearchTree<T>::insert(hint, element);
+        splay(finger_);
+        return this->make_iterator(root_);
+    }
+
     /// Remove the specified element from the tree. Return whether such an element was present.
     bool remove(const T& element) override
     {
@@ -251,19 +279,20 @@ public:
         }
 
         Node* to_delete = root_;
+        finger_ = nullptr;
 
         if (root_->left_ == nullptr)
         {
             // Replace root with its right child.
             set_root(root_->right_);
-            delete to_delete;
+            free_node(to_delete);
             size_--;
         }
         else if (root_->right_ == nullptr)
         {
             // Replace root with its left child.
             set_root(root_->left_);
-            delete to_delete;
+            free_node(to_delete);
             size_--;
         }
         else
@@ -272,7 +301,7 @@ public:
             Node* L = root_->left_;
             Node* R = root_->right_;
 
-            delete to_delete;
+            free_node(to_delete);
             size_--;
 
             // Make L the new root.
@@ -10,6 +10,8 @@
 
 #include "../core.hpp"
 
+#include "../List/ArrayList.hpp" // for with_ascending()
+
 namespace hellods
 {
 
@@ -20,6 +22,9 @@ class Tree : public detail::ConstIterable<T>
 public:
     using typename detail::ConstIterable<T>::Iterator;
 
+    /// View of the elements in a range, walked in ascending order.
+    using Range = std::ranges::subrange<Iterator>;
+
     /// Traverse option.
     enum TraverseOption
     {
@@ -29,6 +34,30 @@ public:
         LevelOrder
     };
 
+protected:
+    // Call build(it, n) with an iterator to n strictly ascending elements, the distinct elements of the range [first, last).
+    // A range that is already strictly ascending is passed as it is, otherwise its elements are copied, sorted and deduplicated,
+    // keeping the first of equal elements like a series of insert() does.
+    template <std::input_iterator InputIt, typename Build>
+    static void with_ascending(InputIt first, InputIt last, Build build)
+    {
+        if constexpr (std::forward_iterator<InputIt>)
+        {
+            if (std::adjacent_find(first, last, [](const T& a, const T& b) { return !(a < b); }) == last)
+            {
+                build(first, int(std::distance(first, last)));
+                return;
+            }
+        }
+
+        ArrayList<T> elements;
+        elements.append_range(first, last);
+        std::stable_sort(elements.begin(), elements.end());
+        auto unique_end = std::unique(elements.begin(), elements.end(), [](const T& a, const T& b) { return !(a < b); });
+        build(elements.begin(), int(unique_end - elements.begin()));
+    }
+
+public:
     /// @name Lifecycle
     /// @{
 
@@ -66,6 +95,40 @@ public:
         return find(element) != this->end();
     }
 
+    /// Return an iterator to the first element not less than the specified element, or end() if there is no such element.
+    virtual Iterator lower_bound(const T& element) const = 0;
+
+    /// Return an iterator to the first element greater than the specified element, or end() if there is no such element.
+    virtual Iterator upper_bound(const T& element) const = 0;
+
+    /// Return the range of elements equal to the specified element, as the pair of lower_bound() and upper_bound().
+    std::pair<Iterator, Iterator> equal_range(const T& element) const
+    {
+        return {lower_bound(element), upper_bound(element)};
+    }
+
+    /// Return an iterator to the largest element not greater than the specified element, or end() if there is no such element.
+    Iterator floor(const T& element) const
+    {
+        Iterator it = upper_bound(element);
+        return it == this->begin() ? this->end() : --it;
+    }
+
+    /// Return an iterator to the smallest element not less than the specified element, or end() if there is no such element.
+    Iterator ceiling(const T& element) const
+    {
+        return lower_bound(element);
+    }
+
+    /// Return a view of the elements in the range [lo, hi), empty if !(lo < hi).
+    ///
+    /// Only the two bounds are searched, then the view walks just the elements in the range, in O(log N + K) for K elements.
+    Range range(const T& lo, const T& hi) const
+    {
+        Iterator first = lower_bound(lo);
+        return {first, lo < hi ? lower_bound(hi) : first};
+    }
+
     /// Export the tree as ASCII art.
     virtual std::string to_ascii() const = 0;
 
@@ -168,6 +168,14 @@ public:
     BasicIterator(BasicIterator&&) = default;
     BasicIterator& operator=(BasicIterator&&) = default;
 
+    /// Return a pointer to the wrapped concrete iterator if it is of type Impl, otherwise nullptr.
+    template <typename Impl>
+    const Impl* target() const
+    {
+        auto* model = dynamic_cast<const Model<Impl>*>(ptr_.get());
+        return model != nullptr ? &model->impl_ : nullptr;
+    }
+
     /// Dereference.
     RefType operator*() const
     {
@@ -9,6 +9,8 @@
 #define DETAIL_HPP
 
 #include <algorithm>  // std::copy
+#include <atomic>     // std::atomic
+#include <bit>        // std::bit_ceil std::bit_floor
 #include <cassert>    // assert
 #include <climits>    // INT_MAX
 #include <cmath>      // std::abs
@@ -18,6 +20,8 @@
 #include <memory>     // std::make_unique
 #include <optional>   // std::optional std::nullopt
 #include <ostream>    // std::ostream
+#include <ranges>     // std::ranges::subrange
+#include <span>       // std::span
 #include <sstream>    // std::ostringstream
 #include <stdexcept>  // std::runtime_error
 #include <string>     // std::string
@@ -31,6 +35,9 @@ concept Printable = requires(std::ostream& os, const T& value) {
     os << value;
 };
 
+// Size of a cache line in bytes, for laying out chunked and concurrent containers.
+inline constexpr int CACHE_LINE_SIZE = 64;
+
 // Check whether the index is valid (begin <= pos < end).
 inline void check_bounds(int pos, int begin, int end)
 {
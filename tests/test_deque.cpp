@@ -1,9 +1,12 @@
 #include "tool.hpp"
 
 #include "../sources/Deque/ArrayDeque.hpp"
+#include "../sources/Deque/BlockDeque.hpp"
 #include "../sources/Deque/LinkedDeque.hpp"
+#include "../sources/Deque/UnrolledDeque.hpp"
+#include "../sources/Deque/WorkStealingDeque.hpp"
 
-TEMPLATE_TEST_CASE("Deque", "[deque]", ArrayDeque<int>, LinkedDeque<int>)
+TEMPLATE_TEST_CASE("Deque", "[deque]", ArrayDeque<int>, LinkedDeque<int>, BlockDeque<int>, UnrolledDeque<int>)
 {
     using Deque = TestType;
 
@@ -93,3 +96,446 @@ TEMPLATE_TEST_CASE("Deque", "[deque]", ArrayDeque<int>, LinkedDeque<int>)
     REQUIRE(oss.str() == "Deque(1, 2, 3, 4, 5)");
     oss.str("");
 }
+
+// Wrap-around of the power-of-two ring buffer, and the two-segment view.
+TEST_CASE("ArrayDeque ring buffer", "[deque]")
+{
+    // Capacity is a power of two however the deque is built.
+    REQUIRE(ArrayDeque<int>().capacity() == 8);
+    REQUIRE(ArrayDeque<int>({1, 2, 3, 4, 5, 6, 7, 8, 9}).capacity() == 16);
+    ArrayDeque<int> deque = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17};
+    REQUIRE(deque.capacity() == 32);
+    for (int i = 0; i < 100; ++i)
+    {
+        deque.push_front(-i);
+        deque.push_back(i);
+    }
+    REQUIRE(deque.capacity() == 256);
+
+    // Wrap around both ways many times, checked against LinkedDeque.
+    ArrayDeque<int> ring;
+    LinkedDeque<int> model;
+    for (int i = 0; i < 1000; ++i)
+    {
+        ring.push_front(i);
+        model.push_front(i);
+        if (i % 3 == 0)
+        {
+            REQUIRE(ring.pop_back() == model.pop_back());
+        }
+    }
+    for (int i = 0; i < 1000; ++i)
+    {
+        ring.push_back(i);
+        model.push_back(i);
+        REQUIRE(ring.pop_front() == model.pop_front());
+    }
+    REQUIRE(ring.capacity() == 1024);
+    REQUIRE(std::equal(ring.begin(), ring.end(), model.begin(), model.end()));
+    REQUIRE(ring.end() - ring.begin() == model.size());
+    REQUIRE(ring.begin()[500] == *std::next(model.begin(), 500));
+
+    // Segments cover the elements in order.
+    ArrayDeque<int> wrapped;
+    for (int i = 0; i < 8; ++i)
+    {
+        wrapped.push_back(i);
+    }
+    for (int i = 0; i < 5; ++i)
+    {
+        wrapped.push_back(wrapped.pop_front() + 8);
+    }
+    auto [head, tail] = wrapped.segments();
+    REQUIRE(head.size() == 3);
+    REQUIRE(tail.size() == 5);
+    REQUIRE(std::equal(head.begin(), head.end(), wrapped.begin()));
+    REQUIRE(std::equal(tail.begin(), tail.end(), wrapped.begin() + 3, wrapped.end()));
+    head[0] = 42;
+    REQUIRE(wrapped.front() == 42);
+
+    const ArrayDeque<int> contiguous = {1, 2, 3};
+    auto [first, second] = contiguous.segments();
+    REQUIRE(first.size() == 3);
+    REQUIRE(second.empty());
+    REQUIRE(ArrayDeque<int>().segments().first.empty());
+}
+
+// Chunk boundaries at both ends, the spare chunk and the stability of references.
+TEST_CASE("UnrolledDeque chunks", "[deque]")
+{
+    // References survive growth at both ends, and iteration crosses the chunks both ways.
+    UnrolledDeque<int> deque = {0};
+    int* first = &deque.front();
+    for (int i = 1; i <= 1000; ++i)
+    {
+        deque.push_front(-i);
+        deque.push_back(i);
+    }
+    REQUIRE(*first == 0);
+    REQUIRE(deque.size() == 2001);
+    REQUIRE(std::distance(deque.begin(), deque.end()) == 2001);
+    REQUIRE(*std::next(deque.begin(), 1000) == 0);
+    REQUIRE(*std::prev(deque.end(), 1001) == 0);
+    REQUIRE(&*std::next(deque.begin(), 1000) == first);
+
+    // Drain from one end past the other end's chunk.
+    for (int i = 1000; i >= -1000; --i)
+    {
+        REQUIRE(deque.pop_back() == i);
+    }
+    REQUIRE(deque.is_empty() == true);
+    REQUIRE(deque.begin() == deque.end());
+
+    // Oscillate around chunk boundaries, checked against LinkedDeque.
+    UnrolledDeque<int> chunks;
+    LinkedDeque<int> model;
+    for (int i = 1; i < 5000; ++i)
+    {
+        if (i % 5 < 3)
+        {
+            chunks.push_front(i);
+            model.push_front(i);
+        }
+        else
+        {
+            chunks.push_back(i);
+            model.push_back(i);
+        }
+        if (i % 7 == 0)
+        {
+            REQUIRE(chunks.pop_back() == model.pop_back());
+        }
+        if (i % 11 == 0)
+        {
+            REQUIRE(chunks.pop_front() == model.pop_front());
+        }
+    }
+    REQUIRE(std::equal(chunks.begin(), chunks.end(), model.begin(), model.end()));
+    for (int i = 0; i < 200; ++i)
+    {
+        chunks.push_back(chunks.pop_front());
+        model.push_back(model.pop_front());
+    }
+    REQUIRE(std::equal(chunks.begin(), chunks.end(), model.begin(), model.end()));
+
+    // Clear keeps working chunks, and the copy owns its elements.
+    const UnrolledDeque<int> copy = chunks;
+    chunks.clear();
+    REQUIRE(chunks.is_empty() == true);
+    chunks.push_front(1);
+    chunks.push_back(2);
+    REQUIRE(chunks == UnrolledDeque<int>({1, 2}));
+    REQUIRE(std::equal(copy.begin(), copy.end(), model.begin(), model.end()));
+}
+
+// Owner and thief operations on one thread, then an owner racing against thieves.
+TEST_CASE("WorkStealingDeque", "[deque]")
+{
+    // Lifecycle
+    WorkStealingDeque<int> empty;
+    WorkStealingDeque<int> some = {1, 2, 3};
+    WorkStealingDeque<int> copy = some;
+    REQUIRE(copy == some);
+    copy = empty;
+    REQUIRE(copy == empty);
+    REQUIRE(empty.is_empty() == true);
+
+    // The owner pops LIFO at the bottom, thieves steal FIFO at the top.
+    int x = 0;
+    REQUIRE(some.try_pop(x) == true);
+    REQUIRE(x == 3);
+    REQUIRE(some.steal(x) == true);
+    REQUIRE(x == 1);
+    REQUIRE(some.try_pop(x) == true);
+    REQUIRE(x == 2);
+    REQUIRE(some.try_pop(x) == false);
+    REQUIRE(some.steal(x) == false);
+    REQUIRE(some.is_empty() == true);
+
+    // Growth keeps the elements in place while the ring has wrapped around.
+    WorkStealingDeque<int> deque;
+    for (int i = 0; i < 6; ++i)
+    {
+        deque.push(i);
+    }
+    for (int i = 0; i < 4; ++i)
+    {
+        deque.steal(x);
+    }
+    for (int i = 6; i < 100; ++i)
+    {
+        deque.push(i);
+    }
+    REQUIRE(deque.size() == 96);
+    for (int i = 4; i < 50; ++i)
+    {
+        REQUIRE(deque.steal(x) == true);
+        REQUIRE(x == i);
+    }
+    for (int i = 99; i >= 50; --i)
+    {
+        REQUIRE(deque.try_pop(x) == true);
+        REQUIRE(x == i);
+    }
+    REQUIRE(deque.is_empty() == true);
+
+    deque.push(1);
+    deque.push(2);
+    std::ostringstream oss;
+    oss << deque;
+    REQUIRE(oss.str() == "Deque(1, 2)");
+    deque.clear();
+    REQUIRE(deque.is_empty() == true);
+
+    // Every task is taken exactly once, by the owner or by a thief.
+    const int n = 100000;
+    const int thieves = 3;
+    WorkStealingDeque<int> tasks;
+    std::atomic<int> taken[n] = {};
+    std::atomic<bool> done = false;
+    std::thread threads[thieves];
+    for (auto& thread : threads)
+    {
+        thread = std::thread([&]
+                             {
+                                 int task;
+                                 while (!done || !tasks.is_empty())
+                                 {
+                                     if (tasks.steal(task))
+                                     {
+                                         taken[task].fetch_add(1);
+                                     }
+                                 }
+                             });
+    }
+    int task;
+    for (int i = 0; i < n; ++i)
+    {
+        tasks.push(i);
+        if (i % 3 == 0 && tasks.try_pop(task))
+        {
+            taken[task].fetch_add(1);
+        }
+    }
+    while (tasks.try_pop(task))
+    {
+        taken[task].fetch_add(1);
+    }
+    done = true;
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    REQUIRE(std::all_of(std::begin(taken), std::end(taken), [](const std::atomic<int>& count) { return count == 1; }));
+
+    // A pop that loses the last element to a thief leaves the target untouched.
+    WorkStealingDeque<int> race;
+    std::atomic<bool> stop = false;
+    std::thread thief([&]
+                      {
+                          int stolen;
+                          while (!stop)
+                          {
+                              race.steal(stolen);
+                          }
+                      });
+    int clobbered = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        race.push(i);
+        int popped = -1;
+        if (!race.try_pop(popped))
+        {
+            clobbered += popped != -1;
+        }
+    }
+    stop = true;
+    thief.join();
+    REQUIRE(clobbered == 0);
+}
+
+// Block boundaries at both ends, random access and the stability of references.
+TEST_CASE("BlockDeque blocks", "[deque]")
+{
+    constexpr int B = BlockDeque<int>::BLOCK_SIZE;
+
+    // References survive growth at both ends.
+    BlockDeque<int> deque = {0};
+    int* first = &deque.front();
+    for (int i = 1; i <= 10 * B; ++i)
+    {
+        deque.push_front(-i);
+        deque.push_back(i);
+    }
+    REQUIRE(first == &deque[10 * B]);
+    REQUIRE(*first == 0);
+    REQUIRE(deque.size() == 20 * B + 1);
+    REQUIRE(deque[0] == -10 * B);
+    REQUIRE(deque[20 * B] == 10 * B);
+    REQUIRE_THROWS_MATCHES(deque[20 * B + 1], std::runtime_error, Message("Error: Index out of range."));
+    REQUIRE_THROWS_MATCHES(deque[-1], std::runtime_error, Message("Error: Index out of range."));
+    REQUIRE(deque.end() - deque.begin() == 20 * B + 1);
+    REQUIRE(deque.begin()[5 * B + 3] == -5 * B + 3);
+
+    // Draining one end frees blocks without moving the rest.
+    int* back = &deque.back();
+    for (int i = -10 * B; i < 0; ++i)
+    {
+        REQUIRE(deque.pop_front() == i);
+    }
+    REQUIRE(first == &deque.front());
+    REQUIRE(back == &deque.back());
+
+    // Push and pop across block boundaries many times, checked against LinkedDeque.
+    BlockDeque<int> blocks;
+    LinkedDeque<int> model;
+    for (int i = 1; i < 20 * B; ++i)
+    {
+        if (i % 5 < 3)
+        {
+            blocks.push_front(i);
+            model.push_front(i);
+        }
+        else
+        {
+            blocks.push_back(i);
+            model.push_back(i);
+        }
+        if (i % 7 == 0)
+        {
+            REQUIRE(blocks.pop_back() == model.pop_back());
+        }
+        if (i % 11 == 0)
+        {
+            REQUIRE(blocks.pop_front() == model.pop_front());
+        }
+    }
+    REQUIRE(std::equal(blocks.begin(), blocks.end(), model.begin(), model.end()));
+    while (!model.is_empty())
+    {
+        REQUIRE(blocks.pop_back() == model.pop_back());
+        if (!model.is_empty())
+        {
+            REQUIRE(blocks.pop_front() == model.pop_front());
+        }
+    }
+    REQUIRE(blocks.is_empty() == true);
+
+    // Elements that own memory.
+    BlockDeque<std::string> strings;
+    for (int i = 0; i < 3 * BlockDeque<std::string>::BLOCK_SIZE; ++i)
+    {
+        strings.push_back(std::string(32, char('a' + i % 26)));
+    }
+    const BlockDeque<std::string> copy = strings;
+    strings.clear();
+    REQUIRE(strings.is_empty() == true);
+    REQUIRE(copy[27] == std::string(32, 'b'));
+    strings.push_front("x");
+    REQUIRE(strings == BlockDeque<std::string>({"x"}));
+}
+
+// Explicit and automatic shrinking after a burst.
+TEST_CASE("ArrayDeque shrink", "[deque]")
+{
+    // A burst leaves a large buffer behind until it is shrunk.
+    ArrayDeque<int> deque;
+    for (int i = 0; i < 1000; ++i)
+    {
+        deque.push_back(i);
+    }
+    for (int i = 0; i < 995; ++i)
+    {
+        deque.pop_front();
+    }
+    REQUIRE(deque.capacity() == 1024);
+    deque.shrink_to_fit();
+    REQUIRE(deque.capacity() == 8);
+    REQUIRE(deque == ArrayDeque<int>({995, 996, 997, 998, 999}));
+    deque.shrink_to_fit(); // already fits
+    REQUIRE(deque.capacity() == 8);
+
+    // Shrinking a wrapped-around buffer keeps the order.
+    for (int i = 0; i < 20; ++i)
+    {
+        deque.push_front(-i);
+    }
+    for (int i = 0; i < 10; ++i)
+    {
+        deque.pop_back();
+    }
+    REQUIRE(deque.segments().second.empty() == false);
+    deque.shrink_to_fit();
+    REQUIRE(deque.capacity() == 16);
+    REQUIRE(deque.segments().second.empty() == true);
+    REQUIRE(deque.size() == 15);
+    REQUIRE(deque.front() == -19);
+    REQUIRE(deque.back() == -5);
+
+    // Auto-shrink halves the buffer below a quarter, and never thrashes around a boundary.
+    ArrayDeque<int> automatic;
+    automatic.set_auto_shrink(true);
+    for (int i = 0; i < 1024; ++i)
+    {
+        automatic.push_back(i);
+    }
+    REQUIRE(automatic.capacity() == 1024);
+    while (automatic.size() > 255)
+    {
+        automatic.pop_front();
+    }
+    REQUIRE(automatic.capacity() == 512);
+    for (int i = 0; i < 1000; ++i)
+    {
+        automatic.push_back(i);
+        automatic.pop_back();
+        automatic.pop_front();
+        automatic.push_front(i);
+    }
+    REQUIRE(automatic.capacity() == 512);
+    REQUIRE(automatic.size() == 255);
+    int out[255];
+    REQUIRE(automatic.pop_front_n(out, 255) == 255);
+    REQUIRE(automatic.capacity() == 8);
+    automatic.push_back(1);
+    automatic.clear();
+    REQUIRE(automatic.capacity() == 8);
+}
+
+// Batch operations across the wrap-around and growth of the ring buffer.
+TEST_CASE("ArrayDeque batch", "[deque]")
+{
+    int input[100];
+    std::iota(std::begin(input), std::end(input), 0);
+    int output[100] = {};
+
+    // Wrap the ring, then push a batch that wraps too.
+    ArrayDeque<int> deque;
+    deque.push_back_range(input, input + 6);
+    REQUIRE(deque.pop_front_n(output, 4) == 4);
+    REQUIRE(std::equal(output, output + 4, input));
+    deque.push_back_range(input + 6, input + 10);
+    REQUIRE(deque.capacity() == 8);
+    REQUIRE(std::equal(deque.begin(), deque.end(), input + 4, input + 10));
+
+    // Grow once while wrapped around.
+    deque.push_back_range(input + 10, input + 100);
+    REQUIRE(deque.capacity() == 128);
+    REQUIRE(std::equal(deque.begin(), deque.end(), input + 4, input + 100));
+
+    // Drain in uneven batches, asking for more than there is at the end.
+    int taken = 0;
+    while (int count = deque.pop_front_n(output + taken, 13))
+    {
+        taken += count;
+    }
+    REQUIRE(taken == 96);
+    REQUIRE(std::equal(output, output + 96, input + 4));
+    REQUIRE(deque.is_empty() == true);
+    REQUIRE(deque.pop_front_n(output, -1) == 0);
+
+    // Single-pass input falls back to one push per element.
+    std::istringstream iss("1 2 3");
+    deque.push_back_range(std::istream_iterator<int>(iss), std::istream_iterator<int>());
+    REQUIRE(deque == ArrayDeque<int>({1, 2, 3}));
+}
@@ -116,3 +116,22 @@ TEMPLATE_TEST_CASE("Heap", "[heap]", BinaryHeap<int>, (BinaryHeap<int, std::less
     }
     oss.str("");
 }
+
+TEST_CASE("BinaryHeap shrink", "[heap]")
+{
+    BinaryHeap<int> heap;
+    heap.set_auto_shrink(true);
+    for (int i = 0; i < 1000; ++i)
+    {
+        heap.push(i);
+    }
+    REQUIRE(heap.capacity() == 1024);
+    for (int i = 999; i >= 10; --i)
+    {
+        REQUIRE(heap.pop() == i);
+    }
+    REQUIRE(heap.capacity() < 64);
+    heap.shrink_to_fit();
+    REQUIRE(heap.capacity() == 10);
+    REQUIRE(heap.peek() == 9);
+}
@@ -2,9 +2,13 @@
 
 #include "../sources/List/ArrayList.hpp"
 #include "../sources/List/LinkedList.hpp"
+#include "../sources/List/MappedArrayList.hpp"
+#include "../sources/List/PersistentVector.hpp"
 #include "../sources/List/SinglyLinkedList.hpp"
+#include "../sources/List/TreeList.hpp"
+#include "../sources/List/UnrolledLinkedList.hpp"
 
-TEMPLATE_TEST_CASE("List", "[list]", ArrayList<int>, LinkedList<int>, SinglyLinkedList<int>)
+TEMPLATE_TEST_CASE("List", "[list]", ArrayList<int>, LinkedList<int>, SinglyLinkedList<int>, UnrolledLinkedList<int>, TreeList<int>, MappedArrayList<int>)
 {
     using List = TestType;
 
@@ -138,3 +142,532 @@ TEMPLATE_TEST_CASE("List", "[list]", ArrayList<int>, LinkedList<int>, SinglyLink
     REQUIRE(oss.str() == "List(1, 2, 3, 4, 5)");
     oss.str("");
 }
+
+// Operations that cross chunk boundaries, checked against ArrayList.
+TEST_CASE("ArrayList append_range", "[list]")
+{
+    int input[100];
+    std::iota(std::begin(input), std::end(input), 0);
+
+    ArrayList<int> list = {-1};
+    list.append_range(std::begin(input), std::end(input));
+    REQUIRE(list.size() == 101);
+    REQUIRE(list[0] == -1);
+    REQUIRE(std::equal(list.begin() + 1, list.end(), input));
+
+    std::istringstream iss("100 101");
+    list.append_range(std::istream_iterator<int>(iss), std::istream_iterator<int>());
+    REQUIRE(list.size() == 103);
+    REQUIRE(list[102] == 101);
+}
+
+TEST_CASE("ArrayList shrink", "[list]")
+{
+    ArrayList<int> list;
+    for (int i = 0; i < 1000; ++i)
+    {
+        list.append(i);
+    }
+    REQUIRE(list.capacity() == 1024);
+
+    // Off by default.
+    for (int i = 0; i < 900; ++i)
+    {
+        list.pop();
+    }
+    REQUIRE(list.capacity() == 1024);
+
+    // Turning it on shrinks right away, then again below a quarter.
+    list.set_auto_shrink(true);
+    REQUIRE(list.capacity() == 200);
+    while (list.size() > 49)
+    {
+        list.remove(0);
+    }
+    REQUIRE(list.capacity() == 98);
+    REQUIRE(list[0] == 51);
+
+    // Oscillating around the thresholds does not reallocate.
+    for (int i = 0; i < 100; ++i)
+    {
+        list.append(i);
+        list.pop();
+        list.pop();
+        list.append(i);
+    }
+    REQUIRE(list.capacity() == 98);
+
+    // Explicit shrinking stops at the initial capacity.
+    list.shrink_to_fit();
+    REQUIRE(list.capacity() == 49);
+    list.clear();
+    REQUIRE(list.capacity() == 8);
+    list.set_auto_shrink(false);
+    list.append(1);
+    list.shrink_to_fit();
+    REQUIRE(list.capacity() == 8);
+    REQUIRE(list == ArrayList<int>({1}));
+}
+
+TEST_CASE("UnrolledLinkedList chunks", "[list]")
+{
+    UnrolledLinkedList<int> list;
+    ArrayList<int> expected;
+
+    // Mid-list inserts split full chunks.
+    for (int i = 0; i < 1000; ++i)
+    {
+        int index = (i * 7919) % (expected.size() + 1);
+        list.insert(index, i);
+        expected.insert(index, i);
+    }
+    REQUIRE(list.size() == 1000);
+    REQUIRE(std::equal(list.begin(), list.end(), expected.begin(), expected.end()));
+    for (int i = 0; i < 1000; ++i)
+    {
+        REQUIRE(list[i] == expected[i]);
+    }
+
+    // Backward iteration walks chunks in reverse.
+    auto it = list.end();
+    for (int i = 999; i >= 0; --i)
+    {
+        REQUIRE(*--it == expected[i]);
+    }
+    REQUIRE(it == list.begin());
+
+    // Mid-list removes merge sparse chunks.
+    for (int i = 0; i < 900; ++i)
+    {
+        int index = (i * 104729) % expected.size();
+        REQUIRE(list.remove(index) == expected.remove(index));
+    }
+    REQUIRE(list.size() == 100);
+    REQUIRE(std::equal(list.begin(), list.end(), expected.begin(), expected.end()));
+
+    // Drain from the back.
+    while (!expected.is_empty())
+    {
+        REQUIRE(list.pop() == expected.pop());
+    }
+    REQUIRE(list.is_empty() == true);
+    REQUIRE(list.begin() == list.end());
+
+    // Sized constructor.
+    UnrolledLinkedList<int> zeros(100);
+    REQUIRE(zeros.size() == 100);
+    REQUIRE(std::all_of(zeros.begin(), zeros.end(), [](int x) { return x == 0; }));
+}
+
+// Relinking operations, checked against ArrayList. Appending afterwards checks the tail is kept right.
+TEMPLATE_TEST_CASE("Linked list relinking", "[list]", LinkedList<int>, SinglyLinkedList<int>)
+{
+    using List = TestType;
+
+    // Split at every kind of position, then concat back.
+    List list = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    ArrayList<int> expected = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    for (int index : {0, 1, 5, 9, 10})
+    {
+        List tail = list.split_at(index);
+        REQUIRE(std::equal(list.begin(), list.end(), expected.begin(), expected.begin() + index));
+        REQUIRE(std::equal(tail.begin(), tail.end(), expected.begin() + index, expected.end()));
+
+        list.concat(tail);
+        REQUIRE(tail.is_empty() == true);
+        REQUIRE(std::equal(list.begin(), list.end(), expected.begin(), expected.end()));
+
+        tail.append(-1);
+        REQUIRE(tail[0] == -1);
+    }
+    REQUIRE_THROWS_MATCHES(list.split_at(11), std::runtime_error, Message("Error: Index out of range."));
+
+    List self = {1, 2, 3};
+    self.concat(self);
+    REQUIRE(self == List({1, 2, 3, 1, 2, 3}));
+
+    // Splice between lists.
+    List other = {10, 11, 12, 13};
+    list.splice(3, other, 1, 3);
+    REQUIRE(list == List({0, 1, 2, 11, 12, 3, 4, 5, 6, 7, 8, 9}));
+    REQUIRE(other == List({10, 13}));
+    list.splice(list.size(), other, 1, 2);
+    other.splice(0, list, 0, 3);
+    REQUIRE(list == List({11, 12, 3, 4, 5, 6, 7, 8, 9, 13}));
+    REQUIRE(other == List({0, 1, 2, 10}));
+    other.splice(1, other, 0, 0);
+    REQUIRE_THROWS_MATCHES(other.splice(0, list, 3, 1), std::runtime_error, Message("Error: Index out of range."));
+    list.append(99);
+    other.append(99);
+    REQUIRE(list[list.size() - 1] == 99);
+    REQUIRE(other == List({0, 1, 2, 10, 99}));
+
+    // Splice within a list.
+    List within = {0, 1, 2, 3, 4, 5};
+    within.splice(6, within, 0, 2);
+    REQUIRE(within == List({2, 3, 4, 5, 0, 1}));
+    within.splice(0, within, 4, 6);
+    REQUIRE(within == List({0, 1, 2, 3, 4, 5}));
+    within.splice(2, within, 2, 4);
+    within.splice(4, within, 2, 4);
+    REQUIRE(within == List({0, 1, 2, 3, 4, 5}));
+    REQUIRE_THROWS_MATCHES(within.splice(3, within, 2, 4), std::runtime_error, Message("Error: Index out of range."));
+    within.append(6);
+    REQUIRE(within == List({0, 1, 2, 3, 4, 5, 6}));
+
+    // Stable merge of sorted lists.
+    List a = {1, 3, 3, 5, 7};
+    List b = {0, 3, 4, 8, 9};
+    a.merge(b);
+    REQUIRE(a == List({0, 1, 3, 3, 3, 4, 5, 7, 8, 9}));
+    REQUIRE(b.is_empty() == true);
+    b.merge(a);
+    REQUIRE(b == List({0, 1, 3, 3, 3, 4, 5, 7, 8, 9}));
+    REQUIRE(a.is_empty() == true);
+    b.merge(b);
+    b.append(10);
+    a.append(-1);
+    REQUIRE(b[10] == 10);
+    REQUIRE(a == List({-1}));
+
+    List big;
+    List small = {-5, 500, 2000};
+    for (int i = 0; i < 1000; ++i)
+    {
+        big.append(i);
+    }
+    big.merge(small);
+    REQUIRE(big.size() == 1003);
+    REQUIRE(std::is_sorted(big.begin(), big.end()));
+    REQUIRE(big[0] == -5);
+    REQUIRE(big[1002] == 2000);
+}
+
+class InspectableTreeList : public TreeList<int>
+{
+    using Node = typename TreeList<int>::Node;
+    using TreeList<int>::end_;
+    using TreeList<int>::root_;
+
+    bool verify_node(Node* node) const
+    {
+        if (node == nullptr)
+        {
+            return true;
+        }
+
+        int left_h = node->left_ ? node->left_->height_ : 0;
+        int right_h = node->right_ ? node->right_->height_ : 0;
+        int left_s = node->left_ ? node->left_->size_ : 0;
+        int right_s = node->right_ ? node->right_->size_ : 0;
+
+        if (node->height_ != 1 + std::max(left_h, right_h) || std::abs(left_h - right_h) > 1 || node->size_ != 1 + left_s + right_s)
+        {
+            return false;
+        }
+        if ((node->left_ && node->left_->parent_ != node) || (node->right_ && node->right_->parent_ != node))
+        {
+            return false;
+        }
+
+        return verify_node(node->left_) && verify_node(node->right_);
+    }
+
+public:
+    using TreeList<int>::TreeList;
+
+    InspectableTreeList(TreeList<int>&& that)
+        : TreeList<int>(std::move(that))
+    {
+    }
+
+    bool verify_invariants() const
+    {
+        if (root_ == nullptr)
+        {
+            return size() == 0;
+        }
+        return root_->parent_ == end_ && root_->size_ == size() && verify_node(root_);
+    }
+};
+
+// Positional operations, split and concat, checked against ArrayList.
+TEST_CASE("TreeList specific", "[list]")
+{
+    InspectableTreeList list;
+    ArrayList<int> expected;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        int index = (i * 7919) % (expected.size() + 1);
+        list.insert(index, i);
+        expected.insert(index, i);
+        REQUIRE(list.verify_invariants() == true);
+    }
+    REQUIRE(std::equal(list.begin(), list.end(), expected.begin(), expected.end()));
+    for (int i = 0; i < 1000; ++i)
+    {
+        REQUIRE(list[i] == expected[i]);
+    }
+
+    auto it = list.end();
+    for (int i = 999; i >= 0; --i)
+    {
+        REQUIRE(*--it == expected[i]);
+    }
+    REQUIRE(it == list.begin());
+
+    for (int i = 0; i < 500; ++i)
+    {
+        int index = (i * 104729) % expected.size();
+        REQUIRE(list.remove(index) == expected.remove(index));
+        REQUIRE(list.verify_invariants() == true);
+    }
+    REQUIRE(std::equal(list.begin(), list.end(), expected.begin(), expected.end()));
+
+    // Split at every kind of position, then concat back.
+    for (int index : {0, 1, 250, 499, 500})
+    {
+        InspectableTreeList tail = list.split_at(index);
+        REQUIRE(list.size() == index);
+        REQUIRE(tail.size() == 500 - index);
+        REQUIRE(list.verify_invariants() == true);
+        REQUIRE(tail.verify_invariants() == true);
+        REQUIRE(std::equal(list.begin(), list.end(), expected.begin(), expected.begin() + index));
+        REQUIRE(std::equal(tail.begin(), tail.end(), expected.begin() + index, expected.end()));
+
+        list.concat(tail);
+        REQUIRE(tail.is_empty() == true);
+        REQUIRE(list.verify_invariants() == true);
+        REQUIRE(std::equal(list.begin(), list.end(), expected.begin(), expected.end()));
+    }
+    REQUIRE_THROWS_MATCHES(list.split_at(501), std::runtime_error, Message("Error: Index out of range."));
+
+    // Concat lists of very different heights.
+    InspectableTreeList small = {-1, -2};
+    small.concat(list);
+    REQUIRE(small.size() == 502);
+    REQUIRE(small.verify_invariants() == true);
+    REQUIRE(small[0] == -1);
+    REQUIRE(small[2] == expected[0]);
+
+    InspectableTreeList self = {1, 2, 3};
+    self.concat(self);
+    REQUIRE(self == TreeList<int>({1, 2, 3, 1, 2, 3}));
+    REQUIRE(self.verify_invariants() == true);
+}
+
+TEST_CASE("PersistentVector", "[list]")
+{
+    // Lifecycle
+    PersistentVector<int> empty;
+    PersistentVector<int> some = {1, 2, 3, 4, 5};
+
+    PersistentVector<int> copy = some;
+    REQUIRE(copy == some);
+    copy = empty;
+    REQUIRE(copy == empty);
+    PersistentVector<int> mv = std::move(some);
+    REQUIRE(mv == PersistentVector<int>({1, 2, 3, 4, 5}));
+    REQUIRE(mv[4] == 5);
+    REQUIRE_THROWS_MATCHES(mv[5], std::runtime_error, Message("Error: Index out of range."));
+    REQUIRE_THROWS_MATCHES(empty.pop(), std::runtime_error, Message("Error: The container is empty."));
+
+    // Grow through several trie levels, taking snapshots along the way.
+    const int n = 40000;
+    PersistentVector<int> vector;
+    const int sizes[] = {1, 32, 33, 1056, 33001};
+    PersistentVector<int> snapshots[5];
+    for (int i = 0, k = 0; i < n; ++i)
+    {
+        vector.append(i);
+        if (k < 5 && vector.size() == sizes[k])
+        {
+            snapshots[k++] = vector;
+        }
+    }
+    REQUIRE(vector.size() == n);
+    for (int i = 0; i < n; ++i)
+    {
+        REQUIRE(vector[i] == i);
+    }
+
+    // Updates on the original do not disturb the snapshots, and vice versa.
+    for (int i = 0; i < n; i += 7)
+    {
+        vector.set(i, -i);
+    }
+    PersistentVector<int> before_pop = vector;
+    for (int i = 0; i < 30000; ++i)
+    {
+        REQUIRE(vector.pop() == (((n - 1 - i) % 7 == 0) ? -(n - 1 - i) : n - 1 - i));
+    }
+    REQUIRE(vector.size() == n - 30000);
+    snapshots[4].set(0, 42);
+    REQUIRE(vector[0] == 0);
+
+    for (int k = 0; k < 5; ++k)
+    {
+        REQUIRE(snapshots[k].size() == sizes[k]);
+        for (int i = 0; i < sizes[k]; ++i)
+        {
+            REQUIRE(snapshots[k][i] == ((k == 4 && i == 0) ? 42 : i));
+        }
+    }
+    REQUIRE(before_pop.size() == n);
+    REQUIRE(before_pop[n - 1] == n - 1);
+    REQUIRE(before_pop[n - 2] == -(n - 2));
+
+    // Pop everything, then reuse.
+    while (!vector.is_empty())
+    {
+        vector.pop();
+    }
+    vector.append(7);
+    REQUIRE(vector == PersistentVector<int>({7}));
+
+    // Iterators walk chunk by chunk, in both directions.
+    PersistentVector<int> seq;
+    for (int i = 0; i < 1000; ++i)
+    {
+        seq.append(i);
+    }
+    int i = 0;
+    for (int x : seq)
+    {
+        REQUIRE(x == i++);
+    }
+    auto it = seq.end();
+    for (int i = 999; i >= 0; --i)
+    {
+        REQUIRE(*--it == i);
+    }
+    REQUIRE(it == seq.begin());
+    REQUIRE(*(seq.begin() + 500) == 500);
+    REQUIRE(seq.end() - seq.begin() == 1000);
+
+    long long sum = 0;
+    int chunks = 0;
+    seq.for_each_chunk([&](const int* data, int length)
+                       {
+                           for (int j = 0; j < length; ++j)
+                           {
+                               sum += data[j];
+                           }
+                           ++chunks; });
+    REQUIRE(sum == 999 * 1000 / 2);
+    REQUIRE(chunks == 32);
+
+    // Readers on other threads see their own consistent snapshots while the writer keeps going.
+    PersistentVector<int> shared;
+    std::thread readers[4];
+    bool consistent[4] = {};
+    for (int r = 0; r < 4; ++r)
+    {
+        for (int j = 0; j < 2000; ++j)
+        {
+            shared.append(j);
+        }
+        readers[r] = std::thread([snapshot = shared, &result = consistent[r]]
+                                 {
+                                     result = snapshot.size() > 0;
+                                     for (int j = 0; j < snapshot.size(); ++j)
+                                     {
+                                         result = result && snapshot[j] == j % 2000;
+                                     } });
+    }
+    for (int j = 0; j < shared.size(); j += 3)
+    {
+        shared.set(j, -1);
+    }
+    while (!shared.is_empty())
+    {
+        shared.pop();
+    }
+    for (int r = 0; r < 4; ++r)
+    {
+        readers[r].join();
+        REQUIRE(consistent[r] == true);
+    }
+
+    // Print
+    std::ostringstream oss;
+    oss << PersistentVector<int>({1, 2, 3});
+    REQUIRE(oss.str() == "List(1, 2, 3)");
+}
+
+// Persistence across reopen, growth by remapping, and type checking of the file.
+TEST_CASE("MappedArrayList file", "[list]")
+{
+    std::string path = (std::filesystem::temp_directory_path() / "hellods_mapped_array_list.bin").string();
+    std::filesystem::remove(path);
+
+    // Grow well past the first mapping increment.
+    const int n = 1 << 20;
+    {
+        MappedArrayList<int> list(path);
+        REQUIRE(list.path() == path);
+        REQUIRE(list.is_empty() == true);
+        for (int i = 0; i < n; ++i)
+        {
+            list.append(i);
+        }
+        list.insert(0, -1);
+        REQUIRE(list.remove(0) == -1);
+        list.flush();
+    }
+    REQUIRE(std::filesystem::file_size(path) >= sizeof(int) * n);
+
+    // Reopen without parsing, the elements are still there.
+    {
+        MappedArrayList<int> list(path);
+        REQUIRE(list.size() == n);
+        for (int i = 0; i < n; i += 4099)
+        {
+            REQUIRE(list[i] == i);
+        }
+        list[0] = 42;
+        list.pop();
+    }
+    {
+        const MappedArrayList<int> list(path);
+        REQUIRE(list.size() == n - 1);
+        REQUIRE(list[0] == 42);
+        REQUIRE(list[n - 2] == n - 2);
+
+        // A copy lives in anonymous memory and does not write to the file.
+        MappedArrayList<int> copy = list;
+        REQUIRE(copy.path().empty());
+        REQUIRE(copy == list);
+        copy.clear();
+        REQUIRE(list.size() == n - 1);
+    }
+
+    // Assignment copies into the file instead of detaching from it.
+    {
+        MappedArrayList<int> list(path);
+        MappedArrayList<int> small = {1, 2, 3};
+        list = small;
+        REQUIRE(list.path() == path);
+    }
+    REQUIRE(MappedArrayList<int>(path) == MappedArrayList<int>({1, 2, 3}));
+
+    // Reopening with another element type is rejected.
+    REQUIRE_THROWS_MATCHES(MappedArrayList<double>(path), std::runtime_error, Message("Error: The file does not hold a list of this element type."));
+
+    // A header with a negative size is rejected.
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(2 * sizeof(std::uint64_t));
+        std::int64_t size = -1;
+        file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    }
+    REQUIRE_THROWS_MATCHES(MappedArrayList<int>(path), std::runtime_error, Message("Error: The file does not hold a list of this element type."));
+
+    // A file shorter than the header is rejected without being extended.
+    std::filesystem::resize_file(path, 8);
+    REQUIRE_THROWS_MATCHES(MappedArrayList<int>(path), std::runtime_error, Message("Error: The file does not hold a list of this element type."));
+    REQUIRE(std::filesystem::file_size(path) == 8);
+
+    std::filesystem::remove(path);
+}
@@ -1,9 +1,12 @@
 #include "tool.hpp"
 
+#include "../sources/Map/ConcurrentSkipListMap.hpp"
 #include "../sources/Map/HashMap.hpp"
 #include "../sources/Map/TreeMap.hpp"
+#include "../sources/Tree/BTree.hpp"
+#include "../sources/Tree/PersistentAVLTree.hpp"
 
-TEMPLATE_TEST_CASE("Map", "[map]", (HashMap<int, std::string>), (TreeMap<int, std::string>))
+TEMPLATE_TEST_CASE("Map", "[map]", (HashMap<int, std::string>), (TreeMap<int, std::string>), (TreeMap<int, std::string, BTree<detail::MapEntry<int, std::string>>>), (TreeMap<int, std::string, PersistentAVLTree<detail::MapEntry<int, std::string>>>), (ConcurrentSkipListMap<int, std::string>))
 {
     using Map = TestType;
 
@@ -147,3 +150,296 @@ TEMPLATE_TEST_CASE("Map", "[map]", (HashMap<int, std::string>), (TreeMap<int, st
     REQUIRE(oss.str() == "Map(1: one, 2: two, 3: three)");
     oss.str("");
 }
+
+TEST_CASE("HashMap shrink", "[map]")
+{
+    HashMap<int, int> map;
+    for (int i = 0; i < 1000; ++i)
+    {
+        map.insert(i, i);
+    }
+    int peak = map.capacity();
+    REQUIRE(peak > 2000);
+
+    // Deleted slots stay until the map is rehashed.
+    for (int i = 0; i < 990; ++i)
+    {
+        map.remove(i);
+    }
+    REQUIRE(map.capacity() == peak);
+    map.shrink_to_fit();
+    REQUIRE(map.capacity() == 23);
+    REQUIRE(map.size() == 10);
+    REQUIRE(map[995] == 995);
+
+    // Auto-shrink keeps the loading factor between 1/8 and 1/2, with room to spare at both ends.
+    HashMap<int, int> automatic;
+    automatic.set_auto_shrink(true);
+    for (int i = 0; i < 1000; ++i)
+    {
+        automatic.insert(i, i);
+    }
+    for (int i = 0; i < 1000; ++i)
+    {
+        REQUIRE(automatic.remove(i));
+        REQUIRE(automatic.size() * 8 >= automatic.capacity() - 8);
+        REQUIRE(automatic.size() * 2 <= automatic.capacity());
+    }
+    REQUIRE(automatic.capacity() == 7);
+    for (int i = 0; i < 100; ++i)
+    {
+        automatic.insert(i, i);
+    }
+    int capacity = automatic.capacity();
+    for (int i = 0; i < 100; ++i)
+    {
+        automatic.remove(i);
+        automatic.insert(i, i);
+    }
+    REQUIRE(automatic.capacity() == capacity);
+    REQUIRE(automatic.size() == 100);
+}
+
+TEST_CASE("TreeMap order statistics", "[map]")
+{
+    // Players ordered by id.
+    TreeMap<int, std::string> players = {{30, "c"}, {10, "a"}, {50, "e"}, {20, "b"}, {40, "d"}};
+    REQUIRE(players.rank(10) == 0);
+    REQUIRE(players.rank(35) == 3);
+    REQUIRE(players.select(1).key() == 20);
+    REQUIRE(players.select(1).value() == "b");
+    REQUIRE(players.select(4).key() == 50);
+    REQUIRE_THROWS_MATCHES(players.select(5), std::runtime_error, Message("Error: Index out of range."));
+    REQUIRE(players.count_range(20, 50) == 3);
+
+    players.remove(20);
+    REQUIRE(players.select(1).key() == 30);
+    REQUIRE(players.count_range(0, 100) == 4);
+}
+
+TEST_CASE("TreeMap bounds and ranges", "[map]")
+{
+    // Events indexed by timestamp.
+    TreeMap<int, std::string> events = {{100, "boot"}, {250, "login"}, {300, "read"}, {420, "write"}, {900, "logout"}};
+    const auto& view = events;
+
+    REQUIRE(events.lower_bound(250)->key() == 250);
+    REQUIRE(events.upper_bound(250)->key() == 300);
+    REQUIRE(view.lower_bound(901) == view.end());
+    REQUIRE(events.floor(299)->value() == "login");
+    REQUIRE(events.floor(99) == events.end());
+    REQUIRE(view.ceiling(301)->value() == "write");
+
+    auto [first, last] = view.equal_range(420);
+    REQUIRE(std::distance(first, last) == 1);
+    REQUIRE(first->value() == "write");
+
+    // Events in the window [200, 500).
+    std::vector<std::string> window;
+    for (const auto& entry : view.range(200, 500))
+    {
+        window.push_back(entry.value());
+    }
+    REQUIRE(window == std::vector<std::string>{"login", "read", "write"});
+    REQUIRE(view.range(500, 200).empty());
+
+    // Values in a window are mutable through the non-const view.
+    for (auto& entry : events.range(0, 300))
+    {
+        entry.value() += "!";
+    }
+    REQUIRE(events[100] == "boot!");
+    REQUIRE(events[250] == "login!");
+    REQUIRE(events[300] == "read");
+}
+
+TEST_CASE("TreeMap hinted insertion", "[map]")
+{
+    // Samples of a time series arrive in order of timestamp, each hinted by the previous one.
+    TreeMap<int, std::string> samples;
+    auto hint = samples.end();
+    for (int t = 0; t < 100; t += 10)
+    {
+        hint = samples.insert(hint, t, std::to_string(t));
+        REQUIRE(hint->key() == t);
+    }
+    REQUIRE(samples.size() == 10);
+
+    // A present key keeps its value, the returned iterator gives mutable access.
+    auto it = samples.insert(samples.begin(), 50, "late");
+    REQUIRE(it->value() == "50");
+    it->value() = "updated";
+    REQUIRE(samples[50] == "updated");
+
+    // A late sample with finger search, which starts from the last insertion.
+    samples.set_finger_search(true);
+    REQUIRE(samples.insert(95, "95") == true);
+    REQUIRE(samples.insert(85, "85") == true);
+    REQUIRE(samples.insert(85, "again") == false);
+    REQUIRE(samples.size() == 12);
+    REQUIRE(samples.select(10).key() == 90);
+    REQUIRE(samples.floor(89)->value() == "85");
+}
+
+TEMPLATE_TEST_CASE("TreeMap range constructor", "[map]", (TreeMap<int, std::string>), (TreeMap<int, std::string, BTree<detail::MapEntry<int, std::string>>>), (TreeMap<int, std::string, PersistentAVLTree<detail::MapEntry<int, std::string>>>))
+{
+    using Map = TestType;
+
+    std::vector<std::pair<int, std::string>> sorted = {{1, "one"}, {2, "two"}, {3, "three"}, {5, "five"}};
+    Map map(sorted.begin(), sorted.end());
+    REQUIRE(map.size() == 4);
+    REQUIRE(map[3] == "three");
+    REQUIRE(map == Map({{1, "one"}, {2, "two"}, {3, "three"}, {5, "five"}}));
+
+    // Unsorted pairs, the first of equal keys is kept like insert() does.
+    std::vector<std::pair<int, std::string>> unsorted = {{5, "five"}, {1, "one"}, {5, "FIVE"}, {2, "two"}};
+    Map other(unsorted.begin(), unsorted.end());
+    REQUIRE(other.size() == 3);
+    REQUIRE(other[5] == "five");
+    REQUIRE(other.begin()->key() == 1);
+}
+
+TEST_CASE("TreeMap snapshots", "[map]")
+{
+    // A configuration index, snapshotted for each request while the writer keeps updating it.
+    TreeMap<int, std::string, PersistentAVLTree<detail::MapEntry<int, std::string>>> config;
+    for (int key = 0; key < 100; ++key)
+    {
+        config.insert(key, "v1");
+    }
+
+    const auto snapshot = config;
+    config[42] = "v2";
+    config.insert(100, "new");
+    config.remove(0);
+    REQUIRE(config[42] == "v2");
+    REQUIRE(snapshot[42] == "v1");
+    REQUIRE(snapshot.contains(100) == false);
+    REQUIRE(snapshot.contains(0) == true);
+    REQUIRE(snapshot.size() == 100);
+
+    // Writes through mutable iterators do not leak into the snapshots either.
+    const auto before = config;
+    for (auto& entry : config.range(10, 20))
+    {
+        entry.value() = "v3";
+    }
+    config.find(99)->value() = "v3";
+    REQUIRE(config[15] == "v3");
+    REQUIRE(config[99] == "v3");
+    REQUIRE(before[15] == "v1");
+    REQUIRE(before[99] == "v1");
+    REQUIRE(snapshot[15] == "v1");
+
+    // A lookup copies only the path to its entry, and the iterator copies the other shared entries before it moves.
+    const auto later = config;
+    auto it = config.find(50);
+    it->value() = "v4";
+    for (int i = 0; i < 5; ++i)
+    {
+        (++it)->value() = "v4";
+    }
+    (--config.end())->value() = "v4";
+    (--config.lower_bound(50))->value() = "v4";
+    for (int key = 49; key <= 55; ++key)
+    {
+        REQUIRE(config[key] == "v4");
+        REQUIRE(later[key] == "v1");
+    }
+    REQUIRE(config[100] == "v4");
+    REQUIRE(later[100] == "new");
+
+    // A snapshot taken while a mutable iterator is held does not see the writes through it, before or after it moves.
+    auto held = config.find(50);
+    const auto during = config;
+    held->value() = "v5";
+    REQUIRE(config[50] == "v5");
+    REQUIRE(during[50] == "v4");
+    ++held;
+    const auto moved = config;
+    held->value() = "v5";
+    (++held)->value() = "v5";
+    REQUIRE(config[51] == "v5");
+    REQUIRE(config[52] == "v5");
+    REQUIRE(moved[51] == "v4");
+    REQUIRE(moved[52] == "v4");
+    REQUIRE(during[51] == "v4");
+}
+
+TEST_CASE("ConcurrentSkipListMap", "[map]")
+{
+    // An order book: feed threads add and cancel price levels while a reader scans the best bids below a price.
+    ConcurrentSkipListMap<int, int> book;
+    const int feeds = 4;
+    const int levels = 5000;
+    std::atomic<bool> done = false;
+    std::thread reader([&]
+                       {
+                           while (!done)
+                           {
+                               int last = INT_MAX;
+                               auto it = book.floor(feeds * levels / 2);
+                               for (int k = 0; k < 10 && it != book.end(); ++k, --it)
+                               {
+                                   CHECK(it->key() < last);
+                                   CHECK(it->value() == it->key() * 10);
+                                   last = it->key();
+                                   if (it == book.begin())
+                                   {
+                                       break;
+                                   }
+                               }
+
+                               // odd levels are cancelled right after they are added, so their entries are freed under the reader
+                               for (int price = feeds * levels / 2 - 19; price < feeds * levels / 2; price += 2)
+                               {
+                                   std::optional<int> value = book.get(price);
+                                   CHECK((!value || *value == price * 10));
+                               }
+                           }
+                       });
+    std::vector<std::thread> threads;
+    for (int f = 0; f < feeds; ++f)
+    {
+        threads.emplace_back([&, f]
+                             {
+                                 for (int price = f; price < feeds * levels; price += feeds)
+                                 {
+                                     book.insert(price, price * 10);
+                                     if (price % 2 == 1)
+                                     {
+                                         book.remove(price);
+                                     }
+                                 }
+                             });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    done = true;
+    reader.join();
+
+    REQUIRE(book.size() == feeds * levels / 2);
+    REQUIRE(book.floor(101)->key() == 100);
+    REQUIRE(book.upper_bound(100)->value() == 1020);
+    REQUIRE(book.contains(99) == false);
+    REQUIRE(book.get(100) == 1000);
+    REQUIRE(book.get(99) == std::nullopt);
+
+    std::vector<int> prices;
+    for (const auto& entry : book.range(10, 20))
+    {
+        prices.push_back(entry.key());
+    }
+    REQUIRE(prices == std::vector<int>{10, 12, 14, 16, 18});
+
+    // Values in a range are mutable through the non-const view.
+    for (auto& entry : book.range(0, 4))
+    {
+        entry.value() = -1;
+    }
+    REQUIRE(book[0] == -1);
+    REQUIRE(book[2] == -1);
+    REQUIRE(book[4] == 40);
+}
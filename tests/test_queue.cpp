@@ -1,9 +1,13 @@
 #include "tool.hpp"
 
 #include "../sources/Queue/ArrayQueue.hpp"
+#include "../sources/Queue/BlockingQueue.hpp"
 #include "../sources/Queue/LinkedQueue.hpp"
+#include "../sources/Queue/MpmcQueue.hpp"
+#include "../sources/Queue/SpscQueue.hpp"
+#include "../sources/Queue/UnrolledQueue.hpp"
 
-TEMPLATE_TEST_CASE("Queue", "[queue]", ArrayQueue<int>, LinkedQueue<int>)
+TEMPLATE_TEST_CASE("Queue", "[queue]", ArrayQueue<int>, LinkedQueue<int>, UnrolledQueue<int>, SpscQueue<int>, MpmcQueue<int>)
 {
     using Queue = TestType;
 
@@ -94,3 +98,335 @@ TEMPLATE_TEST_CASE("Queue", "[queue]", ArrayQueue<int>, LinkedQueue<int>)
     REQUIRE(oss.str() == "Queue(1, 2, 3, 4, 5)");
     oss.str("");
 }
+
+// The queue exposes the ring buffer of ArrayDeque as two segments.
+TEST_CASE("ArrayQueue segments", "[queue]")
+{
+    ArrayQueue<int> queue;
+    for (int i = 0; i < 8; ++i)
+    {
+        queue.enqueue(i);
+    }
+    queue.dequeue();
+    queue.dequeue();
+    queue.enqueue(8);
+
+    auto [head, tail] = queue.segments();
+    REQUIRE(head.size() == 6);
+    REQUIRE(tail.size() == 1);
+    REQUIRE(std::equal(head.begin(), head.end(), queue.begin()));
+    REQUIRE(tail[0] == 8);
+}
+
+// Bounded operations on one thread, then a transfer between a producer and a consumer thread.
+TEST_CASE("SpscQueue", "[queue]")
+{
+    SpscQueue<int> queue(5);
+    REQUIRE(queue.capacity() == 8);
+
+    // Full and empty.
+    for (int i = 0; i < 8; ++i)
+    {
+        REQUIRE(queue.try_enqueue(i) == true);
+    }
+    REQUIRE(queue.try_enqueue(8) == false);
+    REQUIRE_THROWS_MATCHES(queue.enqueue(8), std::runtime_error, Message("Error: The container has reached the maximum size."));
+
+    int x = -1;
+    REQUIRE(queue.try_dequeue(x) == true);
+    REQUIRE(x == 0);
+    REQUIRE(queue.try_enqueue(8) == true);
+    REQUIRE(queue == SpscQueue<int>({1, 2, 3, 4, 5, 6, 7, 8}));
+
+    // Bulk dequeue across the wrap-around.
+    int out[8] = {};
+    REQUIRE(queue.dequeue_bulk(out, 5) == 5);
+    REQUIRE(out[0] == 1);
+    REQUIRE(out[4] == 5);
+    REQUIRE(queue.dequeue_bulk(out, 8) == 3);
+    REQUIRE(out[2] == 8);
+    REQUIRE(queue.dequeue_bulk(out, 8) == 0);
+    REQUIRE(queue.try_dequeue(x) == false);
+    REQUIRE(queue.is_empty() == true);
+
+    // Producer and consumer threads, order is preserved.
+    const int n = 1000000;
+    SpscQueue<int> channel(64);
+    bool in_order = true;
+    std::thread consumer([&]
+                         {
+                             int expected = 0;
+                             int buffer[16];
+                             while (expected < n)
+                             {
+                                 int got = channel.dequeue_bulk(buffer, 16);
+                                 for (int i = 0; i < got; ++i)
+                                 {
+                                     in_order = in_order && buffer[i] == expected++;
+                                 }
+                                 if (got == 0)
+                                 {
+                                     std::this_thread::yield();
+                                 }
+                             }
+                         });
+    for (int i = 0; i < n; ++i)
+    {
+        while (!channel.try_enqueue(i))
+        {
+            std::this_thread::yield();
+        }
+    }
+    consumer.join();
+    REQUIRE(in_order == true);
+    REQUIRE(channel.is_empty() == true);
+}
+
+// Bounded operations on one thread, then producers and consumers mixing the waiting and non-waiting variants.
+TEST_CASE("MpmcQueue", "[queue]")
+{
+    MpmcQueue<int> queue(3);
+    REQUIRE(queue.capacity() == 4);
+
+    // Full and empty, over several laps of the ring.
+    int x = -1;
+    for (int lap = 0; lap < 3; ++lap)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            REQUIRE(queue.try_enqueue(lap * 4 + i) == true);
+        }
+        REQUIRE(queue.try_enqueue(-1) == false);
+        REQUIRE_THROWS_MATCHES(queue.enqueue(-1), std::runtime_error, Message("Error: The container has reached the maximum size."));
+        REQUIRE(queue.size() == 4);
+        for (int i = 0; i < 4; ++i)
+        {
+            REQUIRE(queue.try_dequeue(x) == true);
+            REQUIRE(x == lap * 4 + i);
+        }
+        REQUIRE(queue.try_dequeue(x) == false);
+        REQUIRE_THROWS_MATCHES(queue.dequeue(), std::runtime_error, Message("Error: The container is empty."));
+    }
+    queue.enqueue_wait(1);
+    REQUIRE(queue.dequeue_wait() == 1);
+
+    // Every element is received exactly once.
+    const int producers = 4;
+    const int consumers = 4;
+    const int n = 20000;
+    MpmcQueue<int> channel(16);
+    std::atomic<int> received[producers * n] = {};
+    std::thread threads[producers + consumers];
+    for (int p = 0; p < producers; ++p)
+    {
+        threads[p] = std::thread([&, p]
+                                 {
+                                     for (int i = p * n; i < (p + 1) * n; ++i)
+                                     {
+                                         if (i % 2 == 0)
+                                         {
+                                             channel.enqueue_wait(i);
+                                         }
+                                         else
+                                         {
+                                             while (!channel.try_enqueue(i))
+                                             {
+                                                 std::this_thread::yield();
+                                             }
+                                         }
+                                     }
+                                 });
+    }
+    for (int c = 0; c < consumers; ++c)
+    {
+        threads[producers + c] = std::thread([&, c]
+                                             {
+                                                 int element;
+                                                 for (int i = 0; i < n; ++i)
+                                                 {
+                                                     if (c % 2 == 0)
+                                                     {
+                                                         element = channel.dequeue_wait();
+                                                     }
+                                                     else
+                                                     {
+                                                         while (!channel.try_dequeue(element))
+                                                         {
+                                                             std::this_thread::yield();
+                                                         }
+                                                     }
+                                                     received[element].fetch_add(1);
+                                                 }
+                                             });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    REQUIRE(std::all_of(std::begin(received), std::end(received), [](const std::atomic<int>& count) { return count == 1; }));
+    REQUIRE(channel.is_empty() == true);
+}
+
+TEST_CASE("ArrayQueue batch", "[queue]")
+{
+    int input[] = {1, 2, 3, 4, 5};
+    int output[5] = {};
+
+    ArrayQueue<int> queue = {0};
+    queue.enqueue_range(std::begin(input), std::end(input));
+    REQUIRE(queue == ArrayQueue<int>({0, 1, 2, 3, 4, 5}));
+    REQUIRE(queue.dequeue_into(output, 2) == 2);
+    REQUIRE(output[0] == 0);
+    REQUIRE(output[1] == 1);
+    REQUIRE(queue.dequeue_into(output, 5) == 4);
+    REQUIRE(output[3] == 5);
+    REQUIRE(queue.is_empty() == true);
+}
+
+TEST_CASE("ArrayQueue shrink", "[queue]")
+{
+    ArrayQueue<int> queue;
+    queue.set_auto_shrink(true);
+    for (int i = 0; i < 100; ++i)
+    {
+        queue.enqueue(i);
+    }
+    REQUIRE(queue.capacity() == 128);
+    while (queue.size() > 10)
+    {
+        queue.dequeue();
+    }
+    REQUIRE(queue.capacity() == 32);
+    queue.shrink_to_fit();
+    REQUIRE(queue.capacity() == 16);
+    REQUIRE(queue == ArrayQueue<int>({90, 91, 92, 93, 94, 95, 96, 97, 98, 99}));
+}
+
+// Single-thread behaviour at the bounds, timeouts and shutdown, then a pipeline of producers and consumers.
+TEST_CASE("BlockingQueue", "[queue]")
+{
+    using namespace std::chrono_literals;
+
+    // Lifecycle
+    BlockingQueue<int> some = {1, 2, 3};
+    BlockingQueue<int> copy = some;
+    REQUIRE(copy == some);
+    copy = BlockingQueue<int>(2);
+    REQUIRE(copy.is_empty() == true);
+    REQUIRE(copy.capacity() == 2);
+    std::ostringstream oss;
+    oss << some;
+    REQUIRE(oss.str() == "Queue(1, 2, 3)");
+
+    // Full and empty without waiting, and with a timeout.
+    BlockingQueue<int> queue(3);
+    REQUIRE(queue.try_enqueue(1) == true);
+    queue.enqueue(2);
+    REQUIRE(queue.try_enqueue_for(3, 1ms) == true);
+    REQUIRE(queue.try_enqueue(4) == false);
+    auto start = std::chrono::steady_clock::now();
+    REQUIRE(queue.try_enqueue_for(4, 20ms) == false);
+    REQUIRE(std::chrono::steady_clock::now() - start >= 20ms);
+    REQUIRE(queue == BlockingQueue<int>({1, 2, 3}));
+
+    int x = 0;
+    REQUIRE(queue.dequeue() == 1);
+    REQUIRE(queue.try_dequeue(x) == true);
+    REQUIRE(x == 2);
+    REQUIRE(queue.try_dequeue_for(x, 1ms) == true);
+    REQUIRE(x == 3);
+    REQUIRE(queue.try_dequeue(x) == false);
+    REQUIRE(queue.try_dequeue_for(x, 10ms) == false);
+
+    // Drain takes what is there, up to the count.
+    for (int i = 0; i < 3; ++i)
+    {
+        queue.enqueue(i);
+    }
+    int out[4] = {};
+    REQUIRE(queue.drain(out, 2) == 2);
+    REQUIRE(queue.drain(out + 2, 2) == 1);
+    REQUIRE(out[2] == 2);
+    REQUIRE(queue.drain(out, 0) == 0);
+
+    // After close, producers are turned away and consumers get what is left.
+    queue.enqueue(7);
+    queue.close();
+    REQUIRE(queue.is_closed() == true);
+    REQUIRE(queue.try_enqueue(8) == false);
+    REQUIRE_THROWS_MATCHES(queue.enqueue(8), std::runtime_error, Message("Error: The queue is closed."));
+    REQUIRE(queue.dequeue() == 7);
+    REQUIRE_THROWS_MATCHES(queue.dequeue(), std::runtime_error, Message("Error: The queue is closed."));
+    REQUIRE(queue.drain(out, 4) == 0);
+
+    // Close wakes blocked threads on both sides.
+    BlockingQueue<int> idle(1);
+    BlockingQueue<int> busy(1);
+    busy.enqueue(0);
+    std::atomic<bool> consumer_failed = false;
+    std::atomic<bool> producer_failed = false;
+    std::thread consumer([&]
+                         {
+                             int item;
+                             consumer_failed = !idle.try_dequeue_for(item, 10s);
+                         });
+    std::thread producer([&]
+                         { producer_failed = !busy.try_enqueue_for(1, 10s); });
+    std::this_thread::sleep_for(10ms);
+    idle.close();
+    busy.close();
+    consumer.join();
+    producer.join();
+    REQUIRE(consumer_failed == true);
+    REQUIRE(producer_failed == true);
+
+    // Every element goes through a small buffer exactly once.
+    const int n = 20000;
+    BlockingQueue<int> pipe(16);
+    std::atomic<long long> sum = 0;
+    std::thread threads[6];
+    for (int p = 0; p < 3; ++p)
+    {
+        threads[p] = std::thread([&, p]
+                                 {
+                                     for (int i = p; i < n; i += 3)
+                                     {
+                                         pipe.enqueue(i);
+                                     }
+                                 });
+    }
+    for (int c = 0; c < 3; ++c)
+    {
+        threads[3 + c] = std::thread([&, c]
+                                     {
+                                         int batch[8];
+                                         long long local = 0;
+                                         if (c == 0)
+                                         {
+                                             while (int count = pipe.drain(batch, 8))
+                                             {
+                                                 local += std::accumulate(batch, batch + count, 0LL);
+                                             }
+                                         }
+                                         else
+                                         {
+                                             for (int item; pipe.try_dequeue_for(item, 10s);)
+                                             {
+                                                 local += item;
+                                             }
+                                         }
+                                         sum += local;
+                                     });
+    }
+    for (int p = 0; p < 3; ++p)
+    {
+        threads[p].join();
+    }
+    pipe.close();
+    for (int c = 3; c < 6; ++c)
+    {
+        threads[c].join();
+    }
+    REQUIRE(sum == (long long)n * (n - 1) / 2);
+    REQUIRE(pipe.is_empty() == true);
+}
@@ -1,9 +1,13 @@
 #include "tool.hpp"
 
+#include "../sources/Set/ConcurrentSkipListSet.hpp"
 #include "../sources/Set/HashSet.hpp"
 #include "../sources/Set/TreeSet.hpp"
+#include "../sources/Tree/AVLTree.hpp"
+#include "../sources/Tree/BTree.hpp"
+#include "../sources/Tree/PersistentAVLTree.hpp"
 
-TEMPLATE_TEST_CASE("Set", "[set]", HashSet<int>, TreeSet<int>)
+TEMPLATE_TEST_CASE("Set", "[set]", HashSet<int>, TreeSet<int>, (TreeSet<int, BTree<int>>), (TreeSet<int, PersistentAVLTree<int>>), ConcurrentSkipListSet<int>)
 {
     using Set = TestType;
 
@@ -119,3 +123,137 @@ TEMPLATE_TEST_CASE("Set", "[set]", HashSet<int>, TreeSet<int>)
     REQUIRE(oss.str() == "Set(1, 2, 3)");
     oss.str("");
 }
+
+TEMPLATE_TEST_CASE("TreeSet order statistics", "[set]", TreeSet<int>, (TreeSet<int, AVLTree<int>>), (TreeSet<int, PersistentAVLTree<int>>))
+{
+    // Scores on a leaderboard.
+    TestType scores = {70, 85, 60, 95, 90, 75};
+    REQUIRE(scores.rank(60) == 0);
+    REQUIRE(scores.rank(80) == 3);
+    REQUIRE(scores.rank(100) == 6);
+    REQUIRE(scores.select(0) == 60);
+    REQUIRE(scores.select(5) == 95);
+    REQUIRE_THROWS_MATCHES(scores.select(6), std::runtime_error, Message("Error: Index out of range."));
+    REQUIRE(scores.count_range(70, 90) == 3);
+    REQUIRE(scores.count_range(90, 70) == 0);
+
+    scores.remove(75);
+    REQUIRE(scores.rank(80) == 2);
+    REQUIRE(scores.select(2) == 85);
+}
+
+TEST_CASE("TreeSet bounds and ranges", "[set]")
+{
+    TreeSet<int> set = {10, 20, 30, 40, 50};
+
+    REQUIRE(*set.lower_bound(20) == 20);
+    REQUIRE(*set.upper_bound(20) == 30);
+    REQUIRE(set.upper_bound(50) == set.end());
+    REQUIRE(*set.floor(35) == 30);
+    REQUIRE(set.floor(5) == set.end());
+    REQUIRE(*set.ceiling(35) == 40);
+
+    auto [first, last] = set.equal_range(25);
+    REQUIRE(first == last);
+
+    std::vector<int> inside(set.range(15, 45).begin(), set.range(15, 45).end());
+    REQUIRE(inside == std::vector<int>{20, 30, 40});
+    REQUIRE(set.range(30, 30).empty());
+}
+
+TEST_CASE("TreeSet range constructor", "[set]")
+{
+    std::vector<int> sorted = {1, 2, 3, 5, 8, 13};
+    TreeSet<int> set(sorted.begin(), sorted.end());
+    REQUIRE(set == TreeSet<int>({1, 2, 3, 5, 8, 13}));
+
+    std::vector<int> unsorted = {13, 1, 8, 2, 1, 5, 3};
+    TreeSet<int, BTree<int>> other(unsorted.begin(), unsorted.end());
+    REQUIRE(std::equal(other.begin(), other.end(), sorted.begin(), sorted.end()));
+}
+
+TEMPLATE_TEST_CASE("TreeSet set operations", "[set]", TreeSet<int>, (TreeSet<int, AVLTree<int>>))
+{
+    using Set = TestType;
+
+    Set set = {1, 2, 3, 4, 5, 6};
+    set.union_with(Set({5, 6, 7, 8}));
+    REQUIRE(set == Set({1, 2, 3, 4, 5, 6, 7, 8}));
+
+    set.intersect_with(Set({0, 2, 4, 6, 8, 10}));
+    REQUIRE(set == Set({2, 4, 6, 8}));
+
+    Set removed = {4, 8, 9};
+    set.difference_with(std::move(removed));
+    REQUIRE(set == Set({2, 6}));
+    REQUIRE(removed.is_empty() == true);
+
+    set.union_with(Set({3, 9, 12, 15}));
+    set.filter([](int item) { return item % 3 == 0; });
+    REQUIRE(set == Set({3, 6, 9, 12, 15}));
+    REQUIRE(set.rank(9) == 2);
+}
+
+TEST_CASE("ConcurrentSkipListSet", "[set]")
+{
+    ConcurrentSkipListSet<int> set = {10, 20, 30, 40, 50};
+    REQUIRE(*set.lower_bound(20) == 20);
+    REQUIRE(*set.upper_bound(20) == 30);
+    REQUIRE(set.upper_bound(50) == set.end());
+    REQUIRE(*set.floor(35) == 30);
+    REQUIRE(set.floor(5) == set.end());
+    REQUIRE(*set.ceiling(35) == 40);
+    REQUIRE(*std::prev(set.find(30)) == 20);
+
+    std::vector<int> inside(set.range(15, 45).begin(), set.range(15, 45).end());
+    REQUIRE(inside == std::vector<int>{20, 30, 40});
+    REQUIRE(set.range(30, 30).empty());
+
+    // Each thread inserts its own keys and removes every third one, while the others do the same on interleaved keys.
+    // Every key ends up present exactly when it was not removed, and a concurrent scan always sees ascending order.
+    set.clear();
+    const int workers = 4;
+    const int n = 20000;
+    std::atomic<bool> done = false;
+    std::thread scanner([&]
+                        {
+                            while (!done)
+                            {
+                                int last = -1;
+                                for (int e : set.range(0, workers * n))
+                                {
+                                    CHECK(last < e);
+                                    last = e;
+                                }
+                            }
+                        });
+    std::vector<std::thread> threads;
+    for (int w = 0; w < workers; ++w)
+    {
+        threads.emplace_back([&, w]
+                             {
+                                 for (int i = w; i < workers * n; i += workers)
+                                 {
+                                     set.insert(i);
+                                     if (i % 3 == 0)
+                                     {
+                                         set.remove(i);
+                                     }
+                                 }
+                             });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    done = true;
+    scanner.join();
+
+    REQUIRE(set.size() == workers * n - (workers * n + 2) / 3);
+    int expected = 0;
+    for (int e : set)
+    {
+        expected += expected % 3 == 0;
+        REQUIRE(e == expected++);
+    }
+}
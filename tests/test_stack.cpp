@@ -1,9 +1,11 @@
 #include "tool.hpp"
 
 #include "../sources/Stack/ArrayStack.hpp"
+#include "../sources/Stack/ConcurrentStack.hpp"
 #include "../sources/Stack/LinkedStack.hpp"
+#include "../sources/Stack/UnrolledStack.hpp"
 
-TEMPLATE_TEST_CASE("Stack", "[stack]", ArrayStack<int>, LinkedStack<int>)
+TEMPLATE_TEST_CASE("Stack", "[stack]", ArrayStack<int>, LinkedStack<int>, UnrolledStack<int>, ConcurrentStack<int>)
 {
     using Stack = TestType;
 
@@ -93,3 +95,89 @@ TEMPLATE_TEST_CASE("Stack", "[stack]", ArrayStack<int>, LinkedStack<int>)
     REQUIRE(oss.str() == "Stack(1, 2, 3, 4, 5)");
     oss.str("");
 }
+
+TEST_CASE("ArrayStack batch", "[stack]")
+{
+    int input[100];
+    std::iota(std::begin(input), std::end(input), 0);
+
+    ArrayStack<int> stack = {-1};
+    stack.push_range(std::begin(input), std::end(input));
+    REQUIRE(stack.size() == 101);
+    REQUIRE(stack.top() == 99);
+    for (int i = 99; i >= 0; --i)
+    {
+        REQUIRE(stack.pop() == i);
+    }
+    REQUIRE(stack.pop() == -1);
+}
+
+TEST_CASE("ArrayStack shrink", "[stack]")
+{
+    ArrayStack<int> stack;
+    for (int i = 0; i < 100; ++i)
+    {
+        stack.push(i);
+    }
+    REQUIRE(stack.capacity() == 128);
+    stack.set_auto_shrink(true);
+    while (stack.size() > 20)
+    {
+        stack.pop();
+    }
+    REQUIRE(stack.capacity() == 62);
+    stack.shrink_to_fit();
+    REQUIRE(stack.capacity() == 20);
+    REQUIRE(stack.top() == 19);
+}
+
+TEST_CASE("ConcurrentStack", "[stack]")
+{
+    // Nodes are recycled, and the order is kept across reuse.
+    ConcurrentStack<int> stack;
+    for (int round = 0; round < 3; ++round)
+    {
+        for (int i = 0; i < 100; ++i)
+        {
+            stack.push(round * 100 + i);
+        }
+        int x = -1;
+        for (int i = 99; i >= 0; --i)
+        {
+            REQUIRE(stack.try_pop(x) == true);
+            REQUIRE(x == round * 100 + i);
+        }
+        REQUIRE(stack.try_pop(x) == false);
+    }
+
+    // Every element is popped exactly once, by pushers and poppers racing on the top.
+    const int workers = 4;
+    const int n = 20000;
+    std::atomic<int> popped[workers * n] = {};
+    std::thread threads[workers];
+    for (int w = 0; w < workers; ++w)
+    {
+        threads[w] = std::thread([&, w]
+                                 {
+                                     int element;
+                                     for (int i = w * n; i < (w + 1) * n; ++i)
+                                     {
+                                         stack.push(i);
+                                         if (i % 3 != 0 && stack.try_pop(element))
+                                         {
+                                             popped[element].fetch_add(1);
+                                         }
+                                     }
+                                 });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    for (int element; stack.try_pop(element);)
+    {
+        popped[element].fetch_add(1);
+    }
+    REQUIRE(std::all_of(std::begin(popped), std::end(popped), [](const std::atomic<int>& count) { return count == 1; }));
+    REQUIRE(stack.is_empty() == true);
+}
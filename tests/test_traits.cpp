@@ -1,22 +1,35 @@
 #include "tool.hpp"
 
 #include "../sources/Deque/ArrayDeque.hpp"
+#include "../sources/Deque/BlockDeque.hpp"
 #include "../sources/Deque/LinkedDeque.hpp"
+#include "../sources/Deque/UnrolledDeque.hpp"
+#include "../sources/Deque/WorkStealingDeque.hpp"
 #include "../sources/Graph/ListGraph.hpp"
 #include "../sources/Graph/MatrixGraph.hpp"
 #include "../sources/Heap/BinaryHeap.hpp"
 #include "../sources/List/ArrayList.hpp"
 #include "../sources/List/LinkedList.hpp"
+#include "../sources/List/MappedArrayList.hpp"
 #include "../sources/List/SinglyLinkedList.hpp"
+#include "../sources/List/TreeList.hpp"
+#include "../sources/List/UnrolledLinkedList.hpp"
 #include "../sources/Map/HashMap.hpp"
 #include "../sources/Map/TreeMap.hpp"
 #include "../sources/Queue/ArrayQueue.hpp"
+#include "../sources/Queue/BlockingQueue.hpp"
 #include "../sources/Queue/LinkedQueue.hpp"
+#include "../sources/Queue/MpmcQueue.hpp"
+#include "../sources/Queue/SpscQueue.hpp"
+#include "../sources/Queue/UnrolledQueue.hpp"
 #include "../sources/Set/HashSet.hpp"
 #include "../sources/Set/TreeSet.hpp"
 #include "../sources/Stack/ArrayStack.hpp"
+#include "../sources/Stack/ConcurrentStack.hpp"
 #include "../sources/Stack/LinkedStack.hpp"
+#include "../sources/Stack/UnrolledStack.hpp"
 #include "../sources/Tree/AVLTree.hpp"
+#include "../sources/Tree/BTree.hpp"
 #include "../sources/Tree/BinarySearchTree.hpp"
 #include "../sources/Tree/RedBlackTree.hpp"
 #include "../sources/Tree/SplayTree.hpp"
@@ -38,18 +51,31 @@ static_assert(std::has_virtual_destructor_v<Container>);
 static_assert(kFullFeaturedContainer<ArrayList<int>>);
 static_assert(kFullFeaturedContainer<LinkedList<int>>);
 static_assert(kFullFeaturedContainer<SinglyLinkedList<int>>);
+static_assert(kFullFeaturedContainer<MappedArrayList<int>>);
+static_assert(kFullFeaturedContainer<TreeList<int>>);
+static_assert(kFullFeaturedContainer<UnrolledLinkedList<int>>);
 static_assert(kFullFeaturedContainer<ArrayDeque<int>>);
+static_assert(kFullFeaturedContainer<BlockDeque<int>>);
 static_assert(kFullFeaturedContainer<LinkedDeque<int>>);
+static_assert(kFullFeaturedContainer<UnrolledDeque<int>>);
+static_assert(kFullFeaturedContainer<WorkStealingDeque<int>>);
 static_assert(kFullFeaturedContainer<ArrayQueue<int>>);
 static_assert(kFullFeaturedContainer<LinkedQueue<int>>);
+static_assert(kFullFeaturedContainer<UnrolledQueue<int>>);
+static_assert(kFullFeaturedContainer<MpmcQueue<int>>);
+static_assert(kFullFeaturedContainer<BlockingQueue<int>>);
+static_assert(kFullFeaturedContainer<SpscQueue<int>>);
 static_assert(kFullFeaturedContainer<ArrayStack<int>>);
 static_assert(kFullFeaturedContainer<LinkedStack<int>>);
+static_assert(kFullFeaturedContainer<UnrolledStack<int>>);
+static_assert(kFullFeaturedContainer<ConcurrentStack<int>>);
 static_assert(kFullFeaturedContainer<HashMap<int, int>>);
 static_assert(kFullFeaturedContainer<HashSet<int>>);
 static_assert(kFullFeaturedContainer<BinaryHeap<int>>);
 static_assert(kFullFeaturedContainer<BinarySearchTree<int>>);
 static_assert(kFullFeaturedContainer<RedBlackTree<int>>);
 static_assert(kFullFeaturedContainer<SplayTree<int>>);
+static_assert(kFullFeaturedContainer<BTree<int>>);
 static_assert(kFullFeaturedContainer<ListGraph<>>);
 static_assert(kFullFeaturedContainer<MatrixGraph<>>);
 static_assert(kFullFeaturedContainer<TreeSet<int>>);
@@ -58,7 +84,11 @@ static_assert(kFullFeaturedContainer<TreeMap<int, int>>);
 static_assert(kConstBeginReference<ArrayList<int>>);
 static_assert(kConstBeginReference<LinkedList<int>>);
 static_assert(kConstBeginReference<SinglyLinkedList<int>>);
+static_assert(kConstBeginReference<MappedArrayList<int>>);
+static_assert(kConstBeginReference<TreeList<int>>);
+static_assert(kConstBeginReference<UnrolledLinkedList<int>>);
 static_assert(kConstBeginReference<ArrayDeque<int>>);
+static_assert(kConstBeginReference<BlockDeque<int>>);
 static_assert(kConstBeginReference<HashMap<int, int>>);
 
 static_assert(std::bidirectional_iterator<decltype(std::declval<HashSet<int>&>().begin())>);
@@ -1,7 +1,9 @@
 #include "tool.hpp"
 
 #include "../sources/Tree/AVLTree.hpp"
+#include "../sources/Tree/BTree.hpp"
 #include "../sources/Tree/BinarySearchTree.hpp"
+#include "../sources/Tree/PersistentAVLTree.hpp"
 #include "../sources/Tree/RedBlackTree.hpp"
 #include "../sources/Tree/SplayTree.hpp"
 
@@ -30,9 +32,9 @@ static bool verify_order(const Tree& tree)
 
 class InspectableRedBlackTree : public RedBlackTree<int>
 {
-    using Node = typename BinarySearchTree<int>::Node;
-    using BinarySearchTree<int>::end_;
-    using BinarySearchTree<int>::root_;
+    using typename RedBlackTree<int>::Node;
+    using RedBlackTree<int>::end_;
+    using RedBlackTree<int>::root_;
 
     bool verify_node(Node* node, int black_count, int& black_height) const
     {
@@ -47,13 +49,19 @@ class InspectableRedBlackTree : public RedBlackTree<int>
         }
 
         // No double red: a red node cannot have a red child.
-        if (node->red_ && ((node->left_ && node->left_->red_) || (node->right_ && node->right_->red_)))
+        if (node->red() && ((node->left_ && node->left_->red()) || (node->right_ && node->right_->red())))
         {
             return false;
         }
 
-        return verify_node(node->left_, black_count + (node->red_ ? 0 : 1), black_height) &&
-               verify_node(node->right_, black_count + (node->red_ ? 0 : 1), black_height);
+        // Subtree counts for order statistics.
+        if (node->count_ != 1 + (node->left_ ? node->left_->count_ : 0) + (node->right_ ? node->right_->count_ : 0))
+        {
+            return false;
+        }
+
+        return verify_node(node->left_, black_count + (node->red() ? 0 : 1), black_height) &&
+               verify_node(node->right_, black_count + (node->red() ? 0 : 1), black_height);
     }
 
 public:
@@ -65,7 +73,7 @@ public:
         {
             return true;
         }
-        if (root_->parent_ != end_ || root_->red_)
+        if (root_->parent() != end_ || root_->red())
         {
             return false;
         }
@@ -77,9 +85,9 @@ public:
 
 class InspectableAVLTree : public AVLTree<int>
 {
-    using Node = typename BinarySearchTree<int>::Node;
-    using BinarySearchTree<int>::end_;
-    using BinarySearchTree<int>::root_;
+    using typename AVLTree<int>::Node;
+    using AVLTree<int>::end_;
+    using AVLTree<int>::root_;
 
     bool verify_balance(Node* node) const
     {
@@ -96,6 +104,12 @@ class InspectableAVLTree : public AVLTree<int>
             return false;
         }
 
+        // Subtree counts for order statistics.
+        if (node->count_ != 1 + (node->left_ ? node->left_->count_ : 0) + (node->right_ ? node->right_->count_ : 0))
+        {
+            return false;
+        }
+
         return verify_balance(node->left_) && verify_balance(node->right_);
     }
 
@@ -108,7 +122,51 @@ public:
         {
             return true;
         }
-        return root_->parent_ == end_ && verify_balance(root_) && verify_order(*this);
+        return root_->parent() == end_ && verify_balance(root_) && verify_order(*this);
+    }
+};
+
+class InspectablePersistentAVLTree : public PersistentAVLTree<int>
+{
+    using typename PersistentAVLTree<int>::Node;
+    using PersistentAVLTree<int>::root_;
+
+    bool verify_balance(const Node* node) const
+    {
+        if (node == nullptr)
+        {
+            return true;
+        }
+
+        int left_h = node->left_ ? node->left_->height_ : 0;
+        int right_h = node->right_ ? node->right_->height_ : 0;
+
+        if (node->height_ != 1 + std::max(left_h, right_h) || std::abs(left_h - right_h) > 1 || node->refs_.load() < 1)
+        {
+            return false;
+        }
+
+        // Subtree counts for order statistics.
+        if (node->count_ != 1 + (node->left_ ? node->left_->count_ : 0) + (node->right_ ? node->right_->count_ : 0))
+        {
+            return false;
+        }
+
+        return verify_balance(node->left_) && verify_balance(node->right_);
+    }
+
+public:
+    using PersistentAVLTree<int>::PersistentAVLTree;
+
+    bool verify_invariants() const
+    {
+        return verify_balance(root_) && verify_order(*this) && (root_ == nullptr ? 0 : root_->count_) == this->size();
+    }
+
+    // Check whether the two trees share their root node.
+    bool shares_root_with(const InspectablePersistentAVLTree& that) const
+    {
+        return root_ != nullptr && root_ == that.root_;
     }
 };
 
@@ -116,13 +174,14 @@ class InspectableSplayTree : public SplayTree<int>
 {
     using BinarySearchTree<int>::end_;
     using BinarySearchTree<int>::root_;
+    using BinarySearchTree<int>::finger_search_;
 
 public:
     using SplayTree<int>::SplayTree;
 
     bool verify_invariants() const
     {
-        return (root_ == nullptr || root_->parent_ == end_) && verify_order(*this);
+        return (root_ == nullptr || root_->parent() == end_) && verify_order(*this);
     }
 
     int root_value() const
@@ -130,9 +189,81 @@ public:
         REQUIRE(root_ != nullptr);
         return root_->data();
     }
+
+    bool uses_finger_search() const
+    {
+        return finger_search_;
+    }
 };
 
-TEMPLATE_TEST_CASE("Tree", "[tree]", BinarySearchTree<int>, RedBlackTree<int>, AVLTree<int>, SplayTree<int>)
+template <typename T>
+class InspectableBTree : public BTree<T>
+{
+    using typename BTree<T>::Node;
+    using typename BTree<T>::Leaf;
+    using typename BTree<T>::Inner;
+    using BTree<T>::NODE_CAPACITY;
+    using BTree<T>::MIN_LEAF;
+    using BTree<T>::MIN_INNER;
+    using BTree<T>::size_;
+    using BTree<T>::depth_;
+    using BTree<T>::head_;
+    using BTree<T>::root_;
+
+    // Check occupancy, order within [low, high), leaf level, and that the leaves are linked in order.
+    bool verify_node(const Node* node, int level, const T* low, const T* high, const Leaf*& cursor, int& count) const
+    {
+        if (node->count_ > NODE_CAPACITY || (node != root_ && node->count_ < (node->leaf_ ? MIN_LEAF : MIN_INNER)))
+        {
+            return false;
+        }
+
+        const T* data = node->leaf_ ? static_cast<const Leaf*>(node)->data_ : static_cast<const Inner*>(node)->keys_;
+        for (int i = 0; i < node->count_; ++i)
+        {
+            if ((i > 0 && !(data[i - 1] < data[i])) || (low && data[i] < *low) || (high && !(data[i] < *high)))
+            {
+                return false;
+            }
+        }
+
+        if (node->leaf_)
+        {
+            cursor = cursor->next_;
+            count += node->count_;
+            return level == depth_ && cursor == node;
+        }
+
+        const Inner* inner = static_cast<const Inner*>(node);
+        for (int i = 0; i <= inner->count_; ++i)
+        {
+            const T* child_low = i == 0 ? low : &inner->keys_[i - 1];
+            const T* child_high = i == inner->count_ ? high : &inner->keys_[i];
+            if (!verify_node(inner->children_[i], level + 1, child_low, child_high, cursor, count))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+public:
+    using BTree<T>::BTree;
+
+    bool verify_invariants() const
+    {
+        if (root_ == nullptr)
+        {
+            return size_ == 0 && depth_ == 0 && head_->next_ == head_ && head_->prev_ == head_;
+        }
+
+        const Leaf* cursor = head_;
+        int count = 0;
+        return verify_node(root_, 1, nullptr, nullptr, cursor, count) && cursor->next_ == head_ && count == size_;
+    }
+};
+
+TEMPLATE_TEST_CASE("Tree", "[tree]", BinarySearchTree<int>, RedBlackTree<int>, AVLTree<int>, SplayTree<int>, BTree<int>, PersistentAVLTree<int>)
 {
     using Tree = TestType;
 
@@ -220,6 +351,16 @@ TEMPLATE_TEST_CASE("Tree", "[tree]", BinarySearchTree<int>, RedBlackTree<int>, A
         REQUIRE(buf.str() == "1 2 3 4 5 ");
         buf.str("");
     }
+    else if constexpr (std::is_same_v<Tree, BTree<int>>)
+    {
+        // BTree stores all elements in the leaves on one level, every order visits them in ascending order.
+        for (auto order : {Tree::PreOrder, Tree::InOrder, Tree::PostOrder, Tree::LevelOrder})
+        {
+            some.traverse(order, action);
+            REQUIRE(buf.str() == "1 2 3 4 5 ");
+            buf.str("");
+        }
+    }
     else
     {
         some.traverse(Tree::PreOrder, action);
@@ -252,6 +393,10 @@ TEMPLATE_TEST_CASE("Tree", "[tree]", BinarySearchTree<int>, RedBlackTree<int>, A
     {
         REQUIRE(some.depth() >= 1);
     }
+    else if constexpr (std::is_same_v<Tree, BTree<int>>)
+    {
+        REQUIRE(some.depth() == 1);
+    }
     else
     {
         REQUIRE(some.depth() == 3);
@@ -302,10 +447,23 @@ TEMPLATE_TEST_CASE("Tree", "[tree]", BinarySearchTree<int>, RedBlackTree<int>, A
 
     // Single-element tree
     REQUIRE(Tree({42}).to_ascii() == "42");
-    REQUIRE(Tree({42}).to_dot() == "digraph BST {\n}");
+    if constexpr (std::is_same_v<Tree, BTree<int>>)
+    {
+        REQUIRE(Tree({42}).to_dot() == "digraph BTree {\n  n0 [label=\"42\"];\n}");
+    }
+    else
+    {
+        REQUIRE(Tree({42}).to_dot() == "digraph BST {\n}");
+    }
 
     // Two-element tree {1, 2}
-    if constexpr (std::is_same_v<Tree, SplayTree<int>>)
+    if constexpr (std::is_same_v<Tree, BTree<int>>)
+    {
+        // BTree: both in the root leaf
+        REQUIRE(Tree({1, 2}).to_ascii() == "1 2");
+        REQUIRE(Tree({1, 2}).to_dot() == "digraph BTree {\n  n0 [label=\"1 2\"];\n}");
+    }
+    else if constexpr (std::is_same_v<Tree, SplayTree<int>>)
     {
         // SplayTree splays 2 to root
         REQUIRE(Tree({1, 2}).to_ascii() == "2\n└── 1");
@@ -413,6 +571,374 @@ TEST_CASE("AVLTree invariants", "[tree]")
     REQUIRE(alt.verify_invariants() == true);
 }
 
+TEST_CASE("Degenerate BinarySearchTree", "[tree]")
+{
+    // Ascending insertion makes a chain of right children, as deep as the tree is large.
+    const int n = 1 << 14;
+    BinarySearchTree<int> tree;
+    for (int i = 0; i < n; ++i)
+    {
+        tree.insert(i);
+    }
+    REQUIRE(tree.size() == n);
+    REQUIRE(tree.depth() == n);
+
+    std::vector<int> ascending(n);
+    std::iota(ascending.begin(), ascending.end(), 0);
+    std::vector<int> seen;
+    auto action = [&](const int& e)
+    { seen.push_back(e); };
+
+    tree.traverse(BinarySearchTree<int>::PreOrder, action);
+    REQUIRE(seen == ascending);
+    seen.clear();
+
+    tree.traverse(BinarySearchTree<int>::InOrder, action);
+    REQUIRE(seen == ascending);
+    seen.clear();
+
+    tree.traverse(BinarySearchTree<int>::PostOrder, action);
+    REQUIRE(std::equal(seen.begin(), seen.end(), ascending.rbegin(), ascending.rend()));
+    seen.clear();
+
+    REQUIRE(tree.to_dot().size() > std::size_t(n));
+
+    // The root has only a right child each time.
+    for (int i = 0; i < n / 2; ++i)
+    {
+        tree.remove(i);
+    }
+    REQUIRE(tree.size() == n / 2);
+    REQUIRE(tree.depth() == n / 2);
+    REQUIRE(*tree.begin() == n / 2);
+}
+
+TEMPLATE_TEST_CASE("Remove relinks nodes", "[tree]", BinarySearchTree<int>, RedBlackTree<int>, AVLTree<int>)
+{
+    using Tree = TestType;
+
+    // Removing a node with two children moves its successor node into its place instead of copying the element,
+    // so iterators to the other elements stay valid.
+    Tree tree = {4, 2, 6, 1, 3, 5, 7};
+    auto successor = tree.find(5);
+    auto left = tree.find(3);
+    REQUIRE(tree.remove(4) == true);
+    REQUIRE(*successor == 5);
+    REQUIRE(*--successor == 3);
+    REQUIRE(successor == left);
+    REQUIRE(*++left == 5);
+    REQUIRE(*++left == 6);
+    REQUIRE(tree == Tree({1, 2, 3, 5, 6, 7}));
+    REQUIRE(tree.depth() == 3);
+
+    // The preorder shape after relinking.
+    std::ostringstream buf;
+    tree.traverse(Tree::PreOrder, [&](const int& e)
+                  { buf << e << " "; });
+    REQUIRE(buf.str() == "5 2 1 3 6 7 ");
+}
+
+TEMPLATE_TEST_CASE("Hinted and finger insertion", "[tree]", InspectableRedBlackTree, InspectableAVLTree, InspectableSplayTree)
+{
+    using Tree = TestType;
+
+    // Ascending stream, each key hinted by the iterator of the previous one.
+    Tree tree;
+    auto hint = tree.end();
+    for (int i = 0; i < 1000; ++i)
+    {
+        hint = tree.insert(hint, i);
+        REQUIRE(*hint == i);
+    }
+    REQUIRE(tree.size() == 1000);
+    REQUIRE(tree.verify_invariants() == true);
+    if constexpr (std::is_same_v<Tree, InspectableSplayTree>)
+    {
+        // The inserted element is splayed to the root, as with an insertion from the root.
+        REQUIRE(tree.root_value() == 999);
+    }
+
+    // A present element is found from the hint, and the tree is unchanged.
+    auto existing = tree.insert(tree.begin(), 500);
+    REQUIRE(*existing == 500);
+    REQUIRE(existing == tree.find(500));
+    REQUIRE(tree.size() == 1000);
+
+    // Any hint works, end() stands for the maximum, a far one only costs a longer climb.
+    REQUIRE(*tree.insert(tree.end(), 2000) == 2000);
+    REQUIRE(*tree.insert(tree.begin(), 1500) == 1500);
+    REQUIRE(*tree.insert(tree.find(999), -1) == -1);
+    REQUIRE(*tree.insert(typename Tree::Iterator(), 1001) == 1001);
+    REQUIRE(tree.size() == 1004);
+    REQUIRE(tree.verify_invariants() == true);
+
+    // Nearly sorted stream with finger search, mixed with removals, which reset the finger.
+    Tree finger;
+    finger.set_finger_search(true);
+    std::set<int> expected;
+    std::mt19937 gen(42);
+    for (int i = 0; i < 2000; ++i)
+    {
+        int key = i + int(gen() % 16);
+        REQUIRE(finger.insert(key) == expected.insert(key).second);
+        if (i % 7 == 0)
+        {
+            int victim = i - int(gen() % 32);
+            REQUIRE(finger.remove(victim) == (expected.erase(victim) == 1));
+        }
+    }
+    REQUIRE(finger.verify_invariants() == true);
+    REQUIRE(std::equal(finger.begin(), finger.end(), expected.begin(), expected.end()));
+
+    // The setting does not change what is inserted, even for random elements.
+    for (int i = 0; i < 1000; ++i)
+    {
+        int key = int(gen() % 5000);
+        REQUIRE(finger.insert(key) == expected.insert(key).second);
+    }
+    REQUIRE(finger.verify_invariants() == true);
+    REQUIRE(std::equal(finger.begin(), finger.end(), expected.begin(), expected.end()));
+}
+
+TEMPLATE_TEST_CASE("Order statistics", "[tree]", InspectableRedBlackTree, InspectableAVLTree, InspectablePersistentAVLTree)
+{
+    using Tree = TestType;
+
+    Tree empty;
+    REQUIRE(empty.rank(0) == 0);
+    REQUIRE(empty.count_range(0, 10) == 0);
+    REQUIRE_THROWS_MATCHES(empty.select(0), std::runtime_error, Message("Error: Index out of range."));
+
+    // Random inserts and removes, checked against a sorted reference after each step.
+    Tree tree;
+    std::set<int> expected;
+    unsigned seed = 1;
+    for (int step = 0; step < 2000; ++step)
+    {
+        seed = seed * 1103515245 + 12345;
+        int x = int(seed >> 16) % 200;
+        if (step % 3 == 2)
+        {
+            REQUIRE(tree.remove(x) == (expected.erase(x) == 1));
+        }
+        else
+        {
+            REQUIRE(tree.insert(x) == expected.insert(x).second);
+        }
+        REQUIRE(tree.verify_invariants() == true);
+
+        if (step % 100 == 0)
+        {
+            int k = 0;
+            for (int e : expected)
+            {
+                REQUIRE(tree.select(k) == e);
+                REQUIRE(tree.rank(e) == k);
+                REQUIRE(tree.rank(e + 1) == k + 1);
+                ++k;
+            }
+            REQUIRE_THROWS_MATCHES(tree.select(k), std::runtime_error, Message("Error: Index out of range."));
+            REQUIRE(tree.count_range(50, 150) == std::distance(expected.lower_bound(50), expected.lower_bound(150)));
+            REQUIRE(tree.count_range(150, 50) == 0);
+            REQUIRE(tree.count_range(-10, 1000) == tree.size());
+        }
+    }
+
+    // The k-th element of an ascending fill is k.
+    Tree asc;
+    for (int i = 0; i < 1000; ++i)
+    {
+        asc.insert(i);
+    }
+    for (int i = 0; i < 1000; ++i)
+    {
+        REQUIRE(asc.select(i) == i);
+        REQUIRE(asc.rank(i) == i);
+    }
+    REQUIRE(asc.count_range(100, 200) == 100);
+}
+
+TEMPLATE_TEST_CASE("Bounds and ranges", "[tree]", BinarySearchTree<int>, RedBlackTree<int>, AVLTree<int>, SplayTree<int>, BTree<int>, PersistentAVLTree<int>)
+{
+    using Tree = TestType;
+
+    Tree empty;
+    REQUIRE(empty.lower_bound(0) == empty.end());
+    REQUIRE(empty.upper_bound(0) == empty.end());
+    REQUIRE(empty.floor(0) == empty.end());
+    REQUIRE(empty.ceiling(0) == empty.end());
+    REQUIRE(empty.range(0, 10).empty());
+
+    // Even numbers in random order, probed with every number around them.
+    Tree tree;
+    std::set<int> expected;
+    unsigned seed = 7;
+    for (int i = 0; i < 500; ++i)
+    {
+        seed = seed * 1103515245 + 12345;
+        int x = int(seed >> 16) % 1000 * 2;
+        tree.insert(x);
+        expected.insert(x);
+    }
+
+    // Convert a reference iterator to the value it points to, or -1 for the end.
+    auto value = [&](auto it, auto end)
+    { return it == end ? -1 : *it; };
+
+    for (int x = -1; x <= 2000; ++x)
+    {
+        REQUIRE(value(tree.lower_bound(x), tree.end()) == value(expected.lower_bound(x), expected.end()));
+        REQUIRE(value(tree.upper_bound(x), tree.end()) == value(expected.upper_bound(x), expected.end()));
+        REQUIRE(value(tree.ceiling(x), tree.end()) == value(expected.lower_bound(x), expected.end()));
+
+        auto it = expected.upper_bound(x);
+        REQUIRE(value(tree.floor(x), tree.end()) == (it == expected.begin() ? -1 : *std::prev(it)));
+
+        auto [first, last] = tree.equal_range(x);
+        REQUIRE(std::distance(first, last) == int(expected.count(x)));
+    }
+
+    for (auto [lo, hi] : {std::pair{100, 300}, std::pair{-50, 50}, std::pair{1990, 5000}, std::pair{501, 503}, std::pair{300, 100}})
+    {
+        std::vector<int> actual;
+        for (int e : tree.range(lo, hi))
+        {
+            actual.push_back(e);
+        }
+        std::vector<int> wanted(expected.lower_bound(lo), lo < hi ? expected.lower_bound(hi) : expected.lower_bound(lo));
+        REQUIRE(actual == wanted);
+    }
+    REQUIRE(std::ranges::distance(tree.range(-10, 10000)) == tree.size());
+}
+
+TEMPLATE_TEST_CASE("Bulk build", "[tree]", InspectableRedBlackTree, InspectableAVLTree, InspectableBTree<int>, InspectablePersistentAVLTree)
+{
+    using Tree = TestType;
+
+    // Every size up to a few levels, then a few large ones.
+    std::vector<int> sizes(300);
+    std::iota(sizes.begin(), sizes.end(), 0);
+    sizes.insert(sizes.end(), {1000, 4159, 4161, 10000});
+    for (int n : sizes)
+    {
+        std::vector<int> sorted(n);
+        std::iota(sorted.begin(), sorted.end(), 0);
+
+        Tree tree(sorted.begin(), sorted.end());
+        REQUIRE(tree.verify_invariants() == true);
+        REQUIRE(tree.size() == n);
+        REQUIRE(std::equal(tree.begin(), tree.end(), sorted.begin(), sorted.end()));
+        if constexpr (!std::is_same_v<Tree, InspectableBTree<int>>)
+        {
+            REQUIRE(tree.depth() == int(std::bit_width(unsigned(n))));
+        }
+    }
+
+    // A built tree stays valid under updates.
+    std::vector<int> evens(1000);
+    std::generate(evens.begin(), evens.end(), [i = 0]() mutable { return 2 * i++; });
+    Tree tree;
+    tree.insert(-1);
+    tree.build_from_sorted(evens.begin(), evens.end());
+    REQUIRE(tree.contains(-1) == false);
+    for (int i = 0; i < 2000; ++i)
+    {
+        REQUIRE(tree.insert(2 * i + 1) == true);
+        REQUIRE(tree.remove(4 * i % 2000) == (i < 500));
+    }
+    REQUIRE(tree.verify_invariants() == true);
+    REQUIRE(tree.size() == 2500);
+
+    // Unsorted input with duplicates is sorted and deduplicated.
+    std::vector<int> shuffled = {5, 3, 9, 3, 1, 7, 5, 0, 9};
+    Tree unsorted(shuffled.begin(), shuffled.end());
+    REQUIRE(unsorted.verify_invariants() == true);
+    REQUIRE(unsorted == Tree({0, 1, 3, 5, 7, 9}));
+
+    // Single-pass input.
+    std::istringstream input("4 8 15 16 23 42");
+    Tree streamed{std::istream_iterator<int>(input), std::istream_iterator<int>()};
+    REQUIRE(streamed.verify_invariants() == true);
+    REQUIRE(streamed == Tree({4, 8, 15, 16, 23, 42}));
+}
+
+TEMPLATE_TEST_CASE("Set operations", "[tree]", InspectableRedBlackTree, InspectableAVLTree)
+{
+    using Tree = TestType;
+
+    // Random sets of the given size drawn from [0, range).
+    unsigned seed = 3;
+    auto random_set = [&](int size, int range)
+    {
+        std::set<int> set;
+        while (int(set.size()) < size)
+        {
+            seed = seed * 1103515245 + 12345;
+            set.insert(int(seed >> 8) % range);
+        }
+        return set;
+    };
+
+    // Sizes far apart make the joins walk down long spines, large sizes cross the parallel grain.
+    for (auto [m, n] : {std::pair{0, 0}, std::pair{0, 50}, std::pair{1, 1000}, std::pair{30, 5000}, std::pair{700, 900}, std::pair{20000, 30000}})
+    {
+        std::set<int> a = random_set(m, 3 * (m + n) + 1);
+        std::set<int> b = random_set(n, 3 * (m + n) + 1);
+        const Tree ta(a.begin(), a.end());
+        const Tree tb(b.begin(), b.end());
+
+        auto check = [](const Tree& tree, const std::vector<int>& expected)
+        {
+            REQUIRE(tree.verify_invariants() == true);
+            REQUIRE(tree.size() == int(expected.size()));
+            REQUIRE(std::equal(tree.begin(), tree.end(), expected.begin(), expected.end()));
+        };
+
+        for (bool swapped : {false, true})
+        {
+            const Tree& x = swapped ? tb : ta;
+            const Tree& y = swapped ? ta : tb;
+            const std::set<int>& sx = swapped ? b : a;
+            const std::set<int>& sy = swapped ? a : b;
+
+            std::vector<int> expected;
+            std::set_union(sx.begin(), sx.end(), sy.begin(), sy.end(), std::back_inserter(expected));
+            Tree tree = x;
+            tree.union_with(y);
+            check(tree, expected);
+
+            expected.clear();
+            std::set_intersection(sx.begin(), sx.end(), sy.begin(), sy.end(), std::back_inserter(expected));
+            tree = x;
+            tree.intersect_with(y);
+            check(tree, expected);
+
+            expected.clear();
+            std::set_difference(sx.begin(), sx.end(), sy.begin(), sy.end(), std::back_inserter(expected));
+            tree = x;
+            tree.difference_with(Tree(y));
+            check(tree, expected);
+
+            expected.clear();
+            std::copy_if(sx.begin(), sx.end(), std::back_inserter(expected), [](int e) { return e % 3 != 0; });
+            tree = x;
+            tree.filter([](int e) { return e % 3 != 0; });
+            check(tree, expected);
+        }
+    }
+
+    // The other tree is consumed when moved in, and the result supports the usual updates.
+    Tree odd = {1, 3, 5, 7};
+    Tree even = {0, 2, 4, 6};
+    odd.union_with(std::move(even));
+    REQUIRE(even.is_empty() == true);
+    REQUIRE(odd == Tree({0, 1, 2, 3, 4, 5, 6, 7}));
+    REQUIRE(odd.remove(3) == true);
+    REQUIRE(odd.insert(8) == true);
+    REQUIRE(odd.select(3) == 4);
+    REQUIRE(odd.verify_invariants() == true);
+}
+
 // Splay-specific verification not covered by the template test.
 TEST_CASE("SplayTree specific", "[tree]")
 {
@@ -468,4 +994,205 @@ TEST_CASE("SplayTree specific", "[tree]")
     REQUIRE(remove_root.root_value() == 10);
     REQUIRE(remove_root.verify_invariants() == true);
     REQUIRE(remove_root.size() == 2);
+
+    // A copy keeps the finger search setting, like the other binary search trees.
+    InspectableSplayTree finger = {1, 2, 3};
+    finger.set_finger_search(true);
+    InspectableSplayTree finger_copy = finger;
+    REQUIRE(finger_copy.uses_finger_search() == true);
+    REQUIRE(finger_copy.insert(4) == true);
+    REQUIRE(finger_copy.verify_invariants() == true);
+}
+
+TEST_CASE("BTree invariants", "[tree]")
+{
+    InspectableBTree<int> tree;
+    run_mixed_ops(tree, g_data, 16);
+
+    // Wide elements make small nodes, so the tree grows deep and every split, borrow and merge is exercised.
+    using Wide = std::array<int, 16>;
+    STATIC_REQUIRE(BTree<Wide>::NODE_CAPACITY == 4);
+    const int n = 1000;
+    InspectableBTree<Wide> wide;
+    for (int i = 0; i < n; ++i)
+    {
+        REQUIRE(wide.insert(Wide{i * 7919 % n}) == true);
+        REQUIRE(wide.verify_invariants() == true);
+    }
+    REQUIRE(wide.insert(Wide{0}) == false);
+    REQUIRE(wide.size() == n);
+    REQUIRE(wide.depth() >= 5);
+
+    // Both directions of iteration cross the leaves in order.
+    int expected = 0;
+    for (const auto& e : wide)
+    {
+        REQUIRE(e[0] == expected++);
+    }
+    auto it = wide.end();
+    for (expected = n - 1; expected >= 0; --expected)
+    {
+        REQUIRE((*--it)[0] == expected);
+    }
+    REQUIRE(it == wide.begin());
+    REQUIRE((*wide.find(Wide{500}))[0] == 500);
+
+    for (int i = 0; i < n; ++i)
+    {
+        REQUIRE(wide.remove(Wide{i * 4001 % n}) == true);
+        REQUIRE(wide.verify_invariants() == true);
+    }
+    REQUIRE(wide.is_empty() == true);
+    REQUIRE(wide.remove(Wide{0}) == false);
+
+    // Ascending bulk insertion into full-width nodes.
+    InspectableBTree<int> asc;
+    for (int i = 0; i < 10000; ++i)
+    {
+        asc.insert(i);
+    }
+    REQUIRE(asc.verify_invariants() == true);
+    REQUIRE(asc.depth() == 3);
+    REQUIRE(asc.min() == 0);
+    REQUIRE(asc.max() == 9999);
+    for (int i = 0; i < 10000; i += 2)
+    {
+        asc.remove(i);
+    }
+    REQUIRE(asc.verify_invariants() == true);
+    REQUIRE(asc.size() == 5000);
+    asc.clear();
+    REQUIRE(asc.verify_invariants() == true);
+
+    // Bulk build into full-width nodes, over several inner levels.
+    for (int size = 0; size <= 200; ++size)
+    {
+        std::vector<Wide> sorted(size);
+        for (int i = 0; i < size; ++i)
+        {
+            sorted[i][0] = i;
+        }
+        InspectableBTree<Wide> built(sorted.begin(), sorted.end());
+        REQUIRE(built.verify_invariants() == true);
+        REQUIRE(built.size() == size);
+    }
+}
+
+TEST_CASE("PersistentAVLTree snapshots", "[tree]")
+{
+    // A copy shares the root, and updates on either side copy only their own path.
+    InspectablePersistentAVLTree tree;
+    const int n = 5000;
+    InspectablePersistentAVLTree snapshots[4];
+    for (int i = 0; i < n; ++i)
+    {
+        tree.insert(i * 7919 % n);
+        if (i % 1250 == 1249)
+        {
+            snapshots[i / 1250] = tree;
+            REQUIRE(snapshots[i / 1250].shares_root_with(tree) == true);
+        }
+    }
+    for (int i = 0; i < n; i += 3)
+    {
+        REQUIRE(tree.remove(i) == true);
+        REQUIRE(tree.insert(n + i) == true);
+    }
+    REQUIRE(snapshots[3].remove(0) == true);
+    REQUIRE(tree.verify_invariants() == true);
+    REQUIRE(tree.size() == n);
+    REQUIRE(tree.contains(0) == false);
+    REQUIRE(tree.contains(n) == true);
+
+    for (int k = 0; k < 4; ++k)
+    {
+        REQUIRE(snapshots[k].verify_invariants() == true);
+        REQUIRE(snapshots[k].size() == (k + 1) * 1250 - (k == 3));
+        for (int i = 0; i < (k + 1) * 1250; ++i)
+        {
+            REQUIRE(snapshots[k].contains(i * 7919 % n) == (k != 3 || i != 0));
+        }
+        REQUIRE(snapshots[k].contains(n) == false);
+    }
+
+    // An element found for update is copied out of the snapshots first.
+    using Entry = detail::MapEntry<int, int>;
+    PersistentAVLTree<Entry> entries = {Entry{1, 10}, Entry{2, 20}, Entry{3, 30}};
+    PersistentAVLTree<Entry> before = entries;
+    const_cast<Entry&>(*entries.find_unshared(Entry{2})).value() = 200;
+    REQUIRE(entries.find_unshared(Entry{4}) == entries.end());
+    REQUIRE(entries.find_unshared(Entry{3})->value() == 30);
+    REQUIRE(entries.find(Entry{2})->value() == 200);
+    REQUIRE(before.find(Entry{2})->value() == 20);
+
+    // Likewise for all the elements at once. Each copy starts a new generation.
+    unsigned generation = entries.generation();
+    PersistentAVLTree<Entry> after = entries;
+    REQUIRE(entries.generation() == generation + 1);
+    entries.unshare();
+    for (const auto& entry : entries)
+    {
+        const_cast<Entry&>(entry).value() = -1;
+    }
+    REQUIRE(after.find(Entry{1})->value() == 10);
+    REQUIRE(after.find(Entry{3})->value() == 30);
+    REQUIRE(before.find(Entry{2})->value() == 20);
+
+    // Readers on other threads see their own consistent snapshots while the writer keeps going.
+    PersistentAVLTree<int> shared;
+    std::thread readers[4];
+    bool consistent[4] = {};
+    for (int r = 0; r < 4; ++r)
+    {
+        for (int j = 0; j < 2000; ++j)
+        {
+            shared.insert(r * 2000 + j);
+        }
+        readers[r] = std::thread([snapshot = shared, r, &result = consistent[r]]
+                                 {
+                                     int expected = 0;
+                                     for (int e : snapshot)
+                                     {
+                                         result = e == expected++;
+                                         if (!result)
+                                         {
+                                             break;
+                                         }
+                                     }
+                                     result = result && expected == (r + 1) * 2000 && snapshot.select(r * 1000) == r * 1000; });
+    }
+    for (int j = 0; j < 8000; j += 2)
+    {
+        shared.remove(j);
+    }
+    shared.clear();
+    for (int r = 0; r < 4; ++r)
+    {
+        readers[r].join();
+        REQUIRE(consistent[r] == true);
+    }
+
+    // Several threads copy the same const snapshot at once, and update their own copies.
+    std::vector<int> keys(1000);
+    std::iota(keys.begin(), keys.end(), 0);
+    const PersistentAVLTree<int> snapshot(keys.begin(), keys.end());
+    std::thread copiers[4];
+    bool updated[4] = {};
+    for (int c = 0; c < 4; ++c)
+    {
+        copiers[c] = std::thread([&snapshot, c, &result = updated[c]]
+                                 {
+                                     PersistentAVLTree<int> copy = snapshot;
+                                     copy.remove(c);
+                                     copy.insert(1000 + c);
+                                     result = copy.size() == 1000 && !copy.contains(c) && copy.contains(1000 + c); });
+    }
+    for (int c = 0; c < 4; ++c)
+    {
+        copiers[c].join();
+        REQUIRE(updated[c] == true);
+    }
+    REQUIRE(snapshot.size() == 1000);
+    REQUIRE(snapshot.contains(0) == true);
+    REQUIRE(snapshot.contains(1000) == false);
 }
@@ -1,5 +1,9 @@
+#include <filesystem>
+#include <fstream>
 #include <iterator>
+#include <numeric>
 #include <set>
+#include <thread>
 #include <type_traits>
 
 #include <catch2/catch_all.hpp>
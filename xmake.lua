@@ -5,6 +5,9 @@ set_encodings("utf-8")
 
 add_rules("mode.debug", "mode.release")
 add_requires("catch2")
+if is_plat("linux") then -- std::thread in tests and benchmarks
+    add_syslinks("pthread")
+end
 if is_plat("windows") then -- disable permissive mode for strict standard compliance
     add_cxflags("/permissive-")
 end
@@ -14,6 +17,11 @@ target("test")
     add_packages("catch2")
     add_files("tests/*.cpp")
 
+target("bench")
+    set_kind("binary")
+    add_packages("catch2")
+    add_files("benchmarks/*.cpp")
+
 target("example")
     set_kind("binary")
     add_files("examples/*.cpp")